@@ -16,11 +16,66 @@
 #include <QPixmap>
 #include <QDateTime>
 #include <QFontDatabase>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <vector>
 
 // Configuração da URL do ESP32-CAM
 const QString ESP_URL = "http://192.168.2.30"; 
 
+// Relógio monotônico do host (us): recepção, pintura e o offset do dispositivo
+static qint64 hostUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Offset relógio do dispositivo -> host pelo /status (estilo NTP): cada
+// resposta traz device_us; offset = device_us - meio do intervalo da
+// requisição, com erro de no máximo RTT/2. Fica a amostra de menor RTT das
+// últimas WINDOW (a deriva do cristal em ~5 s é desprezível).
+class ClockSync {
+public:
+    void addSample(qint64 sentUs, qint64 receivedUs, qint64 deviceUs) {
+        samples.push_back({receivedUs - sentUs, deviceUs - (sentUs + receivedUs) / 2});
+        if (samples.size() > WINDOW) samples.pop_front();
+        best = *std::min_element(samples.begin(), samples.end(),
+                                 [](const Sample &a, const Sample &b) { return a.rtt < b.rtt; });
+    }
+    bool valid() const { return !samples.empty(); }
+    qint64 toHost(qint64 deviceUs) const { return deviceUs - best.offset; }
+    qint64 errorUs() const { return best.rtt / 2; }
+
+private:
+    struct Sample { qint64 rtt, offset; };
+    static constexpr size_t WINDOW = 50; // 5 s a 10 Hz
+    std::deque<Sample> samples;
+    Sample best{0, 0};
+};
+
+// Percentis das últimas WINDOW medidas (ms)
+class LatencyStats {
+public:
+    void add(qint64 us) {
+        samples.push_back(us / 1000.0);
+        if (samples.size() > WINDOW) samples.pop_front();
+    }
+    QString summary() const {
+        if (samples.empty()) return "--";
+        std::vector<double> v(samples.begin(), samples.end());
+        std::sort(v.begin(), v.end());
+        auto pct = [&v](double p) { return v[std::min(v.size() - 1, (size_t)(p * v.size()))]; };
+        return QString("%1 / %2 / %3").arg(pct(0.50), 0, 'f', 0).arg(pct(0.95), 0, 'f', 0).arg(pct(0.99), 0, 'f', 0);
+    }
+
+private:
+    static constexpr size_t WINDOW = 300; // ~30 s a 10 Hz
+    std::deque<double> samples;
+};
+
 // Worker de Monitoramento em Segundo Plano
+// Instantes do dispositivo saem já no relógio do host (-1 = desconhecido:
+// firmware sem carimbos ou offset ainda não estimado)
 class MonitorWorker : public QObject {
     Q_OBJECT
 public:
@@ -33,12 +88,24 @@ public slots:
     }
     void fetchData() {
         QNetworkRequest reqStatus{QUrl(ESP_URL + "/status")};
+        const qint64 statusSentUs = hostUs();
         QNetworkReply* replyStatus = manager->get(reqStatus);
-        connect(replyStatus, &QNetworkReply::finished, [this, replyStatus]() {
+        connect(replyStatus, &QNetworkReply::finished, [this, replyStatus, statusSentUs]() {
             if (replyStatus->error() == QNetworkReply::NoError) {
+                const qint64 receivedUs = hostUs();
                 QByteArray data = replyStatus->readAll();
-                QJsonDocument doc = QJsonDocument::fromJson(data);
-                emit statusReceived(doc.object());
+                QJsonObject status = QJsonDocument::fromJson(data).object();
+                if (status.contains("device_us"))
+                    clock.addSample(statusSentUs, receivedUs, (qint64)status["device_us"].toDouble());
+                // Captura e fim da inferência do frame que gerou o score
+                qint64 scoreCaptureUs = -1, scoreInferUs = -1;
+                if (clock.valid() && status["score_frame_id"].toDouble() > 0) {
+                    const qint64 cap = (qint64)status["score_capture_us"].toDouble();
+                    scoreCaptureUs = clock.toHost(cap);
+                    scoreInferUs = (qint64)status["score_infer_us"].toDouble() - cap; // Só relógio do dispositivo
+                }
+                emit statusReceived(status, (quint32)status["score_frame_id"].toDouble(), scoreCaptureUs,
+                                    scoreInferUs, clock.valid() ? clock.errorUs() : -1);
             }
             replyStatus->deleteLater();
         });
@@ -48,19 +115,26 @@ public slots:
         QNetworkReply* replyImg = manager->get(reqImg);
         connect(replyImg, &QNetworkReply::finished, [this, replyImg]() {
             if (replyImg->error() == QNetworkReply::NoError) {
+                const qint64 receivedUs = hostUs();
                 QByteArray data = replyImg->readAll();
                 QPixmap pixmap;
                 pixmap.loadFromData(data);
-                if (!pixmap.isNull()) emit imageReceived(pixmap);
+                const QByteArray capture = replyImg->rawHeader("X-Capture-Us");
+                const qint64 captureUs = (clock.valid() && !capture.isEmpty()) ? clock.toHost(capture.toLongLong()) : -1;
+                if (!pixmap.isNull())
+                    emit imageReceived(pixmap, replyImg->rawHeader("X-Frame-Id").toUInt(), captureUs, receivedUs);
             }
             replyImg->deleteLater();
         });
     }
 signals:
-    void statusReceived(QJsonObject status);
-    void imageReceived(QPixmap image);
+    // scoreInferUs: captura -> fim da inferência, medido só no dispositivo
+    void statusReceived(QJsonObject status, quint32 scoreFrameId, qint64 scoreCaptureUs, qint64 scoreInferUs,
+                        qint64 clockErrorUs);
+    void imageReceived(QPixmap image, quint32 frameId, qint64 captureUs, qint64 receivedUs);
 private:
     QNetworkAccessManager* manager;
+    ClockSync clock; // Só usado na thread do worker
 };
 
 // Janela Principal da Aplicação
@@ -80,9 +154,19 @@ public:
 private slots:
     void updateClock() {
         lblTime->setText(QDateTime::currentDateTime().toString("HH:mm:ss  |  dd/MM/yyyy"));
+        lblLatency->setText(QString("captura→IA      %1\n"
+                                    "captura→rede    %2\n"
+                                    "captura→tela    %3\n"
+                                    "score na tela   %4\n"
+                                    "relógio         %5")
+                                .arg(latInfer.summary(), latReceive.summary(), latPaint.summary(),
+                                     latScoreAge.summary(),
+                                     clockErrorUs < 0 ? QString("sem sincronia")
+                                                      : QString("±%1 ms").arg(clockErrorUs / 1000.0, 0, 'f', 1)));
     }
 
-    void updateStatus(QJsonObject status) {
+    void updateStatus(QJsonObject status, quint32 scoreFrameId, qint64 scoreCaptureUs, qint64 scoreInferUs,
+                      qint64 clockError) {
         bool fire = status["fire"].toBool();
         double score = status["score"].toDouble(); // 0 a 100
 
@@ -119,10 +203,26 @@ private slots:
 
             lblDetails->setText(QString("NÍVEL DE AMEAÇA: %1%").arg(score, 0, 'f', 1));
         }
+
+        // Idade do score exibido: da captura do frame que o gerou até a pintura
+        clockErrorUs = clockError;
+        if (scoreCaptureUs >= 0) {
+            if (scoreFrameId != lastScoreFrameId) latInfer.add(scoreInferUs);
+            lastScoreFrameId = scoreFrameId;
+            lblDetails->repaint();
+            latScoreAge.add(hostUs() - scoreCaptureUs);
+        }
     }
 
-    void updateImage(QPixmap pixmap) {
+    // repaint() pinta já: o instante depois dele é o frame na janela (falta
+    // só a composição/vsync do monitor, que não dá para medir daqui)
+    void updateImage(QPixmap pixmap, quint32 frameId, qint64 captureUs, qint64 receivedUs) {
         lblVideo->setPixmap(pixmap);
+        if (captureUs < 0 || frameId == lastFrameId) return;
+        lastFrameId = frameId;
+        lblVideo->repaint();
+        latReceive.add(receivedUs - captureUs);
+        latPaint.add(hostUs() - captureUs);
     }
 
 private:
@@ -182,6 +282,15 @@ private:
         // Spacer para empurrar o resto para baixo
         sideLayout->addStretch();
 
+        // Latência ponta a ponta (p50 / p95 / p99 em ms)
+        QLabel *lblLatencyTitle = new QLabel("LATÊNCIA p50 / p95 / p99 (ms):");
+        lblLatencyTitle->setStyleSheet("font-size: 12px; color: #888;");
+        sideLayout->addWidget(lblLatencyTitle);
+
+        lblLatency = new QLabel("--");
+        lblLatency->setStyleSheet("font-size: 12px; color: #ccc; margin-bottom: 10px;");
+        sideLayout->addWidget(lblLatency);
+
         // 4. Rodapé da Sidebar (Relógio)
         lblTime = new QLabel("--:--:--");
         lblTime->setStyleSheet("font-size: 14px; color: #666; border-top: 1px solid #333; padding-top: 10px;");
@@ -233,6 +342,12 @@ private:
     QLabel *lblTime;
     QProgressBar *threatBar;
     QFrame *frameVideo;
+    QLabel *lblLatency;
+
+    // Latências (ver updateStatus/updateImage)
+    LatencyStats latInfer, latReceive, latPaint, latScoreAge;
+    quint32 lastFrameId = 0, lastScoreFrameId = 0;
+    qint64 clockErrorUs = -1;
 };
 
 #include "main.moc"
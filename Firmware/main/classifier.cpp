@@ -1,12 +1,15 @@
 #include "classifier.h"
+#include "preprocess.h"
 #include "fire_model.h"
+#include "heap_stats.h"
+#include "trace.h"
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "img_converters.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/schema/schema_generated.h"
-#include <math.h>
 
 static const char *TAG = "CLASS";
 
@@ -14,10 +17,6 @@ static const char *TAG = "CLASS";
 #define SRC_W 320
 #define SRC_H 240
 
-// Entradas da IA (
-#define DST_W 96
-#define DST_H 96
-
 // Tamanho da Arena Seguro
 const int kTensorArenaSize = 250 * 1024; 
 
@@ -29,23 +28,30 @@ static TfLiteTensor *input = nullptr;
 static TfLiteTensor *output = nullptr;
 static tflite::MicroMutableOpResolver<25> resolver;
 static uint8_t gamma_lut[256];
+static uint8_t *rgb_input = nullptr; // Só usado quando a entrada do modelo não é uint8
 
-// Look Up Table de Correção Gama, para um menor custo computacional
-static void build_gamma_table(float gamma) {
-    if (gamma <= 0.0f) gamma = 0.1f;
-    for (int i = 0; i < 256; i++) {
-        float norm = (float)i / 255.0f;
-        float res = powf(norm, gamma) * 255.0f;
-        if (res > 255.0f) res = 255.0f;
-        if (res < 0.0f) res = 0.0f;
-        gamma_lut[i] = (uint8_t)res;
-    }
-}
+// Estado preparado uma vez no init e reutilizado a cada inferência
+static uint8_t *input_rgb = nullptr; // Destino do pré-processamento (tensor ou rgb_input)
+static int fire_idx = 0;             // Índice da classe fogo na saída
+static score_quant_t out_quant = {1.0f / 255.0f, 0, 0, 255}; // Domínio do score quantizado
+static int32_t score_q_zero = 0;     // Score 0.0 (pré-filtro, falhas) nesse domínio
+
+// Pré-filtro (cascata antes do Invoke)
+static prefilter_config_t prefilter_cfg = {};
+static classifier_stats_t stats = {};
+static exclusion_mask_t excl_mask = {}; // Regiões excluídas (desativada por padrão)
+
+// Gate de mudança de cena (reaproveita o score em cenas estáticas)
+static scene_gate_config_t gate_cfg = {};
+static scene_gate_t gate = {};
+static int32_t gate_q = 0; // Score quantizado da última inferência (cache do gate)
 
 // Função de Inicialização do Classificador
 void classifier_init(float gamma) {
     ESP_LOGI(TAG, "Iniciando Classificador (Square Crop Mode)");
-    build_gamma_table(gamma);
+    preprocess_build_gamma_lut(gamma, gamma_lut);
+    prefilter_default_config(&prefilter_cfg);
+    scene_gate_default_config(&gate_cfg);
 
     // Aloca memória para o TensorFlow (SPIRAM preferencialmente)
     tensor_arena = (uint8_t *)heap_caps_malloc(kTensorArenaSize, MALLOC_CAP_SPIRAM);
@@ -94,101 +100,316 @@ void classifier_init(float gamma) {
 
     input = interpreter->input(0);
     output = interpreter->output(0);
+
+    if (input->type != kTfLiteUInt8) {
+        rgb_input = (uint8_t *)heap_caps_malloc(DST_W * DST_H * 3, MALLOC_CAP_SPIRAM);
+        if (!rgb_input) {
+            ESP_LOGE(TAG, "Falha ao alocar buffer de entrada");
+            input = nullptr;
+            return;
+        }
+    }
+    input_rgb = (input->type == kTfLiteUInt8) ? input->data.uint8 : rgb_input;
+    fire_idx = (output->dims->data[1] == 1) ? 0 : 1;
+
+    // Mesma escala que o score em float sempre usou: uint8 / 255, int8 pelos
+    // parâmetros do tensor e float em ponto fixo Q16
+    if (output->type == kTfLiteUInt8) {
+        out_quant = {1.0f / 255.0f, 0, 0, 255};
+    } else if (output->type == kTfLiteInt8) {
+        out_quant = {output->params.scale, output->params.zero_point, -128, 127};
+    } else {
+        out_quant = {1.0f / 65536.0f, 0, 0, 65536};
+    }
+    score_q_zero = score_quant_from_float(&out_quant, 0.0f);
+    gate_q = score_q_zero;
+    // Cada frame precisa de um bloco contíguo para o RGB888 decodificado
+    heap_stats_watch(MALLOC_CAP_SPIRAM, SRC_W * SRC_H * 3);
     ESP_LOGI(TAG, "Classificador Pronto");
 }
 
-// Função de Predição do Classificador
-float classifier_predict(uint8_t *jpg_buf, size_t jpg_len) {
-    // 1. Verificações de Segurança
-    if (!interpreter || !input || !jpg_buf) return 0.0f;
+void classifier_set_prefilter(const prefilter_config_t *cfg) {
+    prefilter_cfg = *cfg;
+    ESP_LOGI(TAG, "Pre-filtro %s", cfg->enabled ? "ativo" : "desativado");
+}
+
+void classifier_set_scene_gate(const scene_gate_config_t *cfg) {
+    gate_cfg = *cfg;
+    gate.valid = false;
+    ESP_LOGI(TAG, "Gate de cena %s", cfg->enabled ? "ativo" : "desativado");
+}
+
+void classifier_set_exclusion_mask(const exclusion_mask_t *m) {
+    if (m) excl_mask = *m;
+    else exclusion_mask_clear(&excl_mask);
+}
+
+void classifier_get_exclusion_mask(exclusion_mask_t *out) {
+    *out = excl_mask;
+}
+
+void classifier_get_stats(classifier_stats_t *out) {
+    *out = stats;
+}
 
-    // 2. Decode JPEG para RGB888 (Usa SPIRAM para o buffer temporário)
+void classifier_get_output_quant(score_quant_t *out) {
+    *out = out_quant;
+}
+
+// Decode JPEG para RGB888 (Usa SPIRAM para o buffer temporário)
+static uint8_t *decode_frame(uint8_t *jpg_buf, size_t jpg_len) {
     uint8_t *rgb = (uint8_t *)heap_caps_malloc(SRC_W * SRC_H * 3, MALLOC_CAP_SPIRAM);
-    if (!rgb || !fmt2rgb888(jpg_buf, jpg_len, PIXFORMAT_JPEG, rgb)) {
-        if (rgb) free(rgb);
+    if (!rgb) {
+        ESP_LOGE(TAG, "Falha no Decode JPEG");
+        heap_stats_alloc_failed(HEAP_STAGE_DECODE, MALLOC_CAP_SPIRAM, SRC_W * SRC_H * 3);
+        return nullptr;
+    }
+    TRACE_BEGIN(TRACE_DECODE);
+    bool ok = fmt2rgb888(jpg_buf, jpg_len, PIXFORMAT_JPEG, rgb);
+    TRACE_END(TRACE_DECODE);
+    if (!ok) {
         ESP_LOGE(TAG, "Falha no Decode JPEG");
-        return 0.0f;
+        free(rgb);
+        return nullptr;
     }
+    HEAP_STATS_SAMPLE(HEAP_STAGE_DECODE);
+    return rgb;
+}
 
-    // 3. Geometria de Recorte (Square Crop)
-    // Objetivo: Pegar um quadrado de 240x240 do centro da imagem de 320x240
-    int crop_size = SRC_H; // 240 pixels (altura total)
-    int start_x = (SRC_W - crop_size) / 2; // (320 - 240) / 2 = 40 pixels de margem à esquerda
-    
-    // Razão de redução (240 / 96 = 2.5)
-    float ratio = (float)crop_size / DST_W;
-
-    // 4. Preparação dos Ponteiros do Tensor
-    TfLiteType in_type = input->type;
-    uint8_t *in_u8 = input->data.uint8;
-    int8_t *in_i8 = (int8_t *)input->data.data;
-    float *in_f = input->data.f;
-    float scale = input->params.scale;
-    int32_t zero = input->params.zero_point;
-
-    // 5. Loop de Processamento (Resize + Crop + Gamma + Normalização)
-    for (int y = 0; y < DST_H; y++) {
-        // Mapeia Y destino -> Y fonte
-        int sy = (int)(y * ratio);
-        if (sy >= SRC_H) sy = SRC_H - 1;
-
-        // Otimização: ponteiro para o início da linha
-        uint8_t *src_row = rgb + (sy * SRC_W * 3);
-
-        for (int x = 0; x < DST_W; x++) {
-            // Mapeia X destino -> X fonte (com deslocamento start_x)
-            int sx = start_x + (int)(x * ratio);
-            
-            // Proteção de limites
-            if (sx < 0) sx = 0;
-            if (sx >= SRC_W) sx = SRC_W - 1;
-
-            int src_idx = sx * 3;
-            int dst_idx = (y * DST_W + x) * 3;
-
-            // Aplica Gamma (LUT)
-            uint8_t r = gamma_lut[src_row[src_idx + 0]];
-            uint8_t g = gamma_lut[src_row[src_idx + 1]];
-            uint8_t b = gamma_lut[src_row[src_idx + 2]];
-
-            // Preenche o Tensor de Entrada
-            if (in_type == kTfLiteUInt8) {
-                in_u8[dst_idx + 0] = r;
-                in_u8[dst_idx + 1] = g;
-                in_u8[dst_idx + 2] = b;
-            } else if (in_type == kTfLiteInt8) {
-                in_i8[dst_idx + 0] = (int8_t)((r / 255.0f) / scale + zero);
-                in_i8[dst_idx + 1] = (int8_t)((g / 255.0f) / scale + zero);
-                in_i8[dst_idx + 2] = (int8_t)((b / 255.0f) / scale + zero);
-            } else {
-                in_f[dst_idx + 0] = r / 255.0f;
-                in_f[dst_idx + 1] = g / 255.0f;
-                in_f[dst_idx + 2] = b / 255.0f;
-            }
+// Normaliza input_rgb para o tipo de entrada do modelo, executa e lê o score
+// cru da saída (sem desquantizar)
+static bool run_model(int32_t *q) {
+    TRACE_BEGIN(TRACE_PREPROCESS);
+    if (input->type == kTfLiteInt8) {
+        int8_t *in_i8 = input->data.int8;
+        float scale = input->params.scale;
+        int32_t zero = input->params.zero_point;
+        for (int i = 0; i < DST_W * DST_H * 3; i++) {
+            in_i8[i] = (int8_t)((input_rgb[i] / 255.0f) / scale + zero);
         }
+    } else if (input->type == kTfLiteFloat32) {
+        float *in_f = input->data.f;
+        for (int i = 0; i < DST_W * DST_H * 3; i++) {
+            in_f[i] = input_rgb[i] / 255.0f;
+        }
+    }
+    TRACE_END(TRACE_PREPROCESS);
+
+    int64_t t0 = esp_timer_get_time();
+    TRACE_BEGIN(TRACE_INVOKE);
+    TfLiteStatus status = interpreter->Invoke();
+    TRACE_END(TRACE_INVOKE);
+    HEAP_STATS_SAMPLE(HEAP_STAGE_INVOKE);
+    if (status != kTfLiteOk) {
+        ESP_LOGE(TAG, "Invoke falhou");
+        return false;
     }
+    uint32_t invoke_us = (uint32_t)(esp_timer_get_time() - t0);
+
+    // Média móvel (1/8) do custo do Invoke, usada para estimar a CPU economizada
+    stats.invokes++;
+    stats.invoke_us_avg = (stats.invokes == 1) ? invoke_us
+                        : stats.invoke_us_avg + ((int32_t)(invoke_us - stats.invoke_us_avg) >> 3);
+
+    if (output->type == kTfLiteUInt8) {
+        *q = output->data.uint8[fire_idx];
+    } else if (output->type == kTfLiteInt8) {
+        *q = output->data.int8[fire_idx];
+    } else if (output->type == kTfLiteFloat32) {
+        *q = score_quant_from_float(&out_quant, output->data.f[fire_idx]);
+    } else {
+        *q = score_q_zero;
+    }
+    return true;
+}
+
+// Pré-processa um recorte já decodificado e roda a CNN (com pré-filtro).
+// False se o recorte sai do frame ou o Invoke falha: *q fica sem score.
+static bool predict_crop(const uint8_t *rgb, int x, int y, int size, int32_t *q) {
+    *q = score_q_zero;
+    if (size <= 0 || x < 0 || y < 0 || x + size > SRC_W || y + size > SRC_H) {
+        ESP_LOGE(TAG, "Recorte invalido (%d,%d) %d", x, y, size);
+        return false;
+    }
+    stats.frames++;
+    // Recorte todo dentro da máscara de exclusão: nada a classificar
+    if (exclusion_mask_covers(&excl_mask, SRC_W, SRC_H, x, y, size)) {
+        stats.mask_skips++;
+        return true;
+    }
+
+    prefilter_stats_t pf_stats = {};
+    TRACE_BEGIN(TRACE_PREPROCESS);
+    preprocess_crop_masked(rgb, SRC_W, SRC_H, x, y, size, gamma_lut, input_rgb, &prefilter_cfg, &pf_stats,
+                           &excl_mask);
+    TRACE_END(TRACE_PREPROCESS);
+    HEAP_STATS_SAMPLE(HEAP_STAGE_PREPROCESS);
+
+    if (prefilter_is_benign(&prefilter_cfg, &pf_stats)) {
+        stats.prefilter_skips++;
+        return true;
+    }
+
+    return run_model(q);
+}
 
-    // 6. Libera memória temporária 
+// Frame inteiro já decodificado: recorte central + pré-filtro + gate + CNN.
+// *cached indica que o gate devolveu o score em cache (cena estática).
+static int32_t predict_full(const uint8_t *rgb, bool *cached) {
+    *cached = false;
+
+    // 3. Recorte + Resize + Gamma direto no tensor (ou no buffer intermediário),
+    //    com as regiões excluídas em preto
+    stats.frames++;
+    int crop = SRC_H < SRC_W ? SRC_H : SRC_W;
+    int crop_x = (SRC_W - crop) / 2, crop_y = (SRC_H - crop) / 2;
+    if (exclusion_mask_covers(&excl_mask, SRC_W, SRC_H, crop_x, crop_y, crop)) {
+        stats.mask_skips++;
+        return score_q_zero;
+    }
+    prefilter_stats_t pf_stats = {};
+    TRACE_BEGIN(TRACE_PREPROCESS);
+    preprocess_crop_masked(rgb, SRC_W, SRC_H, crop_x, crop_y, crop, gamma_lut, input_rgb, &prefilter_cfg,
+                           &pf_stats, &excl_mask);
+    TRACE_END(TRACE_PREPROCESS);
+    HEAP_STATS_SAMPLE(HEAP_STAGE_PREPROCESS);
+
+    // 4. Pré-filtro: frame claramente benigno não paga a CNN
+    if (prefilter_is_benign(&prefilter_cfg, &pf_stats)) {
+        stats.prefilter_skips++;
+        return score_q_zero;
+    }
+
+    // 5. Gate de cena: sem mudança desde a última inferência, devolve o score em cache
+    uint8_t thumb[SCENE_THUMB_N];
+    int64_t now_ms = esp_timer_get_time() / 1000;
+    if (gate_cfg.enabled) {
+        float cached_score;
+        scene_gate_thumbnail(input_rgb, thumb);
+        if (scene_gate_check(&gate, &gate_cfg, thumb, now_ms, &cached_score)) {
+            stats.gate_hits++;
+            stats.cpu_saved_us += stats.invoke_us_avg;
+            *cached = true;
+            return gate_q;
+        }
+    }
+
+    // 6. Executa a Inferência e devolve a saída crua
+    int32_t q = score_q_zero;
+    if (!run_model(&q)) return score_q_zero;
+
+    if (gate_cfg.enabled) {
+        gate_q = q;
+        scene_gate_update(&gate, thumb, score_quant_to_float(&out_quant, q), now_ms);
+    }
+
+    return q;
+}
+
+// Função de Predição do Classificador
+int32_t classifier_predict_q(uint8_t *jpg_buf, size_t jpg_len) {
+    // 1. Verificações de Segurança
+    if (!interpreter || !input || !jpg_buf) return score_q_zero;
+
+    // 2. Decode JPEG para RGB888
+    uint8_t *rgb = decode_frame(jpg_buf, jpg_len);
+    if (!rgb) return score_q_zero;
+
+    bool cached;
+    int32_t q = predict_full(rgb, &cached);
     free(rgb);
+    return q;
+}
 
-    // 7. Executa a Inferência
-    if (interpreter->Invoke() != kTfLiteOk) {
-        ESP_LOGE(TAG, "Invoke falhou");
-        return 0.0f;
+bool classifier_predict_pyramid_q(uint8_t *jpg_buf, size_t jpg_len, const classifier_crop_t *zoom,
+                                  int32_t *full_q, int32_t *zoom_q) {
+    *full_q = score_q_zero;
+    if (!interpreter || !input || !jpg_buf) return false;
+
+    uint8_t *rgb = decode_frame(jpg_buf, jpg_len);
+    if (!rgb) return false;
+
+    // Cena estática: o score do recorte guardado na pirâmide continua válido
+    bool cached;
+    *full_q = predict_full(rgb, &cached);
+    bool zoom_ran = zoom && !cached && predict_crop(rgb, zoom->x, zoom->y, zoom->size, zoom_q);
+    free(rgb);
+    return zoom_ran;
+}
+
+float classifier_predict(uint8_t *jpg_buf, size_t jpg_len) {
+    return score_quant_to_float(&out_quant, classifier_predict_q(jpg_buf, jpg_len));
+}
+
+// N frames independentes (ex.: várias câmeras): um único buffer de decode
+// reaproveitado e o estado do interpretador preparado no init.
+// O gate de cena não se aplica, pois os frames não formam uma sequência.
+// Cada saída é opcional: scores em float e/ou crus.
+static int predict_batch(uint8_t *const *jpg_bufs, const size_t *jpg_lens, size_t n, float *scores,
+                         int32_t *scores_q) {
+    if (!interpreter || !input || !jpg_bufs || (!scores && !scores_q)) return 0;
+
+    uint8_t *rgb = (uint8_t *)heap_caps_malloc(SRC_W * SRC_H * 3, MALLOC_CAP_SPIRAM);
+    if (!rgb) {
+        ESP_LOGE(TAG, "Falha no Decode JPEG");
+        heap_stats_alloc_failed(HEAP_STAGE_DECODE, MALLOC_CAP_SPIRAM, SRC_W * SRC_H * 3);
+        return 0;
     }
 
-    // 8. Processa a Saída
-    float prob = 0.0f;
+    int ok = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t q = score_q_zero;
+        TRACE_BEGIN(TRACE_DECODE);
+        bool decoded = jpg_bufs[i] && fmt2rgb888(jpg_bufs[i], jpg_lens[i], PIXFORMAT_JPEG, rgb);
+        TRACE_END(TRACE_DECODE);
+        if (!decoded) {
+            ESP_LOGE(TAG, "Falha no Decode JPEG (%u)", (unsigned)i);
+        } else {
+            int crop = SRC_H < SRC_W ? SRC_H : SRC_W;
+            if (predict_crop(rgb, (SRC_W - crop) / 2, (SRC_H - crop) / 2, crop, &q)) ok++;
+        }
+        if (scores_q) scores_q[i] = q;
+        if (scores) scores[i] = score_quant_to_float(&out_quant, q);
+    }
+    free(rgb);
+    return ok;
+}
+
+int classifier_predict_batch(uint8_t *const *jpg_bufs, const size_t *jpg_lens, size_t n,
+                             float *scores) {
+    return predict_batch(jpg_bufs, jpg_lens, n, scores, nullptr);
+}
+
+int classifier_predict_batch_q(uint8_t *const *jpg_bufs, const size_t *jpg_lens, size_t n,
+                               int32_t *scores_q) {
+    return predict_batch(jpg_bufs, jpg_lens, n, nullptr, scores_q);
+}
 
-    int fire_idx = (output->dims->data[1] == 1) ? 0 : 1; 
+// N recortes de um mesmo frame: decodifica uma vez só
+static int predict_crops(uint8_t *jpg_buf, size_t jpg_len, const classifier_crop_t *crops, size_t n,
+                         float *scores, int32_t *scores_q) {
+    if (!interpreter || !input || !jpg_buf || !crops || (!scores && !scores_q)) return 0;
 
-    if (output->type == kTfLiteFloat32) {
-        prob = output->data.f[fire_idx];
-    } else if (output->type == kTfLiteUInt8) {
-        prob = output->data.uint8[fire_idx] / 255.0f;
-    } else if (output->type == kTfLiteInt8) {
-        prob = ((int)output->data.int8[fire_idx] - output->params.zero_point) * output->params.scale;
+    uint8_t *rgb = decode_frame(jpg_buf, jpg_len);
+    if (!rgb) return 0;
+
+    int ok = 0;
+    for (size_t i = 0; i < n; i++) {
+        int32_t q;
+        if (predict_crop(rgb, crops[i].x, crops[i].y, crops[i].size, &q)) ok++;
+        if (scores_q) scores_q[i] = q;
+        if (scores) scores[i] = score_quant_to_float(&out_quant, q);
     }
+    free(rgb);
+    return ok;
+}
 
-    return prob;
-}
\ No newline at end of file
+int classifier_predict_crops(uint8_t *jpg_buf, size_t jpg_len, const classifier_crop_t *crops,
+                             size_t n, float *scores) {
+    return predict_crops(jpg_buf, jpg_len, crops, n, scores, nullptr);
+}
+
+int classifier_predict_crops_q(uint8_t *jpg_buf, size_t jpg_len, const classifier_crop_t *crops,
+                               size_t n, int32_t *scores_q) {
+    return predict_crops(jpg_buf, jpg_len, crops, n, nullptr, scores_q);
+}
@@ -1,6 +1,11 @@
 #pragma once
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include "prefilter.h"
+#include "scene_gate.h"
+#include "score_quant.h"
+#include "exclusion_mask.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,6 +16,65 @@ void classifier_init(float gamma);
 
 float classifier_predict(uint8_t* img_buffer, size_t img_len);
 
+// Score cru da saída do modelo (sem desquantizar). Para decidir, compare com
+// um limiar convertido uma vez: q > score_quant_threshold(&quant, 0.60f).
+int32_t classifier_predict_q(uint8_t* img_buffer, size_t img_len);
+
+// Domínio dos scores crus (válido depois do classifier_init)
+void classifier_get_output_quant(score_quant_t* out);
+
+// Lote de N frames JPEG -> N scores. Retorna quantos foram classificados; um
+// frame que não decodifica ou cujo Invoke falha fica com o score zero
+int classifier_predict_batch(uint8_t* const* img_buffers, const size_t* img_lens, size_t n,
+                             float* scores);
+int classifier_predict_batch_q(uint8_t* const* img_buffers, const size_t* img_lens, size_t n,
+                               int32_t* scores_q);
+
+// Região quadrada do frame fonte (320x240) enviada ao modelo
+typedef struct {
+    int16_t x;
+    int16_t y;
+    uint16_t size;
+} classifier_crop_t;
+
+// N recortes de um mesmo frame JPEG (decodificado uma vez) -> N scores.
+// Retorna quantos foram classificados; recortes fora do frame ou com Invoke
+// falho ficam com o score zero
+int classifier_predict_crops(uint8_t* img_buffer, size_t img_len, const classifier_crop_t* crops,
+                             size_t n, float* scores);
+int classifier_predict_crops_q(uint8_t* img_buffer, size_t img_len, const classifier_crop_t* crops,
+                               size_t n, int32_t* scores_q);
+
+// Pirâmide de escalas (pyramid.h): frame inteiro como no classifier_predict_q
+// + um recorte com zoom do mesmo frame, decodificado uma vez. Com a cena
+// estática (gate) o recorte não roda. Retorna true se *zoom_q foi preenchido.
+bool classifier_predict_pyramid_q(uint8_t* img_buffer, size_t img_len, const classifier_crop_t* zoom,
+                                  int32_t* full_q, int32_t* zoom_q);
+
+// Pré-filtro opcional (desativado por padrão)
+void classifier_set_prefilter(const prefilter_config_t* cfg);
+
+// Gate de mudança de cena opcional (desativado por padrão)
+void classifier_set_scene_gate(const scene_gate_config_t* cfg);
+
+// Máscara de exclusão (copiada; NULL desativa). Pixels mascarados chegam
+// pretos à CNN e recortes inteiramente mascarados não pagam Invoke.
+void classifier_set_exclusion_mask(const exclusion_mask_t* mask);
+void classifier_get_exclusion_mask(exclusion_mask_t* out);
+
+// Contadores do classificador
+typedef struct {
+    uint32_t frames;          // Frames pré-processados
+    uint32_t prefilter_skips; // Frames descartados pelo pré-filtro (sem Invoke)
+    uint32_t gate_hits;       // Frames com cena estática (score em cache)
+    uint32_t mask_skips;      // Recortes inteiramente mascarados (sem Invoke)
+    uint32_t invokes;         // Inferências executadas
+    uint32_t invoke_us_avg;   // Custo médio do Invoke (média móvel)
+    uint64_t cpu_saved_us;    // Estimativa de CPU economizada pelo gate
+} classifier_stats_t;
+
+void classifier_get_stats(classifier_stats_t* out);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "exclusion_mask.h"
+#include <string.h>
+
+void exclusion_mask_clear(exclusion_mask_t *m) {
+    m->enabled = false;
+    memset(m->bits, 0, sizeof(m->bits));
+}
+
+bool exclusion_mask_load(exclusion_mask_t *m, const uint8_t *data, uint32_t len) {
+    if (!data || len != MASK_BYTES) return false;
+    memcpy(m->bits, data, MASK_BYTES);
+    m->enabled = exclusion_mask_count(m) > 0;
+    return true;
+}
+
+void exclusion_mask_add_rect(exclusion_mask_t *m, int src_w, int src_h, int x, int y, int w, int h) {
+    if (src_w <= 0 || src_h <= 0 || w <= 0 || h <= 0) return;
+    int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int x1 = x + w > src_w ? src_w - 1 : x + w - 1;
+    int y1 = y + h > src_h ? src_h - 1 : y + h - 1;
+    if (x1 < x0 || y1 < y0) return; // Fora do frame
+    for (int r = exclusion_mask_row(y0, src_h); r <= exclusion_mask_row(y1, src_h); r++) {
+        for (int c = exclusion_mask_col(x0, src_w); c <= exclusion_mask_col(x1, src_w); c++) {
+            int i = r * MASK_COLS + c;
+            m->bits[i >> 3] |= (uint8_t)(1u << (i & 7));
+        }
+    }
+    m->enabled = true;
+}
+
+bool exclusion_mask_covers(const exclusion_mask_t *m, int src_w, int src_h, int x, int y, int size) {
+    if (!m || !m->enabled || size <= 0) return false;
+    // Mesmo recorte (com proteção de limites) que o preprocess_crop amostra
+    int x0 = x < 0 ? 0 : x, y0 = y < 0 ? 0 : y;
+    int x1 = x + size > src_w ? src_w - 1 : x + size - 1;
+    int y1 = y + size > src_h ? src_h - 1 : y + size - 1;
+    if (x1 < x0 || y1 < y0) return false;
+    for (int r = exclusion_mask_row(y0, src_h); r <= exclusion_mask_row(y1, src_h); r++) {
+        for (int c = exclusion_mask_col(x0, src_w); c <= exclusion_mask_col(x1, src_w); c++) {
+            if (!exclusion_mask_cell(m, c, r)) return false;
+        }
+    }
+    return true;
+}
+
+int exclusion_mask_count(const exclusion_mask_t *m) {
+    int n = 0;
+    for (int i = 0; i < MASK_BYTES; i++) n += __builtin_popcount(m->bits[i]);
+    return n;
+}
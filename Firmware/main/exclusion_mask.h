@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Máscara de exclusão por câmera: regiões com fontes de luz permanentes
+// (lâmpadas, monitores, janelas ao pôr do sol) que nunca devem chegar à CNN.
+// Grade de MASK_COLS x MASK_ROWS células sobre o frame fonte, independente da
+// resolução (10x10 pixels em 320x240). Bit i = célula (i % MASK_COLS,
+// i / MASK_COLS), bit (i & 7) do byte i >> 3; é o formato do POST /mask e
+// do blob salvo na NVS.
+#define MASK_COLS 32
+#define MASK_ROWS 24
+#define MASK_BYTES (MASK_COLS * MASK_ROWS / 8)
+
+typedef struct {
+    bool enabled;
+    uint8_t bits[MASK_BYTES];
+} exclusion_mask_t;
+
+void exclusion_mask_clear(exclusion_mask_t *m);
+
+// Máscara a partir do blob (MASK_BYTES); ativa se algum bit estiver ligado
+bool exclusion_mask_load(exclusion_mask_t *m, const uint8_t *data, uint32_t len);
+
+// Marca as células que tocam o retângulo (pixels do frame fonte)
+void exclusion_mask_add_rect(exclusion_mask_t *m, int src_w, int src_h, int x, int y, int w, int h);
+
+static inline bool exclusion_mask_cell(const exclusion_mask_t *m, int col, int row) {
+    int i = row * MASK_COLS + col;
+    return (m->bits[i >> 3] >> (i & 7)) & 1;
+}
+
+// Linha da grade para um y do frame fonte (e coluna para um x); usadas por
+// pixel dentro do loop de resize, por isso inline
+static inline int exclusion_mask_row(int y, int src_h) { return y * MASK_ROWS / src_h; }
+static inline int exclusion_mask_col(int x, int src_w) { return x * MASK_COLS / src_w; }
+
+// true se todo o recorte quadrado (x, y, size) cai em células mascaradas:
+// o recorte não precisa de Invoke
+bool exclusion_mask_covers(const exclusion_mask_t *m, int src_w, int src_h, int x, int y, int size);
+
+// Células mascaradas (para o /status e relatórios)
+int exclusion_mask_count(const exclusion_mask_t *m);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,92 @@
+#include "fusion.h"
+
+void fusion_default_config(fusion_config_t *cfg) {
+    cfg->ema_alpha = 1.0f;
+    cfg->vote_k = 1;
+    cfg->vote_n = 1;
+    cfg->on_threshold = 0.60f;
+    cfg->off_threshold = 0.60f;
+}
+
+void fusion_reset(fusion_t *f) {
+    f->ema = 0.0f;
+    f->votes = 0;
+    f->count = 0;
+    f->fire = false;
+    f->ema_q8 = 0;
+}
+
+static uint8_t clamp_vote_n(uint8_t n) {
+    if (n < 1) n = 1;
+    if (n > FUSION_MAX_N) n = FUSION_MAX_N;
+    return n;
+}
+
+// Empurra o voto do frame na janela de n bits e devolve o total de votos
+static int push_vote(fusion_t *f, uint8_t n, bool vote) {
+    uint16_t mask = (n == 16) ? 0xFFFF : (uint16_t)((1u << n) - 1);
+    f->votes = (uint16_t)(((f->votes << 1) | (vote ? 1 : 0)) & mask);
+    return __builtin_popcount(f->votes);
+}
+
+// Score de uma EMA em q * 256 (a mesma aritmética de score_quant_to_float)
+static float score_q8(const score_quant_t *sq, int32_t q8) {
+    return ((float)q8 / 256.0f - (float)sq->zero_point) * sq->scale;
+}
+
+// Maior EMA (q * 256) com score(ema) <= t: score é monotônico, busca binária
+static int32_t q8_threshold(const score_quant_t *sq, float t) {
+    int32_t lo = sq->q_min * 256 - 1, hi = sq->q_max * 256;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo + 1) / 2;
+        if (score_q8(sq, mid) <= t) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+// x / 256 arredondado para o mais próximo (meios para longe do zero)
+static int32_t round_shift8(int64_t x) {
+    return (int32_t)(x >= 0 ? (x + 128) >> 8 : -((-x + 128) >> 8));
+}
+
+void fusion_quantize_config(const fusion_config_t *cfg, const score_quant_t *sq, fusion_qconfig_t *out) {
+    out->on_q = score_quant_threshold(sq, cfg->on_threshold);
+    out->on_q8 = q8_threshold(sq, cfg->on_threshold);
+    out->off_q8 = q8_threshold(sq, cfg->off_threshold);
+    out->alpha_q8 = (int32_t)(cfg->ema_alpha * 256.0f + 0.5f);
+    out->vote_k = cfg->vote_k;
+    out->vote_n = cfg->vote_n;
+}
+
+int32_t fusion_update_q(fusion_t *f, const fusion_qconfig_t *cfg, int32_t raw_q) {
+    uint8_t n = clamp_vote_n(cfg->vote_n);
+
+    // EMA (a primeira amostra inicializa a média)
+    const int32_t raw_q8 = raw_q * 256;
+    f->ema_q8 = (f->count == 0) ? raw_q8
+                                : f->ema_q8 + round_shift8((int64_t)cfg->alpha_q8 * (raw_q8 - f->ema_q8));
+    if (f->count < n) f->count++;
+
+    // Voto do frame bruto, janela deslizante de n bits
+    int votes = push_vote(f, n, raw_q > cfg->on_q);
+
+    // Histerese: liga com votos suficientes e EMA acima do limiar,
+    // só desliga quando a EMA volta ao limiar inferior
+    if (!f->fire) {
+        if (votes >= cfg->vote_k && f->ema_q8 > cfg->on_q8) f->fire = true;
+    } else if (f->ema_q8 <= cfg->off_q8) {
+        f->fire = false;
+    }
+    return f->ema_q8;
+}
+
+// Saída uint8 dos modelos do repositório
+static const score_quant_t FLOAT_DOMAIN = {1.0f / 255.0f, 0, 0, 255};
+
+float fusion_update(fusion_t *f, const fusion_config_t *cfg, float raw) {
+    fusion_qconfig_t q;
+    fusion_quantize_config(cfg, &FLOAT_DOMAIN, &q);
+    f->ema = score_q8(&FLOAT_DOMAIN, fusion_update_q(f, &q, score_quant_from_float(&FLOAT_DOMAIN, raw)));
+    return f->ema;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "score_quant.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fusão temporal dos scores: EMA + votação k-de-n + histerese.
+// A configuração padrão equivale à decisão de um único frame (score > 0.60).
+#define FUSION_MAX_N 16
+
+typedef struct {
+    float ema_alpha;      // Peso do score novo (1.0 = sem suavização)
+    uint8_t vote_k;       // Votos necessários ...
+    uint8_t vote_n;       // ... nas últimas n inferências (n <= FUSION_MAX_N)
+    float on_threshold;   // Score fundido para ligar o alarme
+    float off_threshold;  // Score fundido para desligar (histerese, <= on_threshold)
+} fusion_config_t;
+
+typedef struct {
+    float ema;
+    uint16_t votes;       // Histórico de votos (bit 0 = mais recente)
+    uint8_t count;        // Inferências vistas (satura em vote_n)
+    bool fire;
+    int32_t ema_q8;       // EMA de fusion_update_q (q * 256)
+} fusion_t;
+
+void fusion_default_config(fusion_config_t *cfg);
+void fusion_reset(fusion_t *f);
+
+// A fusão roda sobre o score quantizado da saída do modelo, com os limiares
+// convertidos uma vez (fusion_quantize_config). A EMA fica em q com 8 bits
+// fracionários: ema_alpha é arredondado para múltiplo de 1/256 e cada passo
+// da EMA para o mais próximo. As comparações da EMA com os limiares são
+// exatas nessa grade (score(ema) > on liga, score(ema) <= off desliga; com
+// on = off é a decisão de um único frame).
+typedef struct {
+    int32_t on_q;     // score_quant_threshold(on_threshold): voto do frame
+    int32_t on_q8;    // Maior EMA (q * 256) com score <= on_threshold
+    int32_t off_q8;   // Maior EMA (q * 256) com score <= off_threshold
+    int32_t alpha_q8; // ema_alpha * 256
+    uint8_t vote_k;
+    uint8_t vote_n;
+} fusion_qconfig_t;
+
+void fusion_quantize_config(const fusion_config_t *cfg, const score_quant_t *sq, fusion_qconfig_t *out);
+
+// Devolve a EMA em q * 256; f->fire tem a decisão
+int32_t fusion_update_q(fusion_t *f, const fusion_qconfig_t *cfg, int32_t raw_q);
+
+// Referência em float (ferramentas do host): arredonda o score para a saída uint8
+// dos modelos do repositório (escala 1/255) e aplica fusion_update_q, então dá
+// as mesmas decisões do firmware. Devolve o score fundido; f->fire tem a decisão.
+float fusion_update(fusion_t *f, const fusion_config_t *cfg, float raw);
+
+#ifdef __cplusplus
+}
+#endif
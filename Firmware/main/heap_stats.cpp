@@ -0,0 +1,118 @@
+#include "heap_stats.h"
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "HEAP";
+
+volatile bool heap_stats_on = false;
+
+// Escritas só pela tarefa do pipeline (handler do /capture); o /heap roda
+// na mesma tarefa do httpd, então lê estatísticas inteiras
+static heap_stage_stats_t stages[HEAP_STAGE_COUNT];
+static heap_events_t events;
+static uint32_t watch_block[HEAP_REGION_COUNT];
+static bool under_pressure[HEAP_STAGE_COUNT][HEAP_REGION_COUNT]; // Por estágio: alguns seguram o buffer do frame
+
+static const uint32_t REGION_CAPS[HEAP_REGION_COUNT] = {MALLOC_CAP_INTERNAL, MALLOC_CAP_SPIRAM};
+
+static heap_region_t region_of(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? HEAP_REGION_SPIRAM : HEAP_REGION_INTERNAL;
+}
+
+static uint8_t frag_pct(uint32_t free_bytes, uint32_t largest) {
+    return free_bytes ? (uint8_t)(100 - (uint64_t)largest * 100 / free_bytes) : 0;
+}
+
+void heap_stats_set_enabled(bool enabled) {
+    heap_stats_on = enabled;
+}
+
+void heap_stats_watch(uint32_t caps, size_t min_block) {
+    watch_block[region_of(caps)] = (uint32_t)min_block;
+}
+
+void heap_stats_reset(void) {
+    memset(stages, 0, sizeof(stages));
+    memset(&events, 0, sizeof(events));
+    memset(under_pressure, 0, sizeof(under_pressure));
+}
+
+void heap_stats_sample(heap_stage_t stage) {
+    if (stage >= HEAP_STAGE_COUNT) return;
+    heap_stage_stats_t *st = &stages[stage];
+    const bool first = st->samples == 0;
+    st->samples++;
+    for (int r = 0; r < HEAP_REGION_COUNT; r++) {
+        const uint32_t free_bytes = (uint32_t)heap_caps_get_free_size(REGION_CAPS[r]);
+        const uint32_t largest = (uint32_t)heap_caps_get_largest_free_block(REGION_CAPS[r]);
+        const uint8_t frag = frag_pct(free_bytes, largest);
+        heap_region_stats_t *s = &st->region[r];
+        if (first) {
+            s->free_min = s->free_avg = free_bytes;
+            s->largest_min = largest;
+        }
+        s->free_last = free_bytes;
+        if (free_bytes < s->free_min) s->free_min = free_bytes;
+        s->free_avg += ((int32_t)(free_bytes - s->free_avg)) >> 4;
+        s->largest_last = largest;
+        if (largest < s->largest_min) s->largest_min = largest;
+        s->frag_last = frag;
+        if (frag > s->frag_max) s->frag_max = frag;
+
+        // Um aviso por entrada em pressão (não um por frame)
+        const bool pressure = watch_block[r] && largest < watch_block[r];
+        if (pressure && !under_pressure[stage][r]) {
+            events.pressure_events++;
+            ESP_LOGW(TAG, "Pressao em %s (%s): maior bloco %lu < %lu, livre %lu, fragmentacao %u%%",
+                     heap_region_name((heap_region_t)r), heap_stage_name(stage), (unsigned long)largest,
+                     (unsigned long)watch_block[r], (unsigned long)free_bytes, frag);
+        }
+        under_pressure[stage][r] = pressure;
+    }
+}
+
+void heap_stats_alloc_failed(heap_stage_t stage, uint32_t caps, size_t size) {
+    const heap_region_t r = region_of(caps);
+    events.alloc_failures++;
+    events.last_failure_ms = esp_timer_get_time() / 1000;
+    events.last_failure_stage = stage;
+    events.last_failure_region = r;
+    events.last_failure_size = (uint32_t)size;
+    events.last_failure_free = (uint32_t)heap_caps_get_free_size(REGION_CAPS[r]);
+    events.last_failure_largest = (uint32_t)heap_caps_get_largest_free_block(REGION_CAPS[r]);
+    ESP_LOGE(TAG, "Alocacao de %u bytes em %s falhou (%s): livre %lu, maior bloco %lu", (unsigned)size,
+             heap_region_name(r), heap_stage_name(stage), (unsigned long)events.last_failure_free,
+             (unsigned long)events.last_failure_largest);
+}
+
+void heap_stats_get(heap_stage_t stage, heap_stage_stats_t *out) {
+    *out = stages[stage];
+}
+
+void heap_stats_get_events(heap_events_t *out) {
+    *out = events;
+}
+
+void heap_stats_now(heap_region_t region, heap_region_now_t *out) {
+    const uint32_t caps = REGION_CAPS[region];
+    out->total = (uint32_t)heap_caps_get_total_size(caps);
+    out->free = (uint32_t)heap_caps_get_free_size(caps);
+    out->largest = (uint32_t)heap_caps_get_largest_free_block(caps);
+    out->min_free_ever = (uint32_t)heap_caps_get_minimum_free_size(caps);
+    out->frag = frag_pct(out->free, out->largest);
+}
+
+uint32_t heap_stats_watch_block(heap_region_t region) {
+    return watch_block[region];
+}
+
+const char *heap_stage_name(heap_stage_t stage) {
+    static const char *const names[HEAP_STAGE_COUNT] = {"frame_grab", "decode", "preprocess", "invoke", "send"};
+    return stage < HEAP_STAGE_COUNT ? names[stage] : "?";
+}
+
+const char *heap_region_name(heap_region_t region) {
+    return region == HEAP_REGION_SPIRAM ? "spiram" : "internal";
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Memória ao longo do pipeline: em cada estágio, um retrato do heap_caps
+// (livre, maior bloco livre) da RAM interna e da PSRAM, acumulado em
+// estatísticas por estágio (mínimo, média móvel, fragmentação). Avisa quando
+// o maior bloco fica abaixo do que o próximo frame precisa, antes da
+// alocação falhar.
+typedef enum {
+    HEAP_STAGE_FRAME_GRAB = 0, // Com o fb da câmera em mãos
+    HEAP_STAGE_DECODE,         // Com o buffer RGB888 alocado
+    HEAP_STAGE_PREPROCESS,
+    HEAP_STAGE_INVOKE,
+    HEAP_STAGE_SEND,
+    HEAP_STAGE_COUNT
+} heap_stage_t;
+
+typedef enum { HEAP_REGION_INTERNAL = 0, HEAP_REGION_SPIRAM, HEAP_REGION_COUNT } heap_region_t;
+
+typedef struct {
+    uint32_t free_last, free_min, free_avg;  // Bytes livres (média móvel de 1/16)
+    uint32_t largest_last, largest_min;      // Maior bloco livre
+    uint8_t frag_last, frag_max;             // 100 * (1 - maior bloco / livre)
+} heap_region_stats_t;
+
+typedef struct {
+    uint32_t samples;
+    heap_region_stats_t region[HEAP_REGION_COUNT];
+} heap_stage_stats_t;
+
+// Retrato atual de uma região (fora do pipeline, para o /heap)
+typedef struct {
+    uint32_t total, free, largest, min_free_ever;
+    uint8_t frag;
+} heap_region_now_t;
+
+typedef struct {
+    uint32_t alloc_failures, pressure_events;
+    // Última falha de alocação: estágio, região e o heap naquele instante
+    int64_t last_failure_ms;
+    heap_stage_t last_failure_stage;
+    heap_region_t last_failure_region;
+    uint32_t last_failure_size, last_failure_free, last_failure_largest;
+} heap_events_t;
+
+extern volatile bool heap_stats_on;
+
+void heap_stats_set_enabled(bool enabled);
+// Pressão: maior bloco livre da região (MALLOC_CAP_*) abaixo de min_block
+void heap_stats_watch(uint32_t caps, size_t min_block);
+void heap_stats_sample(heap_stage_t stage);
+// Alocação que falhou no estágio (registrada mesmo com as estatísticas desligadas)
+void heap_stats_alloc_failed(heap_stage_t stage, uint32_t caps, size_t size);
+void heap_stats_reset(void);
+
+void heap_stats_get(heap_stage_t stage, heap_stage_stats_t *out);
+void heap_stats_get_events(heap_events_t *out);
+void heap_stats_now(heap_region_t region, heap_region_now_t *out);
+uint32_t heap_stats_watch_block(heap_region_t region);
+const char *heap_stage_name(heap_stage_t stage);
+const char *heap_region_name(heap_region_t region);
+
+#define HEAP_STATS_SAMPLE(stage) do { if (heap_stats_on) heap_stats_sample(stage); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,11 +7,43 @@
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "classifier.h"
+#include "heap_stats.h"
+#include "server.h"
+#include "task_stats.h"
+#include "trace.h"
 
 // --- CONFIG ---
 #define SSID "NOME_REDE"
 #define PASS "SENHA_REDE"
 
+// Pré-filtro de cor/brilho antes da CNN (ajuste os limiares com Host/prefilter_report antes de ativar)
+#define USE_PREFILTER 0
+
+// Reaproveita o último score enquanto a cena estiver estática (até max_age_ms).
+// Desligado: nenhum replay ou accuracy_report mede ainda detecções perdidas ou
+// atrasadas com o gate ligado
+#define USE_SCENE_GATE 0
+
+// Pirâmide de escalas: recortes 2x em rodízio para fogo pequeno/distante
+// (no máximo um Invoke extra por frame). Desligada: no pyramid_report eleva
+// os falsos positivos de 41 para 66; ative só onde o fogo distante importa
+#define USE_PYRAMID 0
+
+// Fusão temporal: EMA + 2 de 3 votos + histerese (0 = decisão de um único frame).
+// Atrasa a detecção (2 votos) sem ganho medido em alarmes falsos: desligada
+#define USE_FUSION 0
+
+// Memória livre / maior bloco por estágio do pipeline (GET /heap; também liga
+// com /heap?enable=1). Desligada: heap_caps_get_largest_free_block percorre o
+// heap sob lock em cada estágio de cada frame; ligue só para diagnóstico
+#define USE_HEAP_STATS 0
+
+// CPU e pilha por tarefa, amostradas a cada segundo (GET /tasks)
+#define USE_TASK_STATS 1
+
+// Linha do tempo do pipeline desde o boot (GET /trace; também liga com /trace?enable=1)
+#define USE_TRACE 0
+
 // Pinos AI-Thinker
 #define PWDN_GPIO_NUM 32
 #define RESET_GPIO_NUM -1
@@ -30,7 +62,6 @@
 #define HREF_GPIO_NUM 23
 #define PCLK_GPIO_NUM 22
 
-void start_camera_server(); // do server.cpp
 static const char *TAG = "MAIN";
 
 static void wifi_event_handler(void* arg, esp_event_base_t event_base, int32_t event_id, void* event_data) {
@@ -115,6 +146,27 @@ extern "C" void app_main() {
     nvs_flash_init();
     init_camera();
     classifier_init(12.0f);
+    if (USE_PREFILTER) {
+        prefilter_config_t pf;
+        prefilter_default_config(&pf);
+        pf.enabled = true;
+        classifier_set_prefilter(&pf);
+    }
+    if (USE_SCENE_GATE) {
+        scene_gate_config_t gate;
+        scene_gate_default_config(&gate);
+        gate.enabled = true;
+        classifier_set_scene_gate(&gate);
+    }
+    if (USE_FUSION) {
+        fusion_config_t fusion = { .ema_alpha = 0.6f, .vote_k = 2, .vote_n = 3,
+                                   .on_threshold = 0.60f, .off_threshold = 0.45f };
+        server_set_fusion(&fusion);
+    }
+    server_set_pyramid(USE_PYRAMID);
+    heap_stats_set_enabled(USE_HEAP_STATS);
+    if (USE_TRACE) trace_set_enabled(true);
+    if (USE_TASK_STATS) task_stats_start();
     init_wifi();
     start_camera_server();
     while (1) vTaskDelay(1000);
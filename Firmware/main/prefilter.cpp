@@ -0,0 +1,22 @@
+#include "prefilter.h"
+
+// Valores conservadores: com gamma 12 quase todo pixel que não é muito claro
+// vira preto, então um frame sem pixels brilhantes nem cor de fogo não tem o que
+// a CNN classificar como fogo. Ajuste com Host/prefilter_report.
+void prefilter_default_config(prefilter_config_t *cfg) {
+    cfg->enabled = false;
+    cfg->fire_r_min = 64;
+    cfg->bright_min = 96;
+    cfg->fire_ratio_min = 5;   // 0.05% ~ 5 pixels em 96x96
+    cfg->bright_ratio_min = 5;
+}
+
+bool prefilter_is_benign(const prefilter_config_t *cfg, const prefilter_stats_t *s) {
+    if (!cfg->enabled || s->pixels == 0) return false;
+
+    // Compara frações sem divisão: count * 10000 < ratio * pixels
+    uint32_t fire = s->fire_pixels * 10000u;
+    uint32_t bright = s->bright_pixels * 10000u;
+    return fire < (uint32_t)cfg->fire_ratio_min * s->pixels &&
+           bright < (uint32_t)cfg->bright_ratio_min * s->pixels;
+}
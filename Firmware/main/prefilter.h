@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pré-filtro de cor/brilho: estágio barato antes do Invoke.
+// Trabalha sobre a entrada 96x96 já com gamma (o que a CNN realmente vê),
+// apenas com aritmética inteira.
+typedef struct {
+    bool enabled;
+    uint8_t fire_r_min;        // R mínimo para um pixel "cor de fogo" (R >= G >= B)
+    uint8_t bright_min;        // Canal máximo mínimo para um pixel "brilhante"
+    uint16_t fire_ratio_min;   // Fração mínima de pixels cor de fogo (em 1/10000)
+    uint16_t bright_ratio_min; // Fração mínima de pixels brilhantes (em 1/10000)
+} prefilter_config_t;
+
+// Estatísticas acumuladas durante o pré-processamento
+typedef struct {
+    uint32_t pixels;
+    uint32_t fire_pixels;
+    uint32_t bright_pixels;
+    uint32_t luma_sum;
+    uint8_t luma_max;
+} prefilter_stats_t;
+
+void prefilter_default_config(prefilter_config_t *cfg);
+
+// Chamado por pixel dentro do loop de resize, por isso inline
+static inline void prefilter_accumulate(prefilter_stats_t *s, const prefilter_config_t *cfg,
+                                        uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t max = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    uint8_t luma = (uint8_t)((77 * r + 150 * g + 29 * b) >> 8);
+    s->pixels++;
+    s->luma_sum += luma;
+    if (luma > s->luma_max) s->luma_max = luma;
+    if (max >= cfg->bright_min) s->bright_pixels++;
+    if (r >= cfg->fire_r_min && r >= g && g >= b) s->fire_pixels++;
+}
+
+// true quando o frame é claramente benigno e a CNN pode ser pulada
+bool prefilter_is_benign(const prefilter_config_t *cfg, const prefilter_stats_t *s);
+
+#ifdef __cplusplus
+}
+#endif
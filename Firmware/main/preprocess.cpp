@@ -0,0 +1,75 @@
+#include "preprocess.h"
+#include <math.h>
+
+void preprocess_build_gamma_lut(float gamma, uint8_t lut[256]) {
+    if (gamma <= 0.0f) gamma = 0.1f;
+    for (int i = 0; i < 256; i++) {
+        float norm = (float)i / 255.0f;
+        float res = powf(norm, gamma) * 255.0f;
+        if (res > 255.0f) res = 255.0f;
+        if (res < 0.0f) res = 0.0f;
+        lut[i] = (uint8_t)res;
+    }
+}
+
+void preprocess_square_crop(const uint8_t *rgb, int src_w, int src_h, const uint8_t *lut,
+                            uint8_t *dst, const prefilter_config_t *pf, prefilter_stats_t *stats) {
+    // Geometria de Recorte (Square Crop)
+    // Ex.: 320x240 -> quadrado de 240x240 com 40 pixels de margem à esquerda
+    int crop_size = src_h < src_w ? src_h : src_w;
+    preprocess_crop(rgb, src_w, src_h, (src_w - crop_size) / 2, (src_h - crop_size) / 2,
+                    crop_size, lut, dst, pf, stats);
+}
+
+void preprocess_crop(const uint8_t *rgb, int src_w, int src_h, int start_x, int start_y,
+                     int crop_size, const uint8_t *lut, uint8_t *dst,
+                     const prefilter_config_t *pf, prefilter_stats_t *stats) {
+    preprocess_crop_masked(rgb, src_w, src_h, start_x, start_y, crop_size, lut, dst, pf, stats, NULL);
+}
+
+void preprocess_crop_masked(const uint8_t *rgb, int src_w, int src_h, int start_x, int start_y,
+                            int crop_size, const uint8_t *lut, uint8_t *dst,
+                            const prefilter_config_t *pf, prefilter_stats_t *stats,
+                            const exclusion_mask_t *mask) {
+    // Razão de redução (240 / 96 = 2.5)
+    float ratio = (float)crop_size / DST_W;
+    bool use_pf = pf && stats && pf->enabled;
+    bool use_mask = mask && mask->enabled;
+
+    for (int y = 0; y < DST_H; y++) {
+        // Mapeia Y destino -> Y fonte
+        int sy = start_y + (int)(y * ratio);
+        if (sy < 0) sy = 0;
+        if (sy >= src_h) sy = src_h - 1;
+
+        // Otimização: ponteiro para o início da linha
+        const uint8_t *src_row = rgb + (sy * src_w * 3);
+        uint8_t *dst_row = dst + y * DST_W * 3;
+        int mask_row = use_mask ? exclusion_mask_row(sy, src_h) : 0;
+
+        for (int x = 0; x < DST_W; x++) {
+            // Mapeia X destino -> X fonte (com deslocamento start_x)
+            int sx = start_x + (int)(x * ratio);
+
+            // Proteção de limites
+            if (sx < 0) sx = 0;
+            if (sx >= src_w) sx = src_w - 1;
+
+            const uint8_t *p = src_row + sx * 3;
+
+            // Aplica Gamma (LUT); região excluída vira preto
+            uint8_t r = 0, g = 0, b = 0;
+            if (!use_mask || !exclusion_mask_cell(mask, exclusion_mask_col(sx, src_w), mask_row)) {
+                r = lut[p[0]];
+                g = lut[p[1]];
+                b = lut[p[2]];
+            }
+
+            dst_row[x * 3 + 0] = r;
+            dst_row[x * 3 + 1] = g;
+            dst_row[x * 3 + 2] = b;
+
+            if (use_pf) prefilter_accumulate(stats, pf, r, g, b);
+        }
+    }
+}
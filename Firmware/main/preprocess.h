@@ -0,0 +1,39 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "prefilter.h"
+#include "exclusion_mask.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Entradas da IA
+#define DST_W 96
+#define DST_H 96
+
+// Look Up Table de Correção Gama, para um menor custo computacional
+void preprocess_build_gamma_lut(float gamma, uint8_t lut[256]);
+
+// Recorte quadrado (x, y, size) da imagem fonte + resize nearest-neighbour + gamma.
+// Escreve DST_W x DST_H x 3 bytes RGB em dst. Com pf/stats != NULL
+// acumula as estatísticas do pré-filtro no mesmo passe.
+void preprocess_crop(const uint8_t *rgb, int src_w, int src_h, int crop_x, int crop_y,
+                     int crop_size, const uint8_t *lut, uint8_t *dst,
+                     const prefilter_config_t *pf, prefilter_stats_t *stats);
+
+// Mesmo recorte, com os pixels fonte em células mascaradas neutralizados
+// (preto, como a CNN vê o fundo escuro depois do gamma); o pré-filtro conta
+// esses pixels como pretos. mask == NULL ou desativada = preprocess_crop.
+void preprocess_crop_masked(const uint8_t *rgb, int src_w, int src_h, int crop_x, int crop_y,
+                            int crop_size, const uint8_t *lut, uint8_t *dst,
+                            const prefilter_config_t *pf, prefilter_stats_t *stats,
+                            const exclusion_mask_t *mask);
+
+// Recorte quadrado central (ex.: 240x240 de um frame 320x240)
+void preprocess_square_crop(const uint8_t *rgb, int src_w, int src_h, const uint8_t *lut,
+                            uint8_t *dst, const prefilter_config_t *pf, prefilter_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+#include "pyramid.h"
+
+// Posição do i-ésimo de n recortes de tamanho size em [0, extent): o primeiro
+// encosta no início, o último no fim, os demais distribuídos entre eles
+static int16_t tile_pos(int i, int n, int extent, int size) {
+    if (n <= 1) return (int16_t)((extent - size) / 2);
+    return (int16_t)(i * (extent - size) / (n - 1));
+}
+
+void pyramid_init(pyramid_t *p, int src_w, int src_h, int zoom, int32_t q_zero, int32_t zoom_min_q,
+                  const exclusion_mask_t *mask) {
+    p->n_tiles = 0;
+    p->q_zero = q_zero;
+    p->zoom_min_q = zoom_min_q;
+    if (zoom < 2 || src_w <= 0 || src_h <= 0) {
+        pyramid_reset(p);
+        return;
+    }
+
+    int size = (src_w < src_h ? src_w : src_h) / zoom;
+    if (size < 1) size = 1;
+    int cols = (src_w + size - 1) / size;
+    int rows = (src_h + size - 1) / size;
+    while (cols * rows > PYRAMID_MAX_TILES) {
+        // Zoom alto demais para a grade: recortes maiores
+        size++;
+        cols = (src_w + size - 1) / size;
+        rows = (src_h + size - 1) / size;
+    }
+
+    for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+            classifier_crop_t *t = &p->tiles[p->n_tiles];
+            t->x = tile_pos(c, cols, src_w, size);
+            t->y = tile_pos(r, rows, src_h, size);
+            t->size = (uint16_t)size;
+            if (!exclusion_mask_covers(mask, src_w, src_h, t->x, t->y, size)) p->n_tiles++;
+        }
+    }
+    pyramid_reset(p);
+}
+
+void pyramid_reset(pyramid_t *p) {
+    for (int i = 0; i < PYRAMID_MAX_TILES; i++) p->tile_q[i] = p->q_zero;
+    p->next = 0;
+    p->full_q = p->q_zero;
+    p->zoom_q = p->q_zero;
+    p->best_tile = -1;
+}
+
+const classifier_crop_t *pyramid_next_tile(const pyramid_t *p) {
+    return p->n_tiles ? &p->tiles[p->next] : NULL;
+}
+
+int32_t pyramid_update(pyramid_t *p, int32_t full_q, bool tile_ran, int32_t tile_q) {
+    p->full_q = full_q;
+    if (tile_ran && p->n_tiles) {
+        p->tile_q[p->next] = tile_q;
+        p->next = (uint8_t)((p->next + 1) % p->n_tiles);
+
+        // Recortes ainda não visitados valem q_zero (no máximo 12 comparações)
+        int best = 0;
+        for (int i = 1; i < p->n_tiles; i++)
+            if (p->tile_q[i] > p->tile_q[best]) best = i;
+        p->best_tile = (int8_t)best;
+        p->zoom_q = p->tile_q[best];
+    }
+    return (p->zoom_q > p->zoom_min_q && p->zoom_q > full_q) ? p->zoom_q : full_q;
+}
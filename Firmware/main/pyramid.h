@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "classifier.h"
+#include "exclusion_mask.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pirâmide de escalas para fogo pequeno/distante: o frame inteiro (recorte
+// central) em todo frame inferido + um recorte com zoom por frame, em
+// rodízio sobre uma grade que cobre a imagem toda. Custo: no máximo um
+// Invoke extra por frame. Cada recorte guarda o último score até ser
+// visitado de novo; a decisão usa o maior entre o frame inteiro e os recortes.
+// Um recorte só entra acima de um limiar próprio, mais alto: com o zoom, o
+// modelo vê mais texturas fora da distribuição de treino e os falsos
+// positivos sobem (Host/pyramid_report mede o compromisso).
+#define PYRAMID_MAX_TILES 12
+#define PYRAMID_ZOOM_THRESHOLD 0.90f
+
+typedef struct {
+    classifier_crop_t tiles[PYRAMID_MAX_TILES];
+    int32_t tile_q[PYRAMID_MAX_TILES]; // Último score cru de cada recorte
+    uint8_t n_tiles;
+    uint8_t next;      // Próximo recorte do rodízio
+    int32_t full_q;    // Score do frame inteiro
+    int32_t zoom_q;    // Maior score entre os recortes
+    int8_t best_tile;  // Recorte com zoom_q (-1 antes da primeira visita)
+    int32_t q_zero;
+    int32_t zoom_min_q; // Recortes só contam com score cru > zoom_min_q
+} pyramid_t;
+
+// Grade de recortes quadrados de min(w, h) / zoom pixels (zoom 2 em 320x240:
+// 3x2 recortes de 120, sobrepostos na horizontal e cobrindo as margens que o
+// recorte central não vê). q_zero = score 0.0 no domínio da saída;
+// zoom_min_q = score_quant_threshold(PYRAMID_ZOOM_THRESHOLD). Recortes
+// inteiramente cobertos pela máscara (opcional) ficam fora do rodízio.
+void pyramid_init(pyramid_t *p, int src_w, int src_h, int zoom, int32_t q_zero, int32_t zoom_min_q,
+                  const exclusion_mask_t *mask);
+void pyramid_reset(pyramid_t *p);
+
+// Recorte a avaliar neste frame (NULL sem recortes)
+const classifier_crop_t *pyramid_next_tile(const pyramid_t *p);
+
+// Registra o frame inteiro e, se tile_ran, o recorte da vez (que avança o
+// rodízio). Devolve o score combinado: o maior recorte, se passar de
+// zoom_min_q e do frame inteiro; senão o frame inteiro.
+int32_t pyramid_update(pyramid_t *p, int32_t full_q, bool tile_ran, int32_t tile_q);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,54 @@
+#include "scene_gate.h"
+#include <string.h>
+
+void scene_gate_default_config(scene_gate_config_t *cfg) {
+    cfg->enabled = false;
+    cfg->max_mean_diff = 2;
+    cfg->max_block_diff = 12;
+    cfg->max_age_ms = 5000;
+}
+
+void scene_gate_thumbnail(const uint8_t *rgb, uint8_t thumb[SCENE_THUMB_N]) {
+    uint32_t sums[SCENE_THUMB_W];
+
+    for (int by = 0; by < SCENE_THUMB_H; by++) {
+        memset(sums, 0, sizeof(sums));
+        for (int y = 0; y < SCENE_BLOCK; y++) {
+            const uint8_t *row = rgb + (by * SCENE_BLOCK + y) * SCENE_THUMB_W * SCENE_BLOCK * 3;
+            for (int x = 0; x < SCENE_THUMB_W * SCENE_BLOCK; x++) {
+                const uint8_t *p = row + x * 3;
+                sums[x / SCENE_BLOCK] += (77 * p[0] + 150 * p[1] + 29 * p[2]) >> 8;
+            }
+        }
+        // Média do bloco: divide por 64 pixels
+        for (int bx = 0; bx < SCENE_THUMB_W; bx++) {
+            thumb[by * SCENE_THUMB_W + bx] = (uint8_t)(sums[bx] / (SCENE_BLOCK * SCENE_BLOCK));
+        }
+    }
+}
+
+bool scene_gate_check(const scene_gate_t *gate, const scene_gate_config_t *cfg,
+                      const uint8_t thumb[SCENE_THUMB_N], int64_t now_ms, float *score) {
+    if (!cfg->enabled || !gate->valid) return false;
+    if (now_ms - gate->last_ms >= (int64_t)cfg->max_age_ms) return false;
+
+    uint32_t total = 0;
+    for (int i = 0; i < SCENE_THUMB_N; i++) {
+        int d = (int)thumb[i] - (int)gate->thumb[i];
+        if (d < 0) d = -d;
+        if (d > cfg->max_block_diff) return false;
+        total += d;
+    }
+    if (total > (uint32_t)cfg->max_mean_diff * SCENE_THUMB_N) return false;
+
+    *score = gate->score;
+    return true;
+}
+
+void scene_gate_update(scene_gate_t *gate, const uint8_t thumb[SCENE_THUMB_N], float score,
+                       int64_t now_ms) {
+    memcpy(gate->thumb, thumb, SCENE_THUMB_N);
+    gate->score = score;
+    gate->last_ms = now_ms;
+    gate->valid = true;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Gate de mudança de cena: compara uma miniatura de blocos de luma da entrada
+// 96x96 com a do último frame classificado. Cena estática reaproveita o score.
+#define SCENE_BLOCK 8
+#define SCENE_THUMB_W (96 / SCENE_BLOCK)
+#define SCENE_THUMB_H (96 / SCENE_BLOCK)
+#define SCENE_THUMB_N (SCENE_THUMB_W * SCENE_THUMB_H)
+
+typedef struct {
+    bool enabled;
+    uint8_t max_mean_diff;   // Diferença média máxima entre blocos (0-255)
+    uint8_t max_block_diff;  // Diferença máxima em um único bloco (fogo pequeno)
+    uint32_t max_age_ms;     // Força nova inferência após esse tempo
+} scene_gate_config_t;
+
+typedef struct {
+    uint8_t thumb[SCENE_THUMB_N];
+    bool valid;
+    float score;
+    int64_t last_ms;
+} scene_gate_t;
+
+void scene_gate_default_config(scene_gate_config_t *cfg);
+
+// Miniatura (média de luma por bloco) da entrada RGB888 96x96
+void scene_gate_thumbnail(const uint8_t *rgb, uint8_t thumb[SCENE_THUMB_N]);
+
+// true se a cena não mudou: *score recebe o score em cache
+bool scene_gate_check(const scene_gate_t *gate, const scene_gate_config_t *cfg,
+                      const uint8_t thumb[SCENE_THUMB_N], int64_t now_ms, float *score);
+
+// Registra o resultado de uma inferência nova
+void scene_gate_update(scene_gate_t *gate, const uint8_t thumb[SCENE_THUMB_N], float score,
+                       int64_t now_ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,24 @@
+#include "score_quant.h"
+#include <math.h>
+
+float score_quant_to_float(const score_quant_t *sq, int32_t q) {
+    return (float)(q - sq->zero_point) * sq->scale;
+}
+
+int32_t score_quant_threshold(const score_quant_t *sq, float t) {
+    // score(q) é monotônico em q: busca binária pelo último q que não passa de t
+    int32_t lo = sq->q_min - 1, hi = sq->q_max;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo + 1) / 2;
+        if (score_quant_to_float(sq, mid) <= t) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+int32_t score_quant_from_float(const score_quant_t *sq, float score) {
+    long q = lroundf(score / sq->scale) + sq->zero_point;
+    if (q < sq->q_min) q = sq->q_min;
+    if (q > sq->q_max) q = sq->q_max;
+    return (int32_t)q;
+}
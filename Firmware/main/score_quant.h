@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Score no domínio quantizado da saída do modelo: score = (q - zero_point) * scale.
+// Limiares são convertidos uma vez para esse domínio e a decisão por frame vira
+// uma comparação inteira; o float só aparece quando alguém lê o score.
+typedef struct {
+    float scale;
+    int32_t zero_point;
+    int32_t q_min, q_max; // Faixa de valores da saída
+} score_quant_t;
+
+float score_quant_to_float(const score_quant_t *sq, int32_t q);
+
+// Maior q com score(q) <= t (q_min - 1 se nenhum): "score > t" equivale a
+// "q > score_quant_threshold(t)", com a mesma aritmética float da conversão
+int32_t score_quant_threshold(const score_quant_t *sq, float t);
+
+// q mais próximo de um score (ex.: 0.0 de um frame descartado pelo pré-filtro)
+int32_t score_quant_from_float(const score_quant_t *sq, float score);
+
+#ifdef __cplusplus
+}
+#endif
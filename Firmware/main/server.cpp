@@ -1,22 +1,137 @@
 #include "esp_http_server.h"
 #include "esp_camera.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "img_converters.h"
+#include "nvs.h"
 #include "classifier.h"
+#include "pyramid.h"
+#include "server.h"
+#include "heap_stats.h"
+#include "task_stats.h"
+#include "trace.h"
 
 static const char *TAG = "SERVER";
 
 // Variáveis de Estado
+// Scores guardados no domínio quantizado da saída; float só no /status e no log
 static bool g_fire_detected = false;
-static float g_fire_score = 0.0f;
+static int32_t g_fire_score_q8 = 0;   // Score fundido (decisão), q * 256
+static int32_t g_fire_score_raw_q = 0; // Score do último frame
 static int g_frame_counter = 0;
 
+// Idade do que o monitor mostra: cada frame servido ganha um id e o instante
+// da captura (esp_timer, us desde o boot, o mesmo relógio do fb->timestamp);
+// o score lembra de qual frame veio e quando a inferência terminou
+static uint32_t g_frame_id = 0;
+static int64_t g_frame_capture_us = 0;
+static uint32_t g_score_frame_id = 0;
+static int64_t g_score_capture_us = 0, g_score_infer_us = 0;
+static score_quant_t g_quant = {1.0f / 255.0f, 0, 0, 255};
+
+// Fusão temporal (padrão = decisão de um único frame)
+static fusion_config_t g_fusion_cfg = { 1.0f, 1, 1, 0.60f, 0.60f };
+static fusion_qconfig_t g_fusion_q = {};
+static fusion_t g_fusion = {};
+
+// Pirâmide de escalas (desativada = só o frame inteiro); a grade é montada
+// no primeiro frame, com a resolução real da câmera
+static bool g_pyramid_enabled = false;
+static pyramid_t g_pyramid = {};
+static uint16_t g_pyramid_w = 0, g_pyramid_h = 0;
+
+// Máscara de exclusão da câmera, persistida na NVS (namespace "fire")
+static exclusion_mask_t g_mask = {};
+static const char *MASK_NVS_NS = "fire";
+static const char *MASK_NVS_KEY = "mask";
+
+static void load_mask() {
+    exclusion_mask_clear(&g_mask);
+    nvs_handle_t h;
+    if (nvs_open(MASK_NVS_NS, NVS_READONLY, &h) == ESP_OK) {
+        uint8_t bits[MASK_BYTES];
+        size_t len = sizeof(bits);
+        if (nvs_get_blob(h, MASK_NVS_KEY, bits, &len) == ESP_OK) exclusion_mask_load(&g_mask, bits, len);
+        nvs_close(h);
+    }
+    classifier_set_exclusion_mask(&g_mask);
+    if (g_mask.enabled) ESP_LOGI(TAG, "Mascara de exclusao: %d celulas", exclusion_mask_count(&g_mask));
+}
+
+static esp_err_t save_mask() {
+    nvs_handle_t h;
+    esp_err_t err = nvs_open(MASK_NVS_NS, NVS_READWRITE, &h);
+    if (err != ESP_OK) return err;
+    err = g_mask.enabled ? nvs_set_blob(h, MASK_NVS_KEY, g_mask.bits, MASK_BYTES) : nvs_erase_key(h, MASK_NVS_KEY);
+    if (err == ESP_ERR_NVS_NOT_FOUND) err = ESP_OK; // Apagar o que não existe
+    if (err == ESP_OK) err = nvs_commit(h);
+    nvs_close(h);
+    return err;
+}
+
+// Limiares no domínio da saída: convertidos aqui, nunca por frame
+static void prepare_fusion() {
+    classifier_get_output_quant(&g_quant);
+    fusion_quantize_config(&g_fusion_cfg, &g_quant, &g_fusion_q);
+    fusion_reset(&g_fusion);
+    g_pyramid_w = g_pyramid_h = 0;
+}
+
+static float fused_score() {
+    return (g_fire_score_q8 / 256.0f - g_quant.zero_point) * g_quant.scale;
+}
+
+void server_set_fusion(const fusion_config_t *cfg) {
+    g_fusion_cfg = *cfg;
+    prepare_fusion();
+}
+
+void server_set_pyramid(bool enabled) {
+    g_pyramid_enabled = enabled;
+    g_pyramid_w = g_pyramid_h = 0;
+}
+
+// Frame inteiro + recorte da vez; devolve o score combinado das escalas
+static int32_t predict_pyramid(camera_fb_t *fb) {
+    if (fb->width != g_pyramid_w || fb->height != g_pyramid_h) {
+        pyramid_init(&g_pyramid, fb->width, fb->height, 2, score_quant_from_float(&g_quant, 0.0f),
+                     score_quant_threshold(&g_quant, PYRAMID_ZOOM_THRESHOLD), &g_mask);
+        g_pyramid_w = fb->width;
+        g_pyramid_h = fb->height;
+    }
+    int32_t full_q, zoom_q = 0;
+    bool zoom_ran = classifier_predict_pyramid_q(fb->buf, fb->len, pyramid_next_tile(&g_pyramid), &full_q, &zoom_q);
+    return pyramid_update(&g_pyramid, full_q, zoom_ran, zoom_q);
+}
+
 // Handler de STATUS (JSON para a UI do Qt)
 esp_err_t status_handler(httpd_req_t *req) {
-    char json_response[128];
-    snprintf(json_response, sizeof(json_response), "{\"fire\":%s, \"score\":%.1f}", 
+    classifier_stats_t st;
+    classifier_get_stats(&st);
+    float gate_rate = st.frames ? 100.0f * st.gate_hits / st.frames : 0.0f;
+
+    // Scores por escala: frame inteiro e o maior recorte com zoom (-1 sem pirâmide)
+    float full_score = g_pyramid_enabled ? score_quant_to_float(&g_quant, g_pyramid.full_q) * 100.0f : -1.0f;
+    float zoom_score = g_pyramid_enabled ? score_quant_to_float(&g_quant, g_pyramid.zoom_q) * 100.0f : -1.0f;
+
+    // device_us: relógio do dispositivo na resposta, para o monitor estimar o offset
+    char json_response[640];
+    snprintf(json_response, sizeof(json_response),
+             "{\"fire\":%s, \"score\":%.1f, \"raw_score\":%.1f, \"frames\":%lu, \"invokes\":%lu, "
+             "\"prefilter_skips\":%lu, \"gate_hit_rate\":%.1f, \"cpu_saved_ms\":%llu, "
+             "\"full_score\":%.1f, \"zoom_score\":%.1f, \"zoom_tile\":%d, "
+             "\"masked_cells\":%d, \"mask_skips\":%lu, \"frame_id\":%lu, \"frame_capture_us\":%lld, "
+             "\"score_frame_id\":%lu, \"score_capture_us\":%lld, \"score_infer_us\":%lld, \"device_us\":%lld}",
              g_fire_detected ? "true" : "false", 
-             g_fire_score * 100.0f);
+             fused_score() * 100.0f, score_quant_to_float(&g_quant, g_fire_score_raw_q) * 100.0f,
+             (unsigned long)st.frames, (unsigned long)st.invokes,
+             (unsigned long)st.prefilter_skips, gate_rate,
+             (unsigned long long)(st.cpu_saved_us / 1000),
+             full_score, zoom_score, g_pyramid_enabled ? g_pyramid.best_tile : -1,
+             exclusion_mask_count(&g_mask), (unsigned long)st.mask_skips,
+             (unsigned long)g_frame_id, (long long)g_frame_capture_us, (unsigned long)g_score_frame_id,
+             (long long)g_score_capture_us, (long long)g_score_infer_us, (long long)esp_timer_get_time());
             
     httpd_resp_set_type(req, "application/json");
     httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
@@ -27,39 +142,257 @@ esp_err_t status_handler(httpd_req_t *req) {
     return ESP_OK;
 }
 
+// Handler da MÁSCARA: GET devolve o blob; POST com MASK_BYTES grava (corpo
+// vazio remove). Formato em exclusion_mask.h.
+esp_err_t mask_handler(httpd_req_t *req) {
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    if (req->method == HTTP_GET) {
+        httpd_resp_set_type(req, "application/octet-stream");
+        return httpd_resp_send(req, (const char *)g_mask.bits, MASK_BYTES);
+    }
+
+    if (req->content_len != 0 && req->content_len != MASK_BYTES) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "mascara deve ter 96 bytes");
+        return ESP_FAIL;
+    }
+    uint8_t bits[MASK_BYTES];
+    size_t got = 0;
+    while (got < req->content_len) {
+        int n = httpd_req_recv(req, (char *)bits + got, req->content_len - got);
+        if (n == HTTPD_SOCK_ERR_TIMEOUT) continue;
+        if (n <= 0) return ESP_FAIL;
+        got += n;
+    }
+
+    if (got) exclusion_mask_load(&g_mask, bits, got);
+    else exclusion_mask_clear(&g_mask);
+    classifier_set_exclusion_mask(&g_mask);
+    g_pyramid_w = g_pyramid_h = 0; // Refaz o rodízio sem os recortes mascarados
+    if (save_mask() != ESP_OK) ESP_LOGE(TAG, "Falha ao salvar a mascara na NVS");
+    ESP_LOGI(TAG, "Mascara de exclusao: %d celulas", exclusion_mask_count(&g_mask));
+    httpd_resp_set_type(req, "application/json");
+    char json[48];
+    snprintf(json, sizeof(json), "{\"masked_cells\":%d}", exclusion_mask_count(&g_mask));
+    return httpd_resp_send(req, json, strlen(json));
+}
+
+static bool send_trace_chunk(void *ctx, const char *buf, size_t len) {
+    return httpd_resp_send_chunk((httpd_req_t *)ctx, buf, len) == ESP_OK;
+}
+
+// Handler do TRACE: GET devolve a linha do tempo em JSON do Chrome trace
+// (abrir no Perfetto); ?enable=1|0 liga/desliga e ?clear=1 esvazia os anéis
+esp_err_t trace_handler(httpd_req_t *req) {
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    char query[64], val[8];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        bool changed = false;
+        if (httpd_query_key_value(query, "clear", val, sizeof(val)) == ESP_OK && val[0] == '1') {
+            trace_clear();
+            changed = true;
+        }
+        if (httpd_query_key_value(query, "enable", val, sizeof(val)) == ESP_OK) {
+            trace_set_enabled(val[0] == '1');
+            changed = true;
+        }
+        if (changed) {
+            httpd_resp_set_type(req, "application/json");
+            return httpd_resp_send(req, trace_on ? "{\"tracing\":true}" : "{\"tracing\":false}",
+                                   HTTPD_RESP_USE_STRLEN);
+        }
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=trace.json");
+    int n = trace_write_json(send_trace_chunk, req);
+    if (n < 0) {
+        ESP_LOGE(TAG, "Falha ao enviar o trace");
+        return ESP_FAIL;
+    }
+    ESP_LOGI(TAG, "Trace enviado: %d eventos", n);
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// Handler do HEAP: retrato atual de cada região + estatísticas por estágio
+// do pipeline desde o boot (ou desde ?reset=1) + falhas de alocação;
+// ?enable=1|0 liga/desliga a amostragem por estágio
+esp_err_t heap_handler(httpd_req_t *req) {
+    char query[32], val[8];
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK) {
+        if (httpd_query_key_value(query, "enable", val, sizeof(val)) == ESP_OK)
+            heap_stats_set_enabled(val[0] == '1');
+        if (httpd_query_key_value(query, "reset", val, sizeof(val)) == ESP_OK && val[0] == '1')
+            heap_stats_reset();
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
+
+    // Um pedaço por bloco do JSON: nada grande na pilha do httpd
+    char buf[384];
+    heap_events_t ev;
+    heap_stats_get_events(&ev);
+    snprintf(buf, sizeof(buf), "{\"enabled\":%s, \"uptime_ms\":%lld, \"alloc_failures\":%lu, "
+             "\"pressure_events\":%lu, \"last_failure\":",
+             heap_stats_on ? "true" : "false", (long long)(esp_timer_get_time() / 1000),
+             (unsigned long)ev.alloc_failures, (unsigned long)ev.pressure_events);
+    httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+    if (ev.alloc_failures) {
+        snprintf(buf, sizeof(buf), "{\"ms\":%lld, \"stage\":\"%s\", \"region\":\"%s\", \"size\":%lu, "
+                 "\"free\":%lu, \"largest\":%lu}",
+                 (long long)ev.last_failure_ms, heap_stage_name(ev.last_failure_stage),
+                 heap_region_name(ev.last_failure_region), (unsigned long)ev.last_failure_size,
+                 (unsigned long)ev.last_failure_free, (unsigned long)ev.last_failure_largest);
+    } else {
+        snprintf(buf, sizeof(buf), "null");
+    }
+    httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+
+    for (int r = 0; r < HEAP_REGION_COUNT; r++) {
+        heap_region_now_t now;
+        heap_stats_now((heap_region_t)r, &now);
+        snprintf(buf, sizeof(buf), ", \"%s\":{\"total\":%lu, \"free\":%lu, \"largest\":%lu, "
+                 "\"min_free_ever\":%lu, \"frag\":%u, \"watch_block\":%lu}",
+                 heap_region_name((heap_region_t)r), (unsigned long)now.total, (unsigned long)now.free,
+                 (unsigned long)now.largest, (unsigned long)now.min_free_ever, now.frag,
+                 (unsigned long)heap_stats_watch_block((heap_region_t)r));
+        httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+    }
+
+    httpd_resp_send_chunk(req, ", \"stages\":{", HTTPD_RESP_USE_STRLEN);
+    for (int s = 0; s < HEAP_STAGE_COUNT; s++) {
+        heap_stage_stats_t st;
+        heap_stats_get((heap_stage_t)s, &st);
+        snprintf(buf, sizeof(buf), "%s\"%s\":{\"samples\":%lu", s ? ", " : "", heap_stage_name((heap_stage_t)s),
+                 (unsigned long)st.samples);
+        httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+        for (int r = 0; r < HEAP_REGION_COUNT; r++) {
+            const heap_region_stats_t &rs = st.region[r];
+            snprintf(buf, sizeof(buf), ", \"%s\":{\"free_last\":%lu, \"free_min\":%lu, \"free_avg\":%lu, "
+                     "\"largest_last\":%lu, \"largest_min\":%lu, \"frag_last\":%u, \"frag_max\":%u}",
+                     heap_region_name((heap_region_t)r), (unsigned long)rs.free_last, (unsigned long)rs.free_min,
+                     (unsigned long)rs.free_avg, (unsigned long)rs.largest_last, (unsigned long)rs.largest_min,
+                     rs.frag_last, rs.frag_max);
+            httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+        }
+        httpd_resp_send_chunk(req, "}", HTTPD_RESP_USE_STRLEN);
+    }
+    httpd_resp_send_chunk(req, "}}", HTTPD_RESP_USE_STRLEN);
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+// Handler de TAREFAS: % de CPU, núcleo, prioridade e pilha livre mínima de
+// cada tarefa na janela ?window=N segundos (padrão 5) + carga de cada núcleo
+esp_err_t tasks_handler(httpd_req_t *req) {
+    char query[32], val[8];
+    uint32_t window_s = 5;
+    if (httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+        httpd_query_key_value(query, "window", val, sizeof(val)) == ESP_OK)
+        window_s = (uint32_t)atoi(val);
+
+    // ~700 bytes: fora da pilha do httpd
+    task_stats_report_t *rep = (task_stats_report_t *)heap_caps_malloc(sizeof(task_stats_report_t),
+                                                                        MALLOC_CAP_8BIT);
+    if (!rep) {
+        httpd_resp_send_500(req);
+        return ESP_FAIL;
+    }
+    if (!task_stats_report(window_s, rep)) {
+        free(rep);
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Estatisticas de tarefas indisponiveis");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
+
+    char buf[160];
+    snprintf(buf, sizeof(buf), "{\"window_ms\":%lu, \"cores\":[{\"core\":0, \"load\":%.1f}, "
+             "{\"core\":1, \"load\":%.1f}], \"tasks\":[",
+             (unsigned long)rep->window_ms, rep->core_load[0], rep->core_load[1]);
+    httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+    for (int i = 0; i < rep->n_tasks; i++) {
+        const task_stats_entry_t *e = &rep->tasks[i];
+        snprintf(buf, sizeof(buf), "%s{\"name\":\"%s\", \"core\":%d, \"priority\":%u, \"cpu\":%.1f, "
+                 "\"stack_free_min\":%lu}",
+                 i ? ", " : "", e->name, e->core, e->priority, e->cpu_pct, (unsigned long)e->stack_free_min);
+        httpd_resp_send_chunk(req, buf, HTTPD_RESP_USE_STRLEN);
+    }
+    free(rep);
+    httpd_resp_send_chunk(req, "]}", HTTPD_RESP_USE_STRLEN);
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
 // Handler de CAPTURA (Imagem Original)
 esp_err_t capture_handler(httpd_req_t *req) {
+    TRACE_BEGIN(TRACE_CAPTURE);
+    TRACE_BEGIN(TRACE_FRAME_GRAB);
     camera_fb_t *fb = esp_camera_fb_get();
+    TRACE_END(TRACE_FRAME_GRAB);
     if (!fb) {
         ESP_LOGE(TAG, "Capture Failed");
         httpd_resp_send_500(req);
+        TRACE_END(TRACE_CAPTURE);
         return ESP_FAIL;
     }
+    HEAP_STATS_SAMPLE(HEAP_STAGE_FRAME_GRAB);
+    g_frame_id++;
+    g_frame_capture_us = (int64_t)fb->timestamp.tv_sec * 1000000 + fb->timestamp.tv_usec;
 
     // --- IA (Análise) ---
     // Roda a cada 3 frames para economizar CPU.
     // O classifier_predict faz uma cópia interna para RGB, 
     // então o buffer fb->buf (JPEG) permanece intacto/original.
     if (g_frame_counter++ % 3 == 0) {
-        float score = classifier_predict(fb->buf, fb->len);
-        g_fire_score = score;
-        g_fire_detected = (score > 0.60f); // Threshold 60%
+        // Com a pirâmide, q já combina as escalas (frame inteiro e recortes)
+        int32_t q = g_pyramid_enabled ? predict_pyramid(fb) : classifier_predict_q(fb->buf, fb->len);
+        g_fire_score_raw_q = q;
+        g_fire_score_q8 = fusion_update_q(&g_fusion, &g_fusion_q, q);
+        g_fire_detected = g_fusion.fire; // Threshold 60% (com histerese/votação se configurado)
+        g_score_frame_id = g_frame_id;
+        g_score_capture_us = g_frame_capture_us;
+        g_score_infer_us = esp_timer_get_time();
         
         if (g_fire_detected) {
-            ESP_LOGW(TAG, "FOGO DETECTADO: %.1f%%", score * 100);
+            ESP_LOGW(TAG, "FOGO DETECTADO: %.1f%% (bruto %.1f%%)", fused_score() * 100,
+                     score_quant_to_float(&g_quant, q) * 100);
         }
     }
 
     // Configura Headers para JPEG
     httpd_resp_set_type(req, "image/jpeg");
-    httpd_resp_set_hdr(req, "Content-Disposition", "inline; filename=capture.jpg");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
-    httpd_resp_set_hdr(req, "Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
+    // Carimbos do frame e do score atual (o httpd guarda só os ponteiros: vivem até o envio)
+    char frame_id[12], capture_us[24], score_frame_id[12], device_us[24];
+    snprintf(frame_id, sizeof(frame_id), "%lu", (unsigned long)g_frame_id);
+    snprintf(capture_us, sizeof(capture_us), "%lld", (long long)g_frame_capture_us);
+    snprintf(score_frame_id, sizeof(score_frame_id), "%lu", (unsigned long)g_score_frame_id);
+    snprintf(device_us, sizeof(device_us), "%lld", (long long)esp_timer_get_time());
+    const char *const headers[][2] = {
+        {"Content-Disposition", "inline; filename=capture.jpg"},
+        {"Access-Control-Allow-Origin", "*"},
+        {"Cache-Control", "no-store, no-cache, must-revalidate, max-age=0"},
+        {"X-Frame-Id", frame_id},
+        {"X-Capture-Us", capture_us},
+        {"X-Score-Frame-Id", score_frame_id},
+        {"X-Device-Us", device_us},
+        {"Access-Control-Expose-Headers", "X-Frame-Id, X-Capture-Us, X-Score-Frame-Id, X-Device-Us"},
+    };
+    // Acima de max_resp_headers o httpd recusa o header: o frame sai sem ele
+    for (const auto &h : headers) {
+        esp_err_t err = httpd_resp_set_hdr(req, h[0], h[1]);
+        if (err != ESP_OK) ESP_LOGW(TAG, "Header %s descartado: %s", h[0], esp_err_to_name(err));
+    }
     
     // Envia o buffer ORIGINAL da câmera (sem cortes, sem gamma visual)
+    TRACE_BEGIN(TRACE_SEND);
     esp_err_t res = httpd_resp_send(req, (const char *)fb->buf, fb->len);
+    TRACE_END(TRACE_SEND);
+    HEAP_STATS_SAMPLE(HEAP_STAGE_SEND);
     
     esp_camera_fb_return(fb);
+    TRACE_END(TRACE_CAPTURE);
     return res;
 }
 
@@ -67,16 +400,29 @@ void start_camera_server() {
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.server_port = 80;
     config.stack_size = 4096; // Stack seguro
+    config.max_resp_headers = 12; // /capture usa 8 (o padrão); folga para novos headers
 
     httpd_handle_t server = NULL;
+    prepare_fusion();
+    load_mask();
     
     // Rotas
     httpd_uri_t capture_uri = { .uri = "/capture", .method = HTTP_GET, .handler = capture_handler, .user_ctx = NULL };
     httpd_uri_t status_uri = { .uri = "/status", .method = HTTP_GET, .handler = status_handler, .user_ctx = NULL };
+    httpd_uri_t mask_get_uri = { .uri = "/mask", .method = HTTP_GET, .handler = mask_handler, .user_ctx = NULL };
+    httpd_uri_t mask_post_uri = { .uri = "/mask", .method = HTTP_POST, .handler = mask_handler, .user_ctx = NULL };
+    httpd_uri_t trace_uri = { .uri = "/trace", .method = HTTP_GET, .handler = trace_handler, .user_ctx = NULL };
+    httpd_uri_t heap_uri = { .uri = "/heap", .method = HTTP_GET, .handler = heap_handler, .user_ctx = NULL };
+    httpd_uri_t tasks_uri = { .uri = "/tasks", .method = HTTP_GET, .handler = tasks_handler, .user_ctx = NULL };
 
     if (httpd_start(&server, &config) == ESP_OK) {
         httpd_register_uri_handler(server, &capture_uri);
         httpd_register_uri_handler(server, &status_uri);
+        httpd_register_uri_handler(server, &mask_get_uri);
+        httpd_register_uri_handler(server, &mask_post_uri);
+        httpd_register_uri_handler(server, &trace_uri);
+        httpd_register_uri_handler(server, &heap_uri);
+        httpd_register_uri_handler(server, &tasks_uri);
         ESP_LOGI(TAG, "Servidor Iniciado");
     }
 }
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+#include "fusion.h"
+
+void start_camera_server();
+
+// Fusão temporal dos scores (padrão: decisão de um único frame)
+void server_set_fusion(const fusion_config_t *cfg);
+
+// Pirâmide de escalas: frame inteiro + um recorte 2x por frame em rodízio
+// (pyramid.h); o /status mostra o score de cada escala
+void server_set_pyramid(bool enabled);
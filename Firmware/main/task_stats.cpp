@@ -0,0 +1,123 @@
+#include "task_stats.h"
+#include <algorithm>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+static const char *TAG = "TASKS";
+
+// Retrato: contador de tempo de execução de cada tarefa (pelo número da
+// tarefa, que não se repete como o handle pode) e o total no instante
+typedef struct {
+    UBaseType_t number;
+    uint32_t runtime;
+} task_sample_t;
+
+typedef struct {
+    uint32_t total;
+    int n;
+    task_sample_t tasks[TASK_STATS_MAX_TASKS];
+} snapshot_t;
+
+static SemaphoreHandle_t lock = NULL; // Anel e status_buf: amostradora x handler
+#define RING_SIZE (TASK_STATS_WINDOW + 1) // Janela cheia precisa de um retrato a mais
+static snapshot_t ring[RING_SIZE];
+static int ring_count = 0, ring_next = 0;
+static TaskStatus_t status_buf[TASK_STATS_MAX_TASKS];
+static UBaseType_t warned[TASK_STATS_MAX_TASKS]; // Tarefas já avisadas de pilha baixa
+static int n_warned = 0;
+
+// Estado de todas as tarefas em status_buf (com o lock); 0 = mais tarefas
+// que TASK_STATS_MAX_TASKS
+static int read_state(uint32_t *total) {
+    configRUN_TIME_COUNTER_TYPE t = 0;
+    int n = (int)uxTaskGetSystemState(status_buf, TASK_STATS_MAX_TASKS, &t);
+    *total = (uint32_t)t;
+    if (n == 0) ESP_LOGE(TAG, "Mais de %d tarefas: aumente TASK_STATS_MAX_TASKS", TASK_STATS_MAX_TASKS);
+    return n;
+}
+
+static void check_stack(const TaskStatus_t *st) {
+    if (st->usStackHighWaterMark >= TASK_STATS_STACK_WARN) return;
+    for (int i = 0; i < n_warned; i++) {
+        if (warned[i] == st->xTaskNumber) return;
+    }
+    if (n_warned < TASK_STATS_MAX_TASKS) warned[n_warned++] = st->xTaskNumber;
+    ESP_LOGW(TAG, "Pilha de '%s' quase no fim: %lu bytes livres no pior caso", st->pcTaskName,
+             (unsigned long)st->usStackHighWaterMark);
+}
+
+static void sampler_task(void *) {
+    while (true) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        uint32_t total;
+        int n = read_state(&total);
+        if (n > 0) {
+            snapshot_t *s = &ring[ring_next];
+            s->total = total;
+            s->n = n;
+            for (int i = 0; i < n; i++) {
+                s->tasks[i].number = status_buf[i].xTaskNumber;
+                s->tasks[i].runtime = (uint32_t)status_buf[i].ulRunTimeCounter;
+                check_stack(&status_buf[i]);
+            }
+            ring_next = (ring_next + 1) % RING_SIZE;
+            if (ring_count < RING_SIZE) ring_count++;
+        }
+        xSemaphoreGive(lock);
+        vTaskDelay(pdMS_TO_TICKS(1000));
+    }
+}
+
+void task_stats_start(void) {
+    if (lock) return;
+    lock = xSemaphoreCreateMutex();
+    xTaskCreate(sampler_task, "task_stats", 3072, NULL, 1, NULL);
+}
+
+bool task_stats_report(uint32_t window_s, task_stats_report_t *out) {
+    if (!lock) return false;
+    xSemaphoreTake(lock, portMAX_DELAY);
+    uint32_t total;
+    int n = ring_count ? read_state(&total) : 0;
+    if (n == 0) {
+        xSemaphoreGive(lock);
+        return false;
+    }
+    // O retrato mais recente pode ter acabado de sair: volta um a mais
+    const uint32_t window = std::min<uint32_t>(std::max<uint32_t>(window_s, 1), TASK_STATS_WINDOW);
+    const int back = (int)std::min<uint32_t>(window + 1, ring_count);
+    const snapshot_t *old = &ring[(ring_next - back + RING_SIZE) % RING_SIZE];
+    // Contador do esp_timer (CONFIG_FREERTOS_RUN_TIME_STATS_USING_ESP_TIMER): us
+    const uint32_t dt = std::max<uint32_t>(total - old->total, 1);
+    out->window_ms = dt / 1000;
+    out->core_load[0] = out->core_load[1] = 0.0f;
+    out->n_tasks = n;
+    for (int i = 0; i < n; i++) {
+        const TaskStatus_t *st = &status_buf[i];
+        uint32_t before = 0; // Tarefa criada dentro da janela: conta desde a criação
+        for (int k = 0; k < old->n; k++) {
+            if (old->tasks[k].number == st->xTaskNumber) {
+                before = old->tasks[k].runtime;
+                break;
+            }
+        }
+        task_stats_entry_t *e = &out->tasks[i];
+        strncpy(e->name, st->pcTaskName, sizeof(e->name) - 1);
+        e->name[sizeof(e->name) - 1] = '\0';
+        BaseType_t core = xTaskGetCoreID(st->xHandle);
+        e->core = (core == 0 || core == 1) ? (int)core : -1;
+        e->priority = (unsigned)st->uxCurrentPriority;
+        e->cpu_pct = 100.0f * (uint32_t)((uint32_t)st->ulRunTimeCounter - before) / dt;
+        e->stack_free_min = (uint32_t)st->usStackHighWaterMark;
+        // IDLE0/IDLE1: o que sobra de cada núcleo
+        if (strncmp(e->name, "IDLE", 4) == 0 && e->core >= 0)
+            out->core_load[e->core] = std::max(0.0f, 100.0f - e->cpu_pct);
+    }
+    xSemaphoreGive(lock);
+    std::sort(out->tasks, out->tasks + n,
+              [](const task_stats_entry_t &a, const task_stats_entry_t &b) { return a.cpu_pct > b.cpu_pct; });
+    return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Uso de CPU e de pilha por tarefa, pelas estatísticas de tempo de execução
+// do FreeRTOS (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS): uma tarefa de baixa
+// prioridade guarda um retrato por segundo e o relatório compara o estado
+// atual com o retrato mais antigo da janela pedida.
+#define TASK_STATS_MAX_TASKS 24
+#define TASK_STATS_WINDOW 10 // Retratos guardados (janela máxima em segundos)
+#define TASK_STATS_STACK_WARN 512 // Pilha livre mínima (bytes) que gera aviso no log
+
+typedef struct {
+    char name[16];
+    int core;                 // Afinidade: 0, 1 ou -1 (qualquer núcleo)
+    unsigned priority;
+    float cpu_pct;            // % de um núcleo na janela
+    uint32_t stack_free_min;  // Menor pilha livre desde a criação (bytes)
+} task_stats_entry_t;
+
+typedef struct {
+    uint32_t window_ms;
+    float core_load[2];       // 100 - % da tarefa IDLE de cada núcleo
+    int n_tasks;
+    task_stats_entry_t tasks[TASK_STATS_MAX_TASKS]; // Da mais para a menos ocupada
+} task_stats_report_t;
+
+// Cria a tarefa amostradora (prioridade 1)
+void task_stats_start(void);
+
+// Janela de window_s segundos (limitada ao que já foi amostrado); false
+// antes do primeiro retrato
+bool task_stats_report(uint32_t window_s, task_stats_report_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,200 @@
+#include "trace.h"
+#include <atomic>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "TRACE";
+
+volatile bool trace_on = false;
+
+// seq = índice global + 1 depois de escrito; 0 = posição sendo escrita.
+// O leitor confere seq antes e depois da cópia (seqlock) e descarta o que
+// mudou no meio.
+typedef struct {
+    int64_t ts_us;
+    const char *task; // Nome no TCB: as tarefas do firmware nunca terminam
+    uint32_t seq;
+    uint8_t ev;
+    char phase;
+    uint8_t core;
+} trace_entry_t;
+
+// Os contadores ficam na RAM interna (o S32C1I do ESP32 não opera na PSRAM);
+// as entradas só recebem leituras/escritas simples de 32 bits
+typedef struct {
+    std::atomic<uint32_t> head;
+    trace_entry_t *entries;
+} trace_ring_t;
+
+static trace_ring_t rings[portNUM_PROCESSORS];
+
+static const char *const EVENT_NAMES[TRACE_EVENT_COUNT] = {
+    "capture", "frame_grab", "decode", "preprocess", "invoke", "send",
+};
+
+void trace_set_enabled(bool enabled) {
+    if (enabled) {
+        for (int c = 0; c < portNUM_PROCESSORS; c++) {
+            if (rings[c].entries) continue;
+            size_t bytes = TRACE_RING_SIZE * sizeof(trace_entry_t);
+            trace_entry_t *e = (trace_entry_t *)heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM);
+            if (!e) e = (trace_entry_t *)heap_caps_calloc(1, bytes, MALLOC_CAP_INTERNAL);
+            if (!e) {
+                ESP_LOGE(TAG, "Sem memoria para o trace");
+                return;
+            }
+            rings[c].entries = e; // Nunca liberado: gravações em voo ainda podem usá-lo
+        }
+    }
+    trace_on = enabled;
+    ESP_LOGI(TAG, "Trace %s", enabled ? "ligado" : "desligado");
+}
+
+void trace_clear(void) {
+    for (int c = 0; c < portNUM_PROCESSORS; c++) {
+        if (!rings[c].entries) continue;
+        for (int i = 0; i < TRACE_RING_SIZE; i++) __atomic_store_n(&rings[c].entries[i].seq, 0, __ATOMIC_RELAXED);
+        rings[c].head.store(0, std::memory_order_release);
+    }
+}
+
+void trace_record(trace_event_t ev, char phase) {
+    const int core = xPortGetCoreID();
+    trace_ring_t *r = &rings[core];
+    if (!r->entries) return;
+    const uint32_t idx = r->head.fetch_add(1, std::memory_order_relaxed);
+    trace_entry_t *e = &r->entries[idx & (TRACE_RING_SIZE - 1)];
+    __atomic_store_n(&e->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    e->ts_us = esp_timer_get_time();
+    e->task = pcTaskGetName(NULL);
+    e->ev = (uint8_t)ev;
+    e->phase = phase;
+    e->core = (uint8_t)core;
+    __atomic_store_n(&e->seq, idx + 1, __ATOMIC_RELEASE);
+}
+
+// Cópia consistente das entradas ainda no anel, em ordem de reserva
+static size_t snapshot(const trace_ring_t *r, trace_entry_t *out) {
+    if (!r->entries) return 0;
+    const uint32_t head = r->head.load(std::memory_order_acquire);
+    const uint32_t first = head > TRACE_RING_SIZE ? head - TRACE_RING_SIZE : 0;
+    size_t n = 0;
+    for (uint32_t idx = first; idx != head; idx++) {
+        const trace_entry_t *e = &r->entries[idx & (TRACE_RING_SIZE - 1)];
+        const uint32_t s1 = __atomic_load_n(&e->seq, __ATOMIC_ACQUIRE);
+        if (s1 != idx + 1) continue; // Ainda sendo escrita ou já sobrescrita
+        out[n] = *e;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&e->seq, __ATOMIC_RELAXED) == s1) n++;
+    }
+    return n;
+}
+
+namespace {
+
+// Junta o JSON em blocos antes de mandar (cada chunk HTTP tem custo fixo).
+// O bloco fica no heap, junto da cópia dos anéis: na pilha de 4 KB do httpd
+// só sobra esta struct
+struct JsonOut {
+    trace_write_fn write;
+    void *ctx;
+    char *buf;
+    size_t cap, len;
+    bool ok;
+
+    void flush() {
+        if (ok && len) ok = write(ctx, buf, len);
+        len = 0;
+    }
+    // Formata direto no bloco; se não couber, esvazia e formata de novo
+    void printf_(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        for (int attempt = 0; attempt < 2; attempt++) {
+            va_list ap;
+            va_start(ap, fmt);
+            int n = vsnprintf(buf + len, cap - len, fmt, ap);
+            va_end(ap);
+            if (n < 0) return;
+            if (len + n < cap) {
+                len += n;
+                return;
+            }
+            if (len == 0) { // Maior que o bloco inteiro: vai truncado
+                len = cap - 1;
+                return;
+            }
+            flush();
+        }
+    }
+};
+
+} // namespace
+
+#define TRACE_JSON_BUF 1024
+
+int trace_write_json(trace_write_fn write, void *ctx) {
+    const size_t cap = (size_t)portNUM_PROCESSORS * TRACE_RING_SIZE;
+    const size_t bytes = cap * sizeof(trace_entry_t) + TRACE_JSON_BUF;
+    trace_entry_t *all = (trace_entry_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (!all) all = (trace_entry_t *)heap_caps_malloc(bytes, MALLOC_CAP_INTERNAL);
+    if (!all) return -1;
+    // Cada anel vira uma sequência já em ordem; a saída intercala as
+    // sequências pelo menor timestamp, sem ordenar nem copiar de novo (em
+    // empates fica a do núcleo menor, e dentro do anel B antes de E)
+    trace_entry_t *seq[portNUM_PROCESSORS];
+    size_t left[portNUM_PROCESSORS];
+    size_t n = 0;
+    for (int c = 0; c < portNUM_PROCESSORS; c++) {
+        seq[c] = all + n;
+        left[c] = snapshot(&rings[c], seq[c]);
+        n += left[c];
+    }
+
+    // Uma trilha (tid) por tarefa; um E cujo B já saiu do anel é descartado
+    const int kMaxTasks = 16;
+    const char *tasks[kMaxTasks];
+    int depth[kMaxTasks] = {};
+    int n_tasks = 0;
+
+    JsonOut out = {write, ctx, (char *)(all + cap), TRACE_JSON_BUF, 0, true};
+    out.printf_("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    out.printf_("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ESP32-CAM\"}}");
+    int written = 0;
+    for (size_t i = 0; i < n; i++) {
+        int c = -1;
+        for (int k = 0; k < portNUM_PROCESSORS; k++) {
+            if (left[k] && (c < 0 || seq[k]->ts_us < seq[c]->ts_us)) c = k;
+        }
+        const trace_entry_t &e = *seq[c]++;
+        left[c]--;
+        int tid = 0;
+        while (tid < n_tasks && tasks[tid] != e.task) tid++;
+        if (tid == n_tasks) {
+            if (n_tasks == kMaxTasks) continue;
+            tasks[n_tasks++] = e.task;
+            out.printf_(",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                        tid + 1, e.task ? e.task : "?");
+        }
+        if (e.phase == 'E') {
+            if (depth[tid] == 0) continue;
+            depth[tid]--;
+        } else {
+            depth[tid]++;
+        }
+        out.printf_(",{\"name\":\"%s\",\"cat\":\"fire\",\"ph\":\"%c\",\"ts\":%lld,\"pid\":1,\"tid\":%d,"
+                    "\"args\":{\"core\":%u}}",
+                    e.ev < TRACE_EVENT_COUNT ? EVENT_NAMES[e.ev] : "?", e.phase, (long long)e.ts_us, tid + 1,
+                    (unsigned)e.core);
+        written++;
+    }
+    out.printf_("]}\n");
+    out.flush();
+    heap_caps_free(all);
+    return out.ok ? written : -1;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Linha do tempo do pipeline: eventos de início/fim gravados num anel por
+// núcleo (sem trava: cada escritor reserva a posição com um incremento
+// atômico) e exportados como JSON do Chrome trace (abre no Perfetto ou em
+// chrome://tracing). Com FIRE_TRACE 0 as macros somem; com 1 e o trace
+// desligado em tempo de execução, custam uma leitura e um desvio.
+#ifndef FIRE_TRACE
+#define FIRE_TRACE 1
+#endif
+
+#define TRACE_RING_SIZE 1024 // Eventos por núcleo (potência de 2)
+
+typedef enum {
+    TRACE_CAPTURE = 0, // Handler do /capture inteiro
+    TRACE_FRAME_GRAB,  // esp_camera_fb_get (espera pelo DMA da câmera)
+    TRACE_DECODE,      // JPEG -> RGB888
+    TRACE_PREPROCESS,  // Recorte + resize + gamma (+ normalização da entrada)
+    TRACE_INVOKE,      // Invoke do TFLite Micro
+    TRACE_SEND,        // httpd_resp_send do JPEG
+    TRACE_EVENT_COUNT
+} trace_event_t;
+
+extern volatile bool trace_on;
+
+// Liga/desliga a gravação; os anéis são alocados (PSRAM) na primeira vez
+void trace_set_enabled(bool enabled);
+void trace_clear(void);
+void trace_record(trace_event_t ev, char phase);
+
+#if FIRE_TRACE
+#define TRACE_BEGIN(ev) do { if (trace_on) trace_record((ev), 'B'); } while (0)
+#define TRACE_END(ev) do { if (trace_on) trace_record((ev), 'E'); } while (0)
+#else
+#define TRACE_BEGIN(ev) do {} while (0)
+#define TRACE_END(ev) do {} while (0)
+#endif
+
+// Escreve o conteúdo atual dos anéis como {"traceEvents":[...]}, em pedaços
+// pela função dada (ex.: httpd_resp_send_chunk). Devolve o número de
+// eventos ou -1 se a escrita falhou.
+typedef bool (*trace_write_fn)(void *ctx, const char *buf, size_t len);
+int trace_write_json(trace_write_fn write, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
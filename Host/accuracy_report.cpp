@@ -0,0 +1,256 @@
+// Guarda de acurácia para mudanças de desempenho: pontua um split rotulado
+// (fogo = alguma caixa que o train/process_dataset.py recortaria) e reporta
+// precisão, recall, varredura de limiares com a curva ROC e a latência por
+// imagem (decode + pré-processamento + Invoke). Dois motores:
+//   firmware  classifier_predict_q do Firmware/main na simulação (Host/sim),
+//             com os frames na resolução do sensor, como a câmera entregaria
+//   host      fire::Classifier (mesmo pré-processamento, kernels de --kernels)
+// --save grava os scores por imagem; --baseline compara com um arquivo salvo
+// e sai com código 1 se alguma decisão mudar (mais que --max-flips) ou se a
+// AUC cair mais que --max-auc-drop.
+//
+// Uso: accuracy_report [--engine firmware|host] [--split test] [--data DIR]
+//                      [--model ARQ] [--kernels ref|avx2|vnni] [--threshold 0.60]
+//                      [--gamma 12] [--save ARQ] [--baseline ARQ] [--max-flips 0]
+//                      [--max-auc-drop 0.005]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+#include "infer/fire_infer.h"
+#include "classifier.h"
+#include "dataset.h"
+#include "score_quant.h"
+#include "sim/sim.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Sample {
+    std::string name;
+    bool fire;
+    float score;
+    double ms;
+};
+
+struct Counts {
+    int tp = 0, fp = 0, tn = 0, fn = 0;
+};
+
+static Counts count_at(const std::vector<Sample> &samples, float threshold) {
+    Counts c;
+    for (const Sample &s : samples) {
+        bool pred = s.score > threshold;
+        if (s.fire) pred ? c.tp++ : c.fn++;
+        else pred ? c.fp++ : c.tn++;
+    }
+    return c;
+}
+
+static double ratio(int a, int b) { return b ? (double)a / b : 0.0; }
+
+// AUC pela estatística de Mann-Whitney (empates contam meio)
+static double roc_auc(const std::vector<Sample> &samples) {
+    std::vector<const Sample *> sorted;
+    for (const Sample &s : samples) sorted.push_back(&s);
+    std::sort(sorted.begin(), sorted.end(), [](const Sample *a, const Sample *b) { return a->score < b->score; });
+    double rank_sum = 0.0;
+    int pos = 0;
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        while (j < sorted.size() && sorted[j]->score == sorted[i]->score) j++;
+        const double avg_rank = (i + 1 + j) / 2.0; // Postos i+1..j
+        for (size_t k = i; k < j; k++) {
+            if (sorted[k]->fire) {
+                rank_sum += avg_rank;
+                pos++;
+            }
+        }
+        i = j;
+    }
+    const int neg = (int)samples.size() - pos;
+    if (!pos || !neg) return 0.0;
+    return (rank_sum - pos * (pos + 1) / 2.0) / ((double)pos * neg);
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)std::ceil(p * v.size()) - 1;
+    return v[std::min(i, v.size() - 1)];
+}
+
+static bool load_baseline(const std::string &path, std::map<std::string, float> &out) {
+    FILE *f = fopen(path.c_str(), "r");
+    if (!f) return false;
+    char name[1024];
+    float score;
+    while (fscanf(f, "%1023s %f", name, &score) == 2) out[name] = score;
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::string engine = "firmware", data_dir = FIRE_DATA_DIR, split = "test", model_path = FIRE_MODEL_PATH;
+    std::string save_path, baseline_path;
+    float threshold = 0.60f, gamma = 12.0f, max_auc_drop = 0.005f;
+    int max_flips = 0;
+    fire::KernelIsa isa = fire::kIsaAuto;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--engine" && has_val) engine = argv[++i];
+        else if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--model" && has_val) model_path = argv[++i];
+        else if (a == "--threshold" && has_val) threshold = strtof(argv[++i], nullptr);
+        else if (a == "--gamma" && has_val) gamma = strtof(argv[++i], nullptr);
+        else if (a == "--save" && has_val) save_path = argv[++i];
+        else if (a == "--baseline" && has_val) baseline_path = argv[++i];
+        else if (a == "--max-flips" && has_val) max_flips = atoi(argv[++i]);
+        else if (a == "--max-auc-drop" && has_val) max_auc_drop = strtof(argv[++i], nullptr);
+        else if (a == "--kernels" && has_val) {
+            isa = fire::parse_kernel_isa(argv[++i]);
+            if (isa == fire::kIsaAuto) {
+                fprintf(stderr, "Kernels desconhecidos: %s (ref, avx2, vnni)\n", argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+    if (engine != "firmware" && engine != "host") {
+        fprintf(stderr, "Motor desconhecido: %s (firmware, host)\n", engine.c_str());
+        return 2;
+    }
+
+    std::vector<DatasetImage> images = dataset_list(data_dir, split);
+    if (images.empty()) {
+        fprintf(stderr, "Nenhuma imagem em %s/%s/images\n", data_dir.c_str(), split.c_str());
+        return 1;
+    }
+
+    // Rótulos: a caixa é medida na imagem original e imagens sem rótulo ficam
+    // de fora, como no process_dataset.py
+    std::vector<Sample> samples;
+    std::vector<uint8_t> rgb, jpg;
+    for (const DatasetImage &img : images) {
+        int w, h;
+        if (!jpeg_decode_file(img.image_path, rgb, w, h)) continue;
+        bool fire;
+        if (!dataset_label(img, w, h, fire)) continue;
+        samples.push_back({img.image_path, fire, 0.0f, 0.0});
+    }
+
+    std::string err;
+    if (engine == "host") {
+        std::shared_ptr<const fire::TfliteModel> model = fire::TfliteModel::load(model_path, &err);
+        fire::InterpreterOptions options;
+        options.isa = isa;
+        std::unique_ptr<fire::Classifier> classifier;
+        if (model) classifier = fire::Classifier::create(model, 1, gamma, &err, options);
+        if (!classifier) {
+            fprintf(stderr, "Falha ao carregar %s: %s\n", model_path.c_str(), err.c_str());
+            return 1;
+        }
+        printf("motor=host modelo=%s kernels=%s\n", model_path.c_str(),
+               fire::kernel_isa_name(classifier->interpreter().isa()));
+        for (Sample &s : samples) {
+            if (!read_file(s.name, jpg)) return 1;
+            Clock::time_point t0 = Clock::now();
+            if (!classifier->predict(jpg.data(), jpg.size(), &s.score)) s.score = 0.0f;
+            s.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        }
+    } else {
+        // Frames como o sensor entrega (QVGA, qualidade 12) e o modelo embutido
+        std::vector<std::string> paths;
+        for (const Sample &s : samples) paths.push_back(s.name);
+        if (!sim_camera_load_images(paths, 320, 240, 12, &err)) {
+            fprintf(stderr, "%s\n", err.c_str());
+            return 1;
+        }
+        classifier_init(gamma);
+        score_quant_t sq;
+        classifier_get_output_quant(&sq);
+        printf("motor=firmware (modelo embutido em fire_model.h, frames 320x240, %s)\n", SIM_TFLM_BACKEND);
+        for (size_t i = 0; i < samples.size(); i++) {
+            sim_camera_frame(i, jpg);
+            Clock::time_point t0 = Clock::now();
+            int32_t q = classifier_predict_q(jpg.data(), jpg.size());
+            samples[i].ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+            samples[i].score = score_quant_to_float(&sq, q);
+        }
+    }
+
+    const Counts c = count_at(samples, threshold);
+    const double auc = roc_auc(samples);
+    printf("split=%s imagens=%zu (fogo %d, sem fogo %d) limiar=%.2f\n", split.c_str(), samples.size(), c.tp + c.fn,
+           c.tn + c.fp, threshold);
+    printf("precisao %.1f%%  recall %.1f%%  F1 %.3f  acuracia %.1f%%  (TP %d FP %d TN %d FN %d)  AUC %.4f\n",
+           100 * ratio(c.tp, c.tp + c.fp), 100 * ratio(c.tp, c.tp + c.fn),
+           ratio(2 * c.tp, 2 * c.tp + c.fp + c.fn), 100 * ratio(c.tp + c.tn, (int)samples.size()), c.tp, c.fp,
+           c.tn, c.fn, auc);
+
+    printf("Varredura (ROC):\n  limiar  TPR(recall)  FPR     precisao\n");
+    for (int t = 5; t <= 95; t += 5) {
+        const Counts k = count_at(samples, t / 100.0f);
+        printf("  %.2f    %5.1f%%       %5.1f%%  %5.1f%%\n", t / 100.0f, 100 * ratio(k.tp, k.tp + k.fn),
+               100 * ratio(k.fp, k.fp + k.tn), 100 * ratio(k.tp, k.tp + k.fp));
+    }
+
+    std::vector<double> ms;
+    for (const Sample &s : samples) ms.push_back(s.ms);
+    printf("Latencia por imagem: p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms\n", percentile(ms, 0.50),
+           percentile(ms, 0.95), percentile(ms, 0.99), percentile(ms, 1.0));
+
+    if (!save_path.empty()) {
+        FILE *f = fopen(save_path.c_str(), "w");
+        if (!f) {
+            fprintf(stderr, "Falha ao gravar %s\n", save_path.c_str());
+            return 1;
+        }
+        for (const Sample &s : samples) fprintf(f, "%s %.6f\n", s.name.c_str(), s.score);
+        fclose(f);
+    }
+
+    if (baseline_path.empty()) return 0;
+    std::map<std::string, float> base;
+    if (!load_baseline(baseline_path, base)) {
+        fprintf(stderr, "Falha ao ler %s\n", baseline_path.c_str());
+        return 1;
+    }
+    std::vector<Sample> base_samples;
+    int flips = 0, missing = 0;
+    double max_delta = 0.0;
+    for (const Sample &s : samples) {
+        auto it = base.find(s.name);
+        if (it == base.end()) {
+            missing++;
+            continue;
+        }
+        base_samples.push_back({s.name, s.fire, it->second, 0.0});
+        max_delta = std::max(max_delta, (double)std::fabs(s.score - it->second));
+        if ((s.score > threshold) != (it->second > threshold)) {
+            flips++;
+            printf("  decisao mudou: %s (%.3f -> %.3f)\n", s.name.c_str(), it->second, s.score);
+        }
+    }
+    const double base_auc = roc_auc(base_samples);
+    printf("Referencia %s: %d decisoes mudaram, maior |delta| %.4f, AUC %.4f -> %.4f, %d imagens sem referencia\n",
+           baseline_path.c_str(), flips, max_delta, base_auc, auc, missing);
+    if (flips > max_flips || base_auc - auc > max_auc_drop || missing) {
+        printf("FALHA: a mudanca alterou a deteccao\n");
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
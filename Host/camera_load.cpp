@@ -0,0 +1,410 @@
+// Gerador de carga para o servidor HTTP da câmera (dispositivo ou
+// firmware_sim): N visualizadores, cada um com uma conexão por endpoint
+// consultada na própria taxa, como a UI do Qt (GET /status e /capture a
+// cada 100 ms, em conexões separadas). Endpoints de streaming
+// (multipart/x-mixed-replace) ficam com a conexão aberta e contam as partes.
+//
+// A latência conta a partir do instante agendado de cada requisição (sem
+// coordinated omission). Uma requisição com mais de um intervalo de atraso
+// não é enviada e conta como perdida, e só contam como ok as respostas que
+// chegam dentro da duração: um servidor lento aparece como taxa obtida
+// abaixo da pedida, não como rajada de atrasadas. Falhas separadas por
+// tipo: conexão recusada ou fechada pelo httpd (max_open_sockets esgotado),
+// E/S (timeout, conexão caiu no meio) e status HTTP fora de 2xx.
+//
+// Com --ramp, roda 1..--viewers visualizadores em sequência e aponta o
+// maior número que a câmera sustenta: sem falhas, cada endpoint com ao
+// menos 95% da taxa pedida e p99 dentro de --max-p99-ms (se dado).
+// Código de saída 1 se houve falha (ou p99 acima do limite); com --ramp, se
+// nem 1 visualizador foi sustentado.
+//
+// Uso: camera_load --http HOST:PORTA [--viewers 1] [--poll /status:10,/capture:10]
+//                  [--stream CAMINHO] [--duration 10] [--timeout-ms 5000]
+//                  [--close] [--ramp] [--max-p99-ms MS]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "net_util.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Endpoint {
+    std::string path;
+    double hz = 0.0; // 0 = malha fechada
+    bool stream = false;
+};
+
+struct Options {
+    std::string host;
+    int port = 0;
+    std::vector<Endpoint> endpoints;
+    double duration = 10.0;
+    int timeout_ms = 5000;
+    bool keep_alive = true;
+};
+
+// Resultado de uma conexão (uma thread); somado por endpoint no fim
+struct ConnStats {
+    std::vector<uint32_t> latencies_us; // Polling: requisição; stream: intervalo entre partes
+    long ok = 0, conn_fail = 0, io_fail = 0, http_fail = 0;
+    long missed = 0; // Polling: horários pulados (atraso > intervalo) ou resposta após o fim
+    uint64_t bytes = 0;
+    std::vector<uint32_t> first_frame_us; // Stream: da requisição à primeira parte
+};
+
+static double to_s(Clock::duration d) { return std::chrono::duration<double>(d).count(); }
+
+static uint32_t us_between(Clock::time_point a, Clock::time_point b) {
+    return (uint32_t)std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(b - a).count());
+}
+
+static int open_connection(const Options &o) {
+    int fd = net_connect_tcp(o.host, o.port);
+    if (fd < 0) return -1;
+    // Sem resposta em timeout_ms = falha de E/S (o httpd do ESP32 usa 5 s)
+    timeval tv = {o.timeout_ms / 1000, (o.timeout_ms % 1000) * 1000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+static std::string request_for(const Options &o, const std::string &path, bool keep_alive) {
+    return "GET " + path + " HTTP/1.1\r\nHost: " + o.host + "\r\n" + (keep_alive ? "" : "Connection: close\r\n") +
+           "\r\n";
+}
+
+static int status_of(const HttpMessage &resp) {
+    size_t sp = resp.start_line.find(' ');
+    return sp == std::string::npos ? 0 : atoi(resp.start_line.c_str() + sp + 1);
+}
+
+// Uma conexão consultando o endpoint na taxa pedida, defasada de `offset`
+// para que os visualizadores não disparem juntos
+static void poll_loop(const Options &o, const Endpoint &ep, Clock::time_point start, Clock::duration offset,
+                      Clock::time_point end, ConnStats *out) {
+    const Clock::duration interval =
+        ep.hz > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / ep.hz))
+                  : Clock::duration::zero();
+    const std::string req = request_for(o, ep.path, o.keep_alive);
+    std::string pending;
+    int fd = -1;
+    bool fresh = false; // Conexão ainda sem nenhuma resposta
+    Clock::time_point scheduled = start + offset;
+    while (true) {
+        if (ep.hz > 0) {
+            std::this_thread::sleep_until(scheduled);
+            // Atrasado mais de um intervalo: esse horário já passou
+            for (Clock::time_point now = Clock::now(); now > scheduled + interval && scheduled < end;
+                 scheduled += interval)
+                out->missed++;
+        } else {
+            scheduled = Clock::now();
+        }
+        if (scheduled >= end) break;
+        scheduled += interval;
+
+        const Clock::time_point sent = ep.hz > 0 ? scheduled - interval : scheduled;
+        if (fd < 0) {
+            if ((fd = open_connection(o)) < 0) {
+                out->conn_fail++;
+                continue;
+            }
+            fresh = true;
+        }
+        HttpMessage resp;
+        if (!net_write_all(fd, req.data(), req.size()) || !http_read(fd, pending, &resp, 4u << 20)) {
+            // Conexão nova fechada sem resposta: o httpd recusou
+            (fresh ? out->conn_fail : out->io_fail)++;
+            close(fd);
+            fd = -1;
+            pending.clear();
+            continue;
+        }
+        fresh = false;
+        const int status = status_of(resp);
+        const Clock::time_point done = Clock::now();
+        if (status >= 200 && status < 300) {
+            // Fora da janela não entra na taxa, mas a latência vale
+            (done <= end ? out->ok : out->missed)++;
+            out->bytes += resp.body.size();
+            out->latencies_us.push_back(us_between(sent, done));
+        } else {
+            out->http_fail++;
+        }
+        auto conn = resp.headers.find("connection");
+        if (!o.keep_alive || (conn != resp.headers.end() && conn->second == "close")) {
+            close(fd);
+            fd = -1;
+            pending.clear();
+        }
+    }
+    if (fd >= 0) close(fd);
+}
+
+// Stream multipart: conta as partes pelo delimitador no fluxo cru (os
+// cabeçalhos dos pedaços do chunked não formam "--boundary"), reconectando
+// se a conexão cair
+static void stream_loop(const Options &o, const Endpoint &ep, Clock::time_point end, ConnStats *out) {
+    const std::string req = request_for(o, ep.path, true);
+    while (Clock::now() < end) {
+        const Clock::time_point t0 = Clock::now();
+        int fd = open_connection(o);
+        if (fd < 0) {
+            out->conn_fail++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        std::string pending;
+        HttpMessage resp;
+        if (!net_write_all(fd, req.data(), req.size()) || !http_read(fd, pending, &resp, 4u << 20)) {
+            out->conn_fail++;
+            close(fd);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        const std::string type = resp.headers.count("content-type") ? resp.headers["content-type"] : "";
+        const size_t b = type.find("boundary=");
+        if (status_of(resp) / 100 != 2 || b == std::string::npos) {
+            out->http_fail++;
+            close(fd);
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+        std::string boundary = type.substr(b + 9);
+        if (boundary.size() >= 2 && boundary.front() == '"') boundary = boundary.substr(1, boundary.size() - 2);
+        const std::string marker = "--" + boundary;
+
+        // `window` guarda só o final do que já foi lido, para achar o
+        // delimitador partido entre duas leituras
+        std::string window = pending;
+        Clock::time_point last = t0;
+        bool first = true;
+        while (Clock::now() < end) {
+            size_t pos;
+            while ((pos = window.find(marker)) != std::string::npos) {
+                const Clock::time_point now = Clock::now();
+                // O primeiro delimitador abre a primeira parte; cada um dos
+                // seguintes fecha um frame
+                if (first) {
+                    first = false;
+                    out->first_frame_us.push_back(us_between(t0, now));
+                } else {
+                    out->ok++;
+                    out->latencies_us.push_back(us_between(last, now));
+                }
+                last = now;
+                window.erase(0, pos + marker.size());
+            }
+            if (window.size() > marker.size()) window.erase(0, window.size() - marker.size());
+
+            pollfd p = {fd, POLLIN, 0};
+            const int wait_ms = (int)std::min<int64_t>(
+                100, std::chrono::duration_cast<std::chrono::milliseconds>(end - Clock::now()).count() + 1);
+            int r = poll(&p, 1, wait_ms);
+            if (r == 0) {
+                if (us_between(last, Clock::now()) > (uint32_t)o.timeout_ms * 1000u) {
+                    out->io_fail++;
+                    break;
+                }
+                continue;
+            }
+            char buf[16384];
+            ssize_t n = r > 0 ? read(fd, buf, sizeof(buf)) : -1;
+            if (n <= 0) {
+                out->io_fail++;
+                break;
+            }
+            out->bytes += (uint64_t)n;
+            window.append(buf, (size_t)n);
+        }
+        close(fd);
+    }
+}
+
+struct EndpointReport {
+    double target_hz = 0.0, achieved_hz = 0.0; // Por visualizador
+    long fails = 0;
+    double p99_ms = 0.0;
+};
+
+static double pct_ms(const std::vector<uint32_t> &sorted, double p) {
+    return sorted.empty() ? 0.0 : sorted[(size_t)(p / 100.0 * (sorted.size() - 1) + 0.5)] / 1000.0;
+}
+
+// Uma rodada com `viewers` visualizadores; imprime a tabela por endpoint
+static std::vector<EndpointReport> run(const Options &o, int viewers) {
+    const size_t n_ep = o.endpoints.size();
+    std::vector<ConnStats> stats(viewers * n_ep);
+    std::vector<std::thread> threads;
+    const Clock::time_point start = Clock::now() + std::chrono::milliseconds(50);
+    const Clock::time_point end =
+        start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(o.duration));
+    for (int v = 0; v < viewers; v++) {
+        for (size_t e = 0; e < n_ep; e++) {
+            const Endpoint &ep = o.endpoints[e];
+            ConnStats *out = &stats[v * n_ep + e];
+            if (ep.stream) {
+                threads.emplace_back(stream_loop, std::cref(o), std::cref(ep), end, out);
+            } else {
+                const double period = ep.hz > 0 ? 1.0 / ep.hz : 0.0;
+                const Clock::duration offset = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(period * v / viewers));
+                threads.emplace_back(poll_loop, std::cref(o), std::cref(ep), start, offset, end, out);
+            }
+        }
+    }
+    for (std::thread &t : threads) t.join();
+    // Taxas sobre a janela de agendamento: só contam as respostas dentro dela
+    const double secs = std::max(1e-3, o.duration);
+    const double elapsed = to_s(Clock::now() - start);
+
+    printf("%d visualizador(es), %.1f s (ultima resposta em %.1f s)%s\n", viewers, secs, elapsed,
+           o.keep_alive ? "" : " (sem keep-alive)");
+    printf("  %-20s %7s %9s %7s %6s %6s %6s %6s %9s %8s %8s %8s %8s\n", "endpoint", "alvo/s", "obtido/s", "ok",
+           "perd.", "f.con", "f.e/s", "f.http", "KB/s", "p50 ms", "p95 ms", "p99 ms", "max ms");
+    std::vector<EndpointReport> reports(n_ep);
+    for (size_t e = 0; e < n_ep; e++) {
+        const Endpoint &ep = o.endpoints[e];
+        ConnStats sum;
+        for (int v = 0; v < viewers; v++) {
+            const ConnStats &s = stats[v * n_ep + e];
+            sum.latencies_us.insert(sum.latencies_us.end(), s.latencies_us.begin(), s.latencies_us.end());
+            sum.first_frame_us.insert(sum.first_frame_us.end(), s.first_frame_us.begin(), s.first_frame_us.end());
+            sum.ok += s.ok;
+            sum.conn_fail += s.conn_fail;
+            sum.io_fail += s.io_fail;
+            sum.http_fail += s.http_fail;
+            sum.missed += s.missed;
+            sum.bytes += s.bytes;
+        }
+        std::sort(sum.latencies_us.begin(), sum.latencies_us.end());
+        EndpointReport &r = reports[e];
+        r.target_hz = ep.hz;
+        r.achieved_hz = sum.ok / secs / viewers;
+        r.fails = sum.conn_fail + sum.io_fail + sum.http_fail;
+        r.p99_ms = pct_ms(sum.latencies_us, 99);
+        const std::string name = ep.stream ? ep.path + " (stream)" : ep.path;
+        char target[16];
+        if (ep.hz > 0) snprintf(target, sizeof(target), "%.1f", ep.hz);
+        else snprintf(target, sizeof(target), "%s", ep.stream ? "-" : "max");
+        printf("  %-20s %7s %9.1f %7ld %6ld %6ld %6ld %6ld %9.1f %8.2f %8.2f %8.2f %8.2f\n", name.c_str(), target,
+               r.achieved_hz, sum.ok, sum.missed, sum.conn_fail, sum.io_fail, sum.http_fail, sum.bytes / 1024.0 / secs,
+               pct_ms(sum.latencies_us, 50), pct_ms(sum.latencies_us, 95), r.p99_ms,
+               sum.latencies_us.empty() ? 0.0 : sum.latencies_us.back() / 1000.0);
+        if (ep.stream && !sum.first_frame_us.empty()) {
+            std::sort(sum.first_frame_us.begin(), sum.first_frame_us.end());
+            printf("  %-20s fps por visualizador %.1f, primeiro frame p50 %.1f ms (max %.1f ms); "
+                   "latencias = intervalo entre frames\n",
+                   "", r.achieved_hz, pct_ms(sum.first_frame_us, 50), sum.first_frame_us.back() / 1000.0);
+        }
+    }
+    printf("  taxas obtidas por visualizador; perd. = horarios pulados por atraso ou respostas apos o fim; "
+           "latencia desde o instante agendado\n");
+    return reports;
+}
+
+static bool sustained(const std::vector<EndpointReport> &reports, double max_p99_ms) {
+    for (const EndpointReport &r : reports) {
+        if (r.fails) return false;
+        if (r.target_hz > 0 && r.achieved_hz < 0.95 * r.target_hz) return false;
+        if (max_p99_ms > 0 && r.p99_ms > max_p99_ms) return false;
+    }
+    return true;
+}
+
+// "/status:10,/capture:10"; sem ":taxa" = malha fechada
+static bool parse_poll(const std::string &spec, std::vector<Endpoint> &out) {
+    for (size_t pos = 0; pos < spec.size();) {
+        size_t comma = std::min(spec.find(',', pos), spec.size());
+        std::string item = spec.substr(pos, comma - pos);
+        pos = comma + 1;
+        Endpoint ep;
+        size_t colon = item.rfind(':');
+        ep.path = item.substr(0, colon);
+        if (colon != std::string::npos) ep.hz = atof(item.c_str() + colon + 1);
+        if (ep.path.empty() || ep.path[0] != '/' || ep.hz < 0) return false;
+        out.push_back(ep);
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Options o;
+    int viewers = 1;
+    bool ramp = false;
+    double max_p99_ms = 0.0;
+    std::string poll_spec = "/status:10,/capture:10"; // O que a UI do Qt faz
+    std::vector<std::string> streams;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--http" && has_val) {
+            std::string hp = argv[++i];
+            size_t colon = hp.rfind(':');
+            o.host = colon == std::string::npos ? "127.0.0.1" : hp.substr(0, colon);
+            o.port = atoi(colon == std::string::npos ? hp.c_str() : hp.c_str() + colon + 1);
+        } else if (a == "--viewers" && has_val) viewers = std::max(1, atoi(argv[++i]));
+        else if (a == "--poll" && has_val) poll_spec = argv[++i];
+        else if (a == "--stream" && has_val) streams.push_back(argv[++i]);
+        else if (a == "--duration" && has_val) o.duration = atof(argv[++i]);
+        else if (a == "--timeout-ms" && has_val) o.timeout_ms = std::max(1, atoi(argv[++i]));
+        else if (a == "--close") o.keep_alive = false;
+        else if (a == "--ramp") ramp = true;
+        else if (a == "--max-p99-ms" && has_val) max_p99_ms = atof(argv[++i]);
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+    if (!o.port) {
+        fprintf(stderr, "Uso: camera_load --http HOST:PORTA [--viewers 1] [--poll /status:10,/capture:10] "
+                        "[--stream CAMINHO] [--duration 10] [--timeout-ms 5000] [--close] [--ramp] "
+                        "[--max-p99-ms MS]\n");
+        return 2;
+    }
+    if (!poll_spec.empty() && poll_spec != "none" && !parse_poll(poll_spec, o.endpoints)) {
+        fprintf(stderr, "--poll invalido: %s (ex.: /status:10,/capture:5)\n", poll_spec.c_str());
+        return 2;
+    }
+    for (const std::string &s : streams) o.endpoints.push_back({s, 0.0, true});
+    if (o.endpoints.empty()) {
+        fprintf(stderr, "Nenhum endpoint (--poll ou --stream)\n");
+        return 2;
+    }
+
+    std::vector<EndpointReport> reports;
+    int best = 0;
+    for (int v = ramp ? 1 : viewers; v <= viewers; v++) {
+        reports = run(o, v);
+        if (sustained(reports, max_p99_ms)) best = v;
+        else if (ramp) break; // Daqui em diante só piora
+    }
+    if (ramp) {
+        if (best) printf("A camera sustenta %d visualizador(es)\n", best);
+        else printf("A camera nao sustenta nem 1 visualizador nessas taxas\n");
+    }
+
+    // Contadores do firmware ao fim da carga (frames, inferências, gate)
+    int fd = open_connection(o);
+    std::string pending;
+    HttpMessage resp;
+    const std::string req = request_for(o, "/status", false);
+    if (fd >= 0 && net_write_all(fd, req.data(), req.size()) && http_read(fd, pending, &resp, 64 * 1024) &&
+        status_of(resp) == 200)
+        printf("status: %.*s\n", (int)resp.body.size(), (const char *)resp.body.data());
+    if (fd >= 0) close(fd);
+
+    if (ramp) return best ? 0 : 1;
+    for (const EndpointReport &r : reports)
+        if (r.fails || (max_p99_ms > 0 && r.p99_ms > max_p99_ms)) return 1;
+    return 0;
+}
@@ -0,0 +1,167 @@
+// Relatório da cascata de dois modelos sobre um split do dataset: acurácia e
+// custo médio por frame de cada modelo sozinho e da cascata (segundo modelo só
+// na faixa de incerteza do primeiro), mais uma varredura de faixas.
+//
+// Uso: cascade_report [--first ARQ] [--second ARQ] [--split test] [--data DIR]
+//                     [--band-lo 0.20] [--band-hi 0.90] [--threshold 0.60]
+//                     [--gamma 12] [--kernels ref|avx2|vnni]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "infer/cascade.h"
+#include "dataset.h"
+
+#ifndef FIRE_MODEL_DIR
+#define FIRE_MODEL_DIR "."
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+struct Sample {
+    bool fire;
+    float a, b;
+};
+
+struct Counts {
+    int tp = 0, fp = 0, tn = 0, fn = 0;
+    void add(bool truth, bool pred) {
+        if (truth) pred ? tp++ : fn++;
+        else pred ? fp++ : tn++;
+    }
+    int total() const { return tp + fp + tn + fn; }
+};
+
+static void print_row(const char *name, const Counts &c, double ms, const char *extra) {
+    printf("%-22s acc %5.1f%%  prec %5.1f%%  rec %5.1f%%  (TP %d FP %d TN %d FN %d)  %6.2f ms/frame%s\n", name,
+           c.total() ? 100.0 * (c.tp + c.tn) / c.total() : 0.0, c.tp + c.fp ? 100.0 * c.tp / (c.tp + c.fp) : 0.0,
+           c.tp + c.fn ? 100.0 * c.tp / (c.tp + c.fn) : 0.0, c.tp, c.fp, c.tn, c.fn, ms, extra);
+}
+
+static double accuracy(const Counts &c) {
+    return c.total() ? 100.0 * (c.tp + c.tn) / c.total() : 0.0;
+}
+
+static double elapsed_ms(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+int main(int argc, char **argv) {
+    fire::CascadeConfig cfg;
+    cfg.first_model = std::string(FIRE_MODEL_DIR) + "/model_fire_a35_int8.tflite";
+    cfg.second_model = std::string(FIRE_MODEL_DIR) + "/model_fire_int8.tflite";
+    std::string data_dir = FIRE_DATA_DIR, split = "test";
+    float threshold = 0.60f;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--first" && has_val) cfg.first_model = argv[++i];
+        else if (a == "--second" && has_val) cfg.second_model = argv[++i];
+        else if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--band-lo" && has_val) cfg.band_lo = strtof(argv[++i], nullptr);
+        else if (a == "--band-hi" && has_val) cfg.band_hi = strtof(argv[++i], nullptr);
+        else if (a == "--threshold" && has_val) threshold = strtof(argv[++i], nullptr);
+        else if (a == "--gamma" && has_val) cfg.gamma = strtof(argv[++i], nullptr);
+        else if (a == "--kernels" && has_val) {
+            cfg.isa = fire::parse_kernel_isa(argv[++i]);
+            if (cfg.isa == fire::kIsaAuto) {
+                fprintf(stderr, "Kernels desconhecidos: %s (ref, avx2, vnni)\n", argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+
+    std::string err;
+    std::unique_ptr<fire::Cascade> cascade = fire::Cascade::create(cfg, &err);
+    if (!cascade) {
+        fprintf(stderr, "Falha ao carregar os modelos: %s\n", err.c_str());
+        return 1;
+    }
+    std::vector<DatasetImage> images = dataset_list(data_dir, split);
+    if (images.empty()) {
+        fprintf(stderr, "Nenhuma imagem em %s/%s/images\n", data_dir.c_str(), split.c_str());
+        return 1;
+    }
+
+    // Cada modelo sozinho em todo frame, e a cascata de verdade (tempo real
+    // com a saída antecipada); o decode fica fora das medidas
+    std::vector<Sample> samples;
+    std::vector<uint8_t> rgb;
+    double ms_a = 0, ms_b = 0, ms_cascade = 0;
+    int escalated = 0;
+    Counts cascade_counts;
+    for (const DatasetImage &img : images) {
+        int w, h;
+        if (!jpeg_decode_file(img.image_path, rgb, w, h)) continue;
+        Sample s;
+        if (!dataset_label(img, w, h, s.fire)) continue;
+
+        Clock::time_point t0 = Clock::now();
+        if (!cascade->first().predict_rgb(rgb.data(), w, h, &s.a)) continue;
+        ms_a += elapsed_ms(t0);
+        t0 = Clock::now();
+        if (!cascade->second().predict_rgb(rgb.data(), w, h, &s.b)) continue;
+        ms_b += elapsed_ms(t0);
+
+        fire::CascadeResult r;
+        t0 = Clock::now();
+        if (!cascade->predict_rgb(rgb.data(), w, h, &r)) continue;
+        ms_cascade += elapsed_ms(t0);
+        escalated += r.escalated;
+        cascade_counts.add(s.fire, r.score > threshold);
+        samples.push_back(s);
+    }
+    const int n = (int)samples.size();
+    if (!n) return 1;
+
+    Counts ca, cb;
+    for (const Sample &s : samples) {
+        ca.add(s.fire, s.a > threshold);
+        cb.add(s.fire, s.b > threshold);
+    }
+
+    printf("split=%s imagens=%d limiar=%.2f kernels=%s\n", split.c_str(), n, threshold,
+           fire::kernel_isa_name(cascade->first().interpreter().isa()));
+    print_row("primeiro (sozinho)", ca, ms_a / n, "");
+    print_row("segundo (sozinho)", cb, ms_b / n, "");
+    char extra[96];
+    snprintf(extra, sizeof(extra), "  faixa [%.2f, %.2f], segundo em %.1f%%", cfg.band_lo, cfg.band_hi,
+             100.0 * escalated / n);
+    print_row("cascata", cascade_counts, ms_cascade / n, extra);
+    // Sem ganho sobre o melhor modelo sozinho, a cascata só custa o segundo Invoke
+    const double acc_best = std::max(accuracy(ca), accuracy(cb));
+    if (accuracy(cascade_counts) <= acc_best) {
+        printf("aviso: neste split a cascata (%.1f%%) nao supera o melhor modelo sozinho (%s, %.1f%%)",
+               accuracy(cascade_counts), accuracy(ca) >= accuracy(cb) ? "primeiro" : "segundo", acc_best);
+        if (accuracy(cb) < accuracy(ca))
+            printf("; na faixa ela troca o score do primeiro pelo do segundo, que acerta menos (%.1f%%)",
+                   accuracy(cb));
+        printf("\n");
+    }
+    printf("arena compartilhada %.0f KB (separadas: %.0f KB)\n", cascade->arena_bytes() / 1024.0,
+           cascade->separate_arena_bytes() / 1024.0);
+
+    // Varredura: custo estimado pelo tempo médio de cada modelo
+    printf("\nfaixa           segundo   acc     prec    rec    ms/frame (estimado)\n");
+    const float bands[][2] = {{0.40f, 0.80f}, {0.30f, 0.85f}, {0.20f, 0.90f}, {0.10f, 0.95f}, {0.05f, 0.98f}};
+    for (const auto &band : bands) {
+        Counts c;
+        int esc = 0;
+        for (const Sample &s : samples) {
+            const bool second = s.a >= band[0] && s.a <= band[1];
+            esc += second;
+            c.add(s.fire, (second ? s.b : s.a) > threshold);
+        }
+        printf("[%.2f, %.2f]    %5.1f%%   %5.1f%%  %5.1f%%  %5.1f%%  %6.2f\n", band[0], band[1], 100.0 * esc / n,
+               100.0 * (c.tp + c.tn) / n, c.tp + c.fp ? 100.0 * c.tp / (c.tp + c.fp) : 0.0,
+               c.tp + c.fn ? 100.0 * c.tp / (c.tp + c.fn) : 0.0, (ms_a + ms_b * esc / n) / n);
+    }
+    return 0;
+}
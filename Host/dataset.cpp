@@ -0,0 +1,173 @@
+#include "dataset.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <jpeglib.h>
+#include <setjmp.h>
+
+namespace fs = std::filesystem;
+
+// Mesmo valor de train/process_dataset.py
+static const int MIN_SIZE = 32;
+
+std::vector<DatasetImage> dataset_list(const std::string &root, const std::string &split) {
+    std::vector<DatasetImage> out;
+    fs::path img_dir = fs::path(root) / split / "images";
+    fs::path lbl_dir = fs::path(root) / split / "labels";
+    if (!fs::is_directory(img_dir)) return out;
+
+    for (const auto &entry : fs::directory_iterator(img_dir)) {
+        std::string ext = entry.path().extension().string();
+        if (ext != ".jpg" && ext != ".jpeg" && ext != ".png") continue;
+        DatasetImage img;
+        img.image_path = entry.path().string();
+        fs::path lbl = lbl_dir / (entry.path().stem().string() + ".txt");
+        if (fs::exists(lbl)) img.label_path = lbl.string();
+        out.push_back(img);
+    }
+    std::sort(out.begin(), out.end(),
+              [](const DatasetImage &a, const DatasetImage &b) { return a.image_path < b.image_path; });
+    return out;
+}
+
+int dataset_fire_boxes(const std::string &label_path, int img_w, int img_h, float *largest_area) {
+    if (largest_area) *largest_area = 0.0f;
+    std::ifstream f(label_path);
+    if (!f) return 0;
+
+    int count = 0;
+    std::string line;
+    while (std::getline(f, line)) {
+        std::istringstream ss(line);
+        float cls, x_c, y_c, w, h;
+        if (!(ss >> cls >> x_c >> y_c >> w >> h)) continue; // Pula linhas inválidas
+
+        // Converte para pixels (mesmo arredondamento do script Python)
+        int w_px = (int)(w * img_w), h_px = (int)(h * img_h);
+        int x_c_px = (int)(x_c * img_w), y_c_px = (int)(y_c * img_h);
+        int x1 = std::max(0, x_c_px - w_px / 2);
+        int y1 = std::max(0, y_c_px - h_px / 2);
+        int x2 = std::min(img_w, x1 + w_px);
+        int y2 = std::min(img_h, y1 + h_px);
+
+        if (x2 > x1 && y2 > y1 && w_px > MIN_SIZE && h_px > MIN_SIZE) {
+            count++;
+            if (largest_area)
+                *largest_area = std::max(*largest_area, (float)(x2 - x1) * (y2 - y1) / ((float)img_w * img_h));
+        }
+    }
+    return count;
+}
+
+bool dataset_label(const DatasetImage &img, int img_w, int img_h, bool &fire, float *largest_area) {
+    if (largest_area) *largest_area = 0.0f;
+    fire = false;
+    if (img.label_path.empty()) return false;
+    fire = dataset_fire_boxes(img.label_path, img_w, img_h, largest_area) > 0;
+    return true;
+}
+
+struct JpegError {
+    jpeg_error_mgr mgr;
+    jmp_buf jump;
+};
+
+static void jpeg_error_exit(j_common_ptr cinfo) {
+    JpegError *err = (JpegError *)cinfo->err;
+    longjmp(err->jump, 1);
+}
+
+bool jpeg_decode(const uint8_t *data, size_t len, std::vector<uint8_t> &rgb, int &w, int &h) {
+    jpeg_decompress_struct cinfo;
+    JpegError err;
+    cinfo.err = jpeg_std_error(&err.mgr);
+    err.mgr.error_exit = jpeg_error_exit;
+    if (setjmp(err.jump)) {
+        jpeg_destroy_decompress(&cinfo);
+        return false;
+    }
+
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, data, (unsigned long)len);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&cinfo);
+
+    w = (int)cinfo.output_width;
+    h = (int)cinfo.output_height;
+    rgb.resize((size_t)w * h * 3);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = rgb.data() + (size_t)cinfo.output_scanline * w * 3;
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+
+void rgb_resize_bilinear(const uint8_t *src, int sw, int sh, uint8_t *dst, int dw, int dh) {
+    for (int y = 0; y < dh; y++) {
+        float fy = std::max(0.0f, (y + 0.5f) * sh / dh - 0.5f);
+        int y0 = std::min((int)fy, sh - 1), y1 = std::min(y0 + 1, sh - 1);
+        float wy = fy - y0;
+        for (int x = 0; x < dw; x++) {
+            float fx = std::max(0.0f, (x + 0.5f) * sw / dw - 0.5f);
+            int x0 = std::min((int)fx, sw - 1), x1 = std::min(x0 + 1, sw - 1);
+            float wx = fx - x0;
+            for (int c = 0; c < 3; c++) {
+                float top = src[((size_t)y0 * sw + x0) * 3 + c] * (1 - wx) + src[((size_t)y0 * sw + x1) * 3 + c] * wx;
+                float bot = src[((size_t)y1 * sw + x0) * 3 + c] * (1 - wx) + src[((size_t)y1 * sw + x1) * 3 + c] * wx;
+                dst[((size_t)y * dw + x) * 3 + c] = (uint8_t)(top * (1 - wy) + bot * wy + 0.5f);
+            }
+        }
+    }
+}
+
+bool jpeg_encode(const uint8_t *rgb, int w, int h, int quality, std::vector<uint8_t> &out) {
+    jpeg_compress_struct cinfo;
+    JpegError err;
+    cinfo.err = jpeg_std_error(&err.mgr);
+    err.mgr.error_exit = jpeg_error_exit;
+    unsigned char *mem = nullptr;
+    unsigned long mem_len = 0;
+    if (setjmp(err.jump)) {
+        jpeg_destroy_compress(&cinfo);
+        free(mem);
+        return false;
+    }
+
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &mem, &mem_len);
+    cinfo.image_width = (JDIMENSION)w;
+    cinfo.image_height = (JDIMENSION)h;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, quality, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    while (cinfo.next_scanline < cinfo.image_height) {
+        JSAMPROW row = (JSAMPROW)(rgb + (size_t)cinfo.next_scanline * w * 3);
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    out.assign(mem, mem + mem_len);
+    free(mem);
+    return true;
+}
+
+bool read_file(const std::string &path, std::vector<uint8_t> &out) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) return false;
+    out.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool jpeg_decode_file(const std::string &path, std::vector<uint8_t> &rgb, int &w, int &h) {
+    std::vector<uint8_t> data;
+    if (!read_file(path, data)) return false;
+    return jpeg_decode(data.data(), data.size(), rgb, w, h);
+}
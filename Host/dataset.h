@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Imagem do dataset (train/fire_data/<split>/images + labels YOLO)
+struct DatasetImage {
+    std::string image_path;
+    std::string label_path; // vazio se a imagem não tem rótulo
+};
+
+// Lista as imagens de um split em ordem alfabética
+std::vector<DatasetImage> dataset_list(const std::string &root, const std::string &split);
+
+// Conta as caixas que o train/process_dataset.py exportaria como recorte de fogo
+// (largura e altura > MIN_SIZE pixels). Frame com pelo menos uma = fogo.
+// largest_area (opcional) recebe a fração do frame coberta pela maior delas.
+int dataset_fire_boxes(const std::string &label_path, int img_w, int img_h, float *largest_area = nullptr);
+
+// Verdade de campo dos relatórios, com o mesmo critério do process_dataset.py:
+// imagem sem arquivo de rótulo é pulada pelo script, então devolve false e
+// deve ficar de fora (não conta como sem fogo); senão fire = dataset_fire_boxes > 0
+bool dataset_label(const DatasetImage &img, int img_w, int img_h, bool &fire, float *largest_area = nullptr);
+
+// Decodifica JPEG para RGB888
+bool jpeg_decode(const uint8_t *data, size_t len, std::vector<uint8_t> &rgb, int &w, int &h);
+bool jpeg_decode_file(const std::string &path, std::vector<uint8_t> &rgb, int &w, int &h);
+
+// Codifica RGB888 em JPEG (qualidade 0-100)
+bool jpeg_encode(const uint8_t *rgb, int w, int h, int quality, std::vector<uint8_t> &out);
+
+// Resize bilinear RGB888 com centros de pixel deslocados de meio pixel (a
+// mesma geometria do cv2.resize INTER_LINEAR, sem antialias)
+void rgb_resize_bilinear(const uint8_t *src, int sw, int sh, uint8_t *dst, int dw, int dh);
+
+// Lê um arquivo inteiro
+bool read_file(const std::string &path, std::vector<uint8_t> &out);
@@ -0,0 +1,234 @@
+// Microbenchmarks por estágio do pipeline do classificador, com o código do
+// firmware compilado na simulação (Host/sim): decode JPEG (fmt2rgb888),
+// recorte + resize + gamma (a LUT de gamma vai no mesmo passe; a entrada do
+// modelo é uint8, então não há quantização separada), pré-filtro, miniatura
+// do gate de cena, Invoke, leitura da saída + fusão e o classifier_predict_q
+// de ponta a ponta. Cada iteração é um frame de um corpus fixo (o split de
+// teste na resolução do sensor); os contadores trazem bytes tocados e
+// alocações por frame. Para acompanhar regressões commit a commit:
+//
+//   fire_bench --benchmark_out=bench.json --benchmark_out_format=json
+//
+// O --model vale para o BM_Invoke; o BM_EndToEnd roda o classificador do
+// firmware, que embute o próprio modelo (fire_model.h), seja qual for o
+// --model.
+//
+// Uso: fire_bench [--split test] [--data DIR] [--model ARQ] [--gamma 12]
+//                 [opções do Google Benchmark]
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "infer/interpreter.h"
+#include "classifier.h"
+#include "dataset.h"
+#include "fusion.h"
+#include "img_converters.h"
+#include "preprocess.h"
+#include "scene_gate.h"
+#include "sim/sim.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+namespace {
+
+const int kSrcW = 320, kSrcH = 240; // QVGA, como o init_camera do firmware
+const size_t kRgbBytes = (size_t)kSrcW * kSrcH * 3;
+const size_t kInputBytes = DST_W * DST_H * 3;
+
+// Corpus: JPEGs como o sensor entrega, já decodificados e já pré-processados
+// (entrada de cada estágio isolado)
+struct Corpus {
+    std::vector<std::vector<uint8_t>> jpgs, rgbs, inputs;
+    uint8_t lut[256];
+    std::shared_ptr<const fire::TfliteModel> model;
+};
+Corpus g_corpus;
+
+void set_frame_counters(benchmark::State &state, uint64_t allocs0, size_t bytes_per_frame) {
+    // Antes de mexer em state.counters, que aloca
+    const uint64_t allocs = sim_heap_allocations() - allocs0;
+    const double frames = (double)state.iterations();
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed((int64_t)(frames * bytes_per_frame));
+    state.counters["bytes/frame"] = (double)bytes_per_frame;
+    state.counters["allocs/frame"] = frames ? (double)allocs / frames : 0.0;
+}
+
+void BM_Decode(benchmark::State &state) {
+    std::vector<uint8_t> rgb(kRgbBytes);
+    size_t i = 0, jpg_bytes = 0;
+    uint64_t allocs0 = sim_heap_allocations();
+    for (auto _ : state) {
+        const std::vector<uint8_t> &jpg = g_corpus.jpgs[i++ % g_corpus.jpgs.size()];
+        jpg_bytes += jpg.size();
+        benchmark::DoNotOptimize(fmt2rgb888(jpg.data(), jpg.size(), PIXFORMAT_JPEG, rgb.data()));
+    }
+    // Lê o JPEG e escreve o RGB888 inteiro
+    set_frame_counters(state, allocs0, state.iterations() ? jpg_bytes / state.iterations() + kRgbBytes : 0);
+}
+BENCHMARK(BM_Decode);
+
+// Recorte central + resize nearest + gamma, com e sem o pré-filtro no passe
+void BM_CropResizeGamma(benchmark::State &state) {
+    const bool with_prefilter = state.range(0) != 0;
+    prefilter_config_t pf;
+    prefilter_default_config(&pf);
+    pf.enabled = true;
+    std::vector<uint8_t> dst(kInputBytes);
+    size_t i = 0;
+    uint64_t allocs0 = sim_heap_allocations();
+    for (auto _ : state) {
+        const std::vector<uint8_t> &rgb = g_corpus.rgbs[i++ % g_corpus.rgbs.size()];
+        prefilter_stats_t stats = {};
+        preprocess_square_crop(rgb.data(), kSrcW, kSrcH, g_corpus.lut, dst.data(), with_prefilter ? &pf : nullptr,
+                               with_prefilter ? &stats : nullptr);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::DoNotOptimize(stats);
+    }
+    // Amostragem nearest: só os pixels fonte amostrados são lidos
+    set_frame_counters(state, allocs0, 2 * kInputBytes);
+}
+BENCHMARK(BM_CropResizeGamma)->ArgName("prefilter")->Arg(0)->Arg(1);
+
+void BM_SceneGateThumbnail(benchmark::State &state) {
+    uint8_t thumb[SCENE_THUMB_N];
+    size_t i = 0;
+    uint64_t allocs0 = sim_heap_allocations();
+    for (auto _ : state) {
+        scene_gate_thumbnail(g_corpus.inputs[i++ % g_corpus.inputs.size()].data(), thumb);
+        benchmark::DoNotOptimize(thumb);
+    }
+    set_frame_counters(state, allocs0, kInputBytes + SCENE_THUMB_N);
+}
+BENCHMARK(BM_SceneGateThumbnail);
+
+// Invoke com os kernels de referência sem fusão (o que a simulação roda no
+// lugar do TFLite Micro) e com o melhor ISA do host. Cópia da entrada inclusa.
+void BM_Invoke(benchmark::State &state) {
+    fire::InterpreterOptions options;
+    options.isa = (fire::KernelIsa)state.range(0);
+    options.fuse = options.isa != fire::kIsaReference;
+    std::string err;
+    std::unique_ptr<fire::Interpreter> interp = fire::Interpreter::create(g_corpus.model, 1, &err, options);
+    if (!interp) {
+        state.SkipWithError(err.c_str());
+        return;
+    }
+    state.SetLabel(fire::kernel_isa_name(interp->isa()));
+    // Aquecimento fora da contagem: o primeiro Invoke ainda aloca
+    memcpy(interp->input(), g_corpus.inputs[0].data(), kInputBytes);
+    if (!interp->invoke()) {
+        state.SkipWithError("invoke falhou");
+        return;
+    }
+    size_t i = 0;
+    uint64_t allocs0 = sim_heap_allocations();
+    for (auto _ : state) {
+        memcpy(interp->input(), g_corpus.inputs[i++ % g_corpus.inputs.size()].data(), kInputBytes);
+        if (!interp->invoke()) {
+            state.SkipWithError("invoke falhou");
+            return;
+        }
+        benchmark::DoNotOptimize(interp->output()[0]);
+    }
+    // Pesos lidos uma vez + cada ativação escrita e lida uma vez
+    set_frame_counters(state, allocs0, g_corpus.model->size() + 2 * interp->unplanned_bytes());
+}
+BENCHMARK(BM_Invoke)->ArgName("isa")->Arg(fire::kIsaReference)->Arg(fire::kIsaAuto)->Unit(benchmark::kMicrosecond);
+
+// Saída crua -> fusão temporal no domínio quantizado -> score em float
+void BM_Output(benchmark::State &state) {
+    score_quant_t sq = {1.0f / 255.0f, 0, 0, 255};
+    fusion_config_t cfg = {0.6f, 2, 3, 0.60f, 0.45f};
+    fusion_qconfig_t qcfg;
+    fusion_quantize_config(&cfg, &sq, &qcfg);
+    fusion_t f;
+    fusion_reset(&f);
+    uint8_t out[2] = {0, 0};
+    size_t i = 0;
+    uint64_t allocs0 = sim_heap_allocations();
+    for (auto _ : state) {
+        out[1] = g_corpus.inputs[i++ % g_corpus.inputs.size()][0]; // Saída variando entre frames
+        benchmark::DoNotOptimize(out);
+        int32_t q8 = fusion_update_q(&f, &qcfg, out[1]);
+        benchmark::DoNotOptimize(score_quant_to_float(&sq, q8 >> 8));
+    }
+    set_frame_counters(state, allocs0, sizeof(out));
+}
+BENCHMARK(BM_Output);
+
+// classifier_predict_q do firmware: decode + recorte + Invoke (pela API do
+// TFLite Micro da simulação) + saída, com gate e pré-filtro desligados.
+// Modelo embutido no firmware (fire_model.h), não o do --model.
+void BM_EndToEnd(benchmark::State &state) {
+    state.SetLabel("fire_model.h");
+    // Aquecimento fora da contagem, como no BM_Invoke
+    benchmark::DoNotOptimize(classifier_predict_q(g_corpus.jpgs[0].data(), g_corpus.jpgs[0].size()));
+    size_t i = 0, jpg_bytes = 0;
+    uint64_t allocs0 = sim_heap_allocations();
+    for (auto _ : state) {
+        std::vector<uint8_t> &jpg = g_corpus.jpgs[i++ % g_corpus.jpgs.size()];
+        jpg_bytes += jpg.size();
+        benchmark::DoNotOptimize(classifier_predict_q(jpg.data(), jpg.size()));
+    }
+    // Só o JPEG de entrada: o tráfego interno é a soma dos estágios acima
+    set_frame_counters(state, allocs0, state.iterations() ? jpg_bytes / state.iterations() : 0);
+}
+BENCHMARK(BM_EndToEnd)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    std::string data_dir = FIRE_DATA_DIR, split = "test", model_path = FIRE_MODEL_PATH;
+    float gamma = 12.0f;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--model" && has_val) model_path = argv[++i];
+        else if (a == "--gamma" && has_val) gamma = strtof(argv[++i], nullptr);
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<std::string> paths;
+    for (const DatasetImage &img : dataset_list(data_dir, split)) paths.push_back(img.image_path);
+    std::string err;
+    if (paths.empty() || !sim_camera_load_images(paths, kSrcW, kSrcH, 12, &err)) {
+        fprintf(stderr, "Sem frames em %s/%s/images %s\n", data_dir.c_str(), split.c_str(), err.c_str());
+        return 1;
+    }
+    g_corpus.model = fire::TfliteModel::load(model_path, &err);
+    if (!g_corpus.model) {
+        fprintf(stderr, "Falha ao carregar %s: %s\n", model_path.c_str(), err.c_str());
+        return 1;
+    }
+    preprocess_build_gamma_lut(gamma, g_corpus.lut);
+    for (size_t i = 0; i < sim_camera_frame_count(); i++) {
+        std::vector<uint8_t> jpg, rgb(kRgbBytes), input(kInputBytes);
+        if (!sim_camera_frame(i, jpg) || !fmt2rgb888(jpg.data(), jpg.size(), PIXFORMAT_JPEG, rgb.data())) continue;
+        preprocess_square_crop(rgb.data(), kSrcW, kSrcH, g_corpus.lut, input.data(), nullptr, nullptr);
+        g_corpus.jpgs.push_back(std::move(jpg));
+        g_corpus.rgbs.push_back(std::move(rgb));
+        g_corpus.inputs.push_back(std::move(input));
+    }
+    // O classificador do firmware embute o próprio modelo (fire_model.h)
+    classifier_init(gamma);
+
+    benchmark::AddCustomContext("corpus", split + " (" + std::to_string(g_corpus.jpgs.size()) + " frames " +
+                                              std::to_string(kSrcW) + "x" + std::to_string(kSrcH) + ")");
+    benchmark::AddCustomContext("model", model_path + " (BM_EndToEnd: fire_model.h)");
+    benchmark::AddCustomContext("tflm", SIM_TFLM_BACKEND);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
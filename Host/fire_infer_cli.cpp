@@ -0,0 +1,272 @@
+// Re-pontua frames JPEG no host com o mesmo modelo int8 do firmware.
+// Entradas: arquivos/diretórios (recursivo), lista de caminhos no stdin ("-")
+// ou um fluxo de JPEGs concatenados / MJPEG (--stream ARQ, "-" = stdin).
+// Saída: "<nome> <score>" por frame.
+// --verify roda os kernels otimizados e os de referência em cada frame e
+// compara todos os tensores intermediários byte a byte (os eliminados pela
+// fusão de blocos ficam de fora; a saída de cada bloco é comparada). Os _ref
+// são conferidos contra o TFLite à parte, pelo tflite_golden.
+// --no-fuse desliga a fusão expand -> depthwise -> project.
+// --memory-budget MB limita o número de interpretadores (um por thread) à
+// memória disponível; o resumo mostra a arena planejada por instância.
+//
+// Uso: fire_infer [--model ARQ] [--threads N] [--batch N] [--gamma G]
+//                 [--kernels ref|avx2|vnni] [--no-fuse] [--memory-budget MB] [--verify]
+//                 [--stream ARQ|-] [CAMINHO... | -]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "infer/fire_infer.h"
+#include "dataset.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+namespace fs = std::filesystem;
+
+static bool is_jpeg_name(const fs::path &p) {
+    std::string ext = p.extension().string();
+    for (char &c : ext) c = (char)tolower((unsigned char)c);
+    return ext == ".jpg" || ext == ".jpeg";
+}
+
+static void collect(const std::string &arg, std::vector<std::string> &paths) {
+    std::error_code ec;
+    if (fs::is_directory(arg, ec)) {
+        std::vector<std::string> found;
+        for (const auto &e : fs::recursive_directory_iterator(arg, ec)) {
+            if (e.is_regular_file() && is_jpeg_name(e.path())) found.push_back(e.path().string());
+        }
+        std::sort(found.begin(), found.end());
+        paths.insert(paths.end(), found.begin(), found.end());
+    } else {
+        paths.push_back(arg);
+    }
+}
+
+// Fim do JPEG que começa em data[0] (SOI), ou 0 se incompleto. Percorre os
+// segmentos até o SOS e então procura o EOI nos dados entrópicos, para não
+// confundir com o EOI de uma miniatura EXIF.
+static size_t jpeg_frame_end(const uint8_t *data, size_t len) {
+    size_t p = 2;
+    while (p + 4 <= len) {
+        if (data[p] != 0xFF) return 0;
+        uint8_t m = data[p + 1];
+        if (m == 0xFF) { p++; continue; }
+        if (m == 0xD9) return p + 2;
+        if (m >= 0xD0 && m <= 0xD7) { p += 2; continue; }
+        size_t seg = ((size_t)data[p + 2] << 8) | data[p + 3];
+        p += 2 + seg;
+        if (m == 0xDA) break;
+    }
+    for (; p + 1 < len; p++) {
+        if (data[p] == 0xFF && data[p + 1] == 0xD9) return p + 2;
+    }
+    return 0;
+}
+
+// Tensores de ativação que diferem entre os dois interpretadores
+static int compare_tensors(const fire::Interpreter &a, const fire::Interpreter &b, const std::string &name) {
+    const std::vector<fire::TensorInfo> &tensors = a.model().tensors();
+    int mismatches = 0;
+    for (size_t t = 0; t < tensors.size(); t++) {
+        if (tensors[t].is_constant()) continue;
+        const uint8_t *x = a.tensor_data((int)t), *y = b.tensor_data((int)t);
+        if (!x || !y) continue;
+        size_t n = a.tensor_bytes((int)t), diff = 0;
+        for (size_t i = 0; i < n; i++) diff += x[i] != y[i];
+        if (diff) {
+            fprintf(stderr, "DIVERGE %s: tensor %zu (%s) %zu/%zu bytes\n", name.c_str(), t,
+                    tensors[t].name.c_str(), diff, n);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char **argv) {
+    fire::EngineConfig cfg;
+    cfg.model_path = FIRE_MODEL_PATH;
+    std::string stream;
+    std::vector<std::string> args;
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--model" && has_val) cfg.model_path = argv[++i];
+        else if (a == "--threads" && has_val) cfg.threads = atoi(argv[++i]);
+        else if (a == "--batch" && has_val) cfg.batch = atoi(argv[++i]);
+        else if (a == "--gamma" && has_val) cfg.gamma = strtof(argv[++i], nullptr);
+        else if (a == "--stream" && has_val) stream = argv[++i];
+        else if (a == "--verify") verify = true;
+        else if (a == "--no-fuse") cfg.fuse = false;
+        else if (a == "--memory-budget" && has_val) cfg.memory_budget = (size_t)(atof(argv[++i]) * 1024 * 1024);
+        else if (a == "--kernels" && has_val) {
+            cfg.isa = fire::parse_kernel_isa(argv[++i]);
+            if (cfg.isa == fire::kIsaAuto) {
+                fprintf(stderr, "Kernels desconhecidos: %s (ref, avx2, vnni)\n", argv[i]);
+                return 2;
+            }
+        }
+        else if (a.size() > 1 && a[0] == '-') {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        } else args.push_back(a);
+    }
+    if (stream.empty() && args.empty()) {
+        fprintf(stderr, "Uso: fire_infer [--model ARQ] [--threads N] [--batch N] [--gamma G] "
+                        "[--kernels ref|avx2|vnni] [--no-fuse] [--memory-budget MB] [--verify] [--stream ARQ|-] [CAMINHO... | -]\n");
+        return 2;
+    }
+
+    std::string err;
+    std::unique_ptr<fire::Engine> engine = fire::Engine::create(cfg, &err);
+    if (!engine) {
+        fprintf(stderr, "Falha ao carregar %s: %s\n", cfg.model_path.c_str(), err.c_str());
+        return 1;
+    }
+
+    // Verificação: um par de interpretadores (otimizado e _ref) na thread principal
+    std::unique_ptr<fire::Classifier> opt, ref;
+    size_t diverged = 0;
+    if (verify) {
+        std::shared_ptr<const fire::TfliteModel> model = fire::TfliteModel::load(cfg.model_path, &err);
+        fire::InterpreterOptions options;
+        options.isa = cfg.isa;
+        options.fuse = cfg.fuse;
+        options.preserve_all_tensors = true;
+        if (model) opt = fire::Classifier::create(model, 1, cfg.gamma, &err, options);
+        options.isa = fire::kIsaReference;
+        if (opt) ref = fire::Classifier::create(model, 1, cfg.gamma, &err, options);
+        if (!ref) {
+            fprintf(stderr, "Falha ao preparar a verificacao: %s\n", err.c_str());
+            return 1;
+        }
+    }
+    auto score = [&](size_t n, const fire::JpegSource &source, const std::vector<std::string> &names,
+                     float *scores) {
+        if (!verify) {
+            engine->score(n, source, scores);
+            return;
+        }
+        std::vector<uint8_t> jpg;
+        for (size_t i = 0; i < n; i++) {
+            float s_ref;
+            scores[i] = -1.0f;
+            if (!source(i, jpg) || !opt->predict(jpg.data(), jpg.size(), &scores[i]) ||
+                !ref->predict(jpg.data(), jpg.size(), &s_ref)) {
+                scores[i] = -1.0f;
+                continue;
+            }
+            if (compare_tensors(opt->interpreter(), ref->interpreter(), names[i])) diverged++;
+        }
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    size_t frames = 0, failures = 0;
+    auto report = [&](const std::vector<std::string> &names, const std::vector<float> &scores) {
+        for (size_t i = 0; i < names.size(); i++) {
+            if (scores[i] < 0.0f) {
+                fprintf(stderr, "Falha no decode: %s\n", names[i].c_str());
+                failures++;
+                continue;
+            }
+            printf("%s %.4f\n", names[i].c_str(), scores[i]);
+        }
+        frames += names.size();
+        fflush(stdout);
+    };
+
+    if (!stream.empty()) {
+        // Fluxo: processa em blocos para não esperar o fim do arquivo
+        FILE *f = stream == "-" ? stdin : fopen(stream.c_str(), "rb");
+        if (!f) {
+            fprintf(stderr, "Nao foi possivel abrir %s\n", stream.c_str());
+            return 1;
+        }
+        const size_t chunk = (size_t)engine->threads() * std::max(cfg.batch, 1) * 4;
+        std::vector<uint8_t> buf;
+        std::vector<std::vector<uint8_t>> pending;
+        std::vector<std::string> names;
+        uint8_t tmp[1 << 16];
+        size_t n, index = 0;
+        bool eof = false;
+        while (!eof) {
+            n = fread(tmp, 1, sizeof(tmp), f);
+            if (n == 0) eof = true;
+            buf.insert(buf.end(), tmp, tmp + n);
+
+            size_t pos = 0;
+            for (;;) {
+                while (pos + 1 < buf.size() && !(buf[pos] == 0xFF && buf[pos + 1] == 0xD8)) pos++;
+                if (pos + 1 >= buf.size()) break;
+                size_t end = jpeg_frame_end(buf.data() + pos, buf.size() - pos);
+                if (!end) break;
+                pending.emplace_back(buf.begin() + pos, buf.begin() + pos + end);
+                char name[32];
+                snprintf(name, sizeof(name), "frame_%06zu", index++);
+                names.push_back(name);
+                pos += end;
+            }
+            buf.erase(buf.begin(), buf.begin() + std::min(pos, buf.size()));
+
+            if (pending.size() >= chunk || (eof && !pending.empty())) {
+                std::vector<float> scores(pending.size());
+                score(pending.size(), [&](size_t i, std::vector<uint8_t> &out) {
+                    out.swap(pending[i]);
+                    return true;
+                }, names, scores.data());
+                report(names, scores);
+                pending.clear();
+                names.clear();
+            }
+        }
+        if (f != stdin) fclose(f);
+    } else {
+        std::vector<std::string> paths;
+        for (const std::string &a : args) {
+            if (a == "-") {
+                char line[4096];
+                while (fgets(line, sizeof(line), stdin)) {
+                    line[strcspn(line, "\r\n")] = 0;
+                    if (line[0]) collect(line, paths);
+                }
+            } else {
+                collect(a, paths);
+            }
+        }
+        std::vector<float> scores(paths.size());
+        score(paths.size(), [&](size_t i, std::vector<uint8_t> &out) {
+            return read_file(paths[i], out);
+        }, paths, scores.data());
+        report(paths, scores);
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fprintf(stderr, "%zu frames (%zu falhas) em %.2f s: %.1f frames/s, %d threads, lote %d, kernels %s "
+                    "(%.0f KB de pesos reempacotados)\n",
+            frames, failures, secs, secs > 0 ? frames / secs : 0.0, engine->threads(), std::max(cfg.batch, 1),
+            fire::kernel_isa_name(engine->isa()), engine->packed_bytes() / 1024.0);
+    const fire::Interpreter &interp = engine->interpreter();
+    if (interp.fused_blocks()) {
+        fprintf(stderr, "Fusao: %d blocos, %.0f KB de ativacoes por invoke fora da memoria\n", interp.fused_blocks(),
+                interp.fused_traffic_saved() / 1024.0);
+    }
+    fprintf(stderr, "Memoria: arena de %.0f KB por interpretador (%.0f KB sem o planejador), %.0f KB com os "
+                    "buffers de trabalho; %d interpretadores\n",
+            interp.arena_bytes() / 1024.0, interp.unplanned_bytes() / 1024.0, interp.memory_bytes() / 1024.0,
+            engine->threads());
+    if (verify) {
+        fprintf(stderr, "Verificacao %s x ref: %zu/%zu frames divergentes%s\n",
+                fire::kernel_isa_name(opt->interpreter().isa()), diverged, frames - failures,
+                diverged ? "" : " (bit-exato com os _ref)");
+    }
+    return (failures || diverged) ? 1 : 0;
+}
@@ -0,0 +1,175 @@
+// Gerador de carga para o fire_server, sem câmeras: N conexões simultâneas
+// mandam frames do dataset (em rodízio) pelo socket Unix ou por HTTP, em
+// malha fechada (o mais rápido possível) ou a uma taxa total fixa.
+//
+// Com --rate a latência conta a partir do instante agendado de cada frame,
+// para que atrasos do servidor não escondam a fila (coordinated omission).
+// No fim imprime vazão e percentis; com HTTP também o GET /metrics.
+//
+// Uso: fire_load (--unix CAMINHO | --http HOST:PORTA) [--connections N]
+//                [--duration S] [--rate FPS] [--split test] [--data DIR]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "dataset.h"
+#include "net_util.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct Target {
+    std::string unix_path;
+    std::string host;
+    int port = 0;
+};
+
+static int open_connection(const Target &t) {
+    return t.unix_path.empty() ? net_connect_tcp(t.host, t.port) : net_connect_unix(t.unix_path);
+}
+
+// Um frame pela conexão aberta; score < 0 = recusado ou inválido
+static bool send_frame(const Target &t, int fd, std::string &pending, const std::vector<uint8_t> &jpg,
+                       float *score) {
+    if (!t.unix_path.empty()) {
+        uint32_t len = (uint32_t)jpg.size();
+        return net_write_all(fd, &len, 4) && net_write_all(fd, jpg.data(), jpg.size()) &&
+               net_read_all(fd, score, 4);
+    }
+    char head[256];
+    int n = snprintf(head, sizeof(head),
+                     "POST /score HTTP/1.1\r\nHost: %s\r\nContent-Type: image/jpeg\r\nContent-Length: %zu\r\n\r\n",
+                     t.host.c_str(), jpg.size());
+    HttpMessage resp;
+    if (!net_write_all(fd, head, (size_t)n) || !net_write_all(fd, jpg.data(), jpg.size()) ||
+        !http_read(fd, pending, &resp, 4096))
+        return false;
+    std::string body(resp.body.begin(), resp.body.end());
+    const char *p = strstr(body.c_str(), "\"score\":");
+    *score = (p && resp.start_line.find(" 200 ") != std::string::npos) ? strtof(p + 8, nullptr) : -1.0f;
+    return true;
+}
+
+struct WorkerResult {
+    std::vector<uint32_t> latencies_us;
+    long errors = 0;
+};
+
+static void run_connection(const Target &t, const std::vector<std::vector<uint8_t>> &frames, int id,
+                           Clock::time_point end, double interval_s, WorkerResult *out) {
+    int fd = open_connection(t);
+    if (fd < 0) {
+        out->errors++;
+        return;
+    }
+    std::string pending;
+    size_t next = (size_t)id;
+    Clock::time_point scheduled = Clock::now();
+    while (Clock::now() < end) {
+        if (interval_s > 0) {
+            std::this_thread::sleep_until(scheduled);
+            if (scheduled >= end) break;
+        } else {
+            scheduled = Clock::now();
+        }
+        float score;
+        const bool ok = send_frame(t, fd, pending, frames[next % frames.size()], &score);
+        const Clock::time_point done = Clock::now();
+        next++;
+        if (!ok) {
+            out->errors++;
+            close(fd);
+            fd = open_connection(t);
+            pending.clear();
+            if (fd < 0) return;
+        } else if (score < 0.0f) {
+            out->errors++;
+        } else {
+            out->latencies_us.push_back(
+                (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(done - scheduled).count());
+        }
+        if (interval_s > 0)
+            scheduled += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(interval_s));
+    }
+    close(fd);
+}
+
+int main(int argc, char **argv) {
+    Target target;
+    std::string split = "test", data_dir = FIRE_DATA_DIR;
+    int connections = 8;
+    double duration = 10.0, rate = 0.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--unix" && has_val) target.unix_path = argv[++i];
+        else if (a == "--http" && has_val) {
+            std::string hp = argv[++i];
+            size_t colon = hp.rfind(':');
+            target.host = colon == std::string::npos ? "127.0.0.1" : hp.substr(0, colon);
+            target.port = atoi(colon == std::string::npos ? hp.c_str() : hp.c_str() + colon + 1);
+        } else if (a == "--connections" && has_val) connections = std::max(1, atoi(argv[++i]));
+        else if (a == "--duration" && has_val) duration = atof(argv[++i]);
+        else if (a == "--rate" && has_val) rate = atof(argv[++i]);
+        else if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+    if (target.unix_path.empty() && !target.port) {
+        fprintf(stderr, "Uso: fire_load (--unix CAMINHO | --http HOST:PORTA) [--connections N] [--duration S] "
+                        "[--rate FPS] [--split test] [--data DIR]\n");
+        return 2;
+    }
+
+    std::vector<std::vector<uint8_t>> frames;
+    for (const DatasetImage &img : dataset_list(data_dir, split)) {
+        std::vector<uint8_t> jpg;
+        if (read_file(img.image_path, jpg)) frames.push_back(std::move(jpg));
+    }
+    if (frames.empty()) {
+        fprintf(stderr, "Nenhuma imagem em %s/%s\n", data_dir.c_str(), split.c_str());
+        return 1;
+    }
+
+    const double interval_s = rate > 0 ? connections / rate : 0.0;
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+    std::vector<WorkerResult> results(connections);
+    std::vector<std::thread> threads;
+    for (int c = 0; c < connections; c++)
+        threads.emplace_back(run_connection, std::cref(target), std::cref(frames), c, end, interval_s, &results[c]);
+    for (std::thread &t : threads) t.join();
+    const double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<uint32_t> lat;
+    long errors = 0;
+    for (const WorkerResult &r : results) {
+        lat.insert(lat.end(), r.latencies_us.begin(), r.latencies_us.end());
+        errors += r.errors;
+    }
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) { return lat.empty() ? 0.0 : lat[(size_t)(p / 100.0 * (lat.size() - 1) + 0.5)] / 1000.0; };
+    printf("%zu frames em %.2f s (%.1f frames/s), %ld erros, %d conexoes%s\n", lat.size(), secs,
+           lat.size() / secs, errors, connections, rate > 0 ? "" : " (malha fechada)");
+    printf("latencia ms: p50 %.2f  p95 %.2f  p99 %.2f  max %.2f\n", pct(50), pct(95), pct(99),
+           lat.empty() ? 0.0 : lat.back() / 1000.0);
+
+    if (!target.unix_path.empty()) return errors ? 1 : 0;
+    int fd = net_connect_tcp(target.host, target.port);
+    const char req[] = "GET /metrics HTTP/1.1\r\nConnection: close\r\n\r\n";
+    std::string pending;
+    HttpMessage resp;
+    if (fd >= 0 && net_write_all(fd, req, sizeof(req) - 1) && http_read(fd, pending, &resp, 64 * 1024))
+        printf("servidor: %.*s\n", (int)resp.body.size(), (const char *)resp.body.data());
+    if (fd >= 0) close(fd);
+    return errors ? 1 : 0;
+}
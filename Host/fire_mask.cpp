@@ -0,0 +1,111 @@
+// Monta e envia a máscara de exclusão de uma câmera (Firmware/main/exclusion_mask.h).
+// Retângulos em pixels do frame fonte viram células da grade 32x24; o blob
+// vai por POST /mask e o firmware o guarda na NVS. Sem retângulos nem
+// --clear, lê a máscara atual do dispositivo e a desenha no terminal.
+//
+// Uso: fire_mask [--device HOST[:PORTA]] [--size 320x240] [--rect X,Y,L,A]...
+//                [--clear] [--out ARQ]
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include "exclusion_mask.h"
+#include "net_util.h"
+
+// Uma requisição com o corpo opcional; devolve a resposta
+static bool request(const std::string &host, int port, const char *method, const std::vector<uint8_t> &body,
+                    HttpMessage *resp) {
+    int fd = net_connect_tcp(host, port);
+    if (fd < 0) return false;
+    char head[256];
+    int n = snprintf(head, sizeof(head),
+                     "%s /mask HTTP/1.1\r\nHost: %s\r\nContent-Type: application/octet-stream\r\n"
+                     "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+                     method, host.c_str(), body.size());
+    std::string pending;
+    bool ok = net_write_all(fd, head, (size_t)n) && (body.empty() || net_write_all(fd, body.data(), body.size())) &&
+              http_read(fd, pending, resp, 4096);
+    close(fd);
+    return ok && resp->start_line.find(" 200 ") != std::string::npos;
+}
+
+static void print_mask(const exclusion_mask_t &m) {
+    for (int r = 0; r < MASK_ROWS; r++) {
+        for (int c = 0; c < MASK_COLS; c++) putchar(exclusion_mask_cell(&m, c, r) ? '#' : '.');
+        putchar('\n');
+    }
+    printf("%d/%d celulas mascaradas\n", exclusion_mask_count(&m), MASK_COLS * MASK_ROWS);
+}
+
+int main(int argc, char **argv) {
+    std::string device, out_path;
+    int src_w = 320, src_h = 240;
+    bool clear = false, edit = false;
+    exclusion_mask_t mask;
+    exclusion_mask_clear(&mask);
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        int x, y, w, h;
+        if (a == "--device" && has_val) device = argv[++i];
+        else if (a == "--out" && has_val) out_path = argv[++i];
+        else if (a == "--size" && has_val && sscanf(argv[i + 1], "%dx%d", &src_w, &src_h) == 2) i++;
+        else if (a == "--rect" && has_val && sscanf(argv[i + 1], "%d,%d,%d,%d", &x, &y, &w, &h) == 4) {
+            exclusion_mask_add_rect(&mask, src_w, src_h, x, y, w, h);
+            edit = true;
+            i++;
+        } else if (a == "--clear") clear = edit = true;
+        else {
+            fprintf(stderr, "Argumento invalido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+    if (device.empty() && out_path.empty()) {
+        fprintf(stderr, "Uso: fire_mask [--device HOST[:PORTA]] [--size 320x240] [--rect X,Y,L,A]... "
+                        "[--clear] [--out ARQ]\n");
+        return 2;
+    }
+    if (clear) exclusion_mask_clear(&mask);
+
+    std::string host = device;
+    int port = 80;
+    size_t colon = device.rfind(':');
+    if (colon != std::string::npos) {
+        host = device.substr(0, colon);
+        port = atoi(device.c_str() + colon + 1);
+    }
+
+    HttpMessage resp;
+    if (!edit) {
+        // Só leitura: máscara atual do dispositivo
+        if (device.empty() || !request(host, port, "GET", {}, &resp) ||
+            !exclusion_mask_load(&mask, resp.body.data(), (uint32_t)resp.body.size())) {
+            fprintf(stderr, "Falha ao ler a mascara de %s\n", device.c_str());
+            return 1;
+        }
+    }
+    print_mask(mask);
+
+    if (!out_path.empty()) {
+        FILE *f = fopen(out_path.c_str(), "wb");
+        if (!f || fwrite(mask.bits, 1, MASK_BYTES, f) != MASK_BYTES) {
+            fprintf(stderr, "Falha ao gravar %s\n", out_path.c_str());
+            if (f) fclose(f);
+            return 1;
+        }
+        fclose(f);
+    }
+    if (edit && !device.empty()) {
+        // Máscara vazia = corpo vazio (o firmware apaga a chave da NVS)
+        std::vector<uint8_t> body;
+        if (mask.enabled) body.assign(mask.bits, mask.bits + MASK_BYTES);
+        if (!request(host, port, "POST", body, &resp)) {
+            fprintf(stderr, "Falha ao enviar a mascara para %s\n", device.c_str());
+            return 1;
+        }
+        printf("Enviada: %s\n", std::string(resp.body.begin(), resp.body.end()).c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+// Servidor local de inferência para o NVR: recebe frames JPEG das câmeras
+// por socket Unix e/ou HTTP, junta em micro-lotes (janela de latência
+// configurável) e distribui entre os interpretadores, um por núcleo.
+//
+// Socket Unix: [u32 LE tamanho][JPEG] -> [f32 LE score], em sequência por
+// conexão (ver net_util.h); -1 = JPEG inválido, -2 = fila cheia.
+// HTTP: POST /score com o JPEG no corpo -> {"score":0.1234} (400 se o JPEG é
+// inválido, 503 com a fila cheia); GET /metrics -> fila, lotes e latências.
+//
+// Uso: fire_server [--model ARQ] [--threads N] [--batch N] [--kernels ref|avx2|vnni]
+//                  [--memory-budget MB] [--max-batch N] [--window-us US] [--max-queue N]
+//                  [--unix CAMINHO] [--http PORTA] [--bind ENDERECO] [--stats-s S]
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <poll.h>
+#include <set>
+#include <string>
+#include <strings.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include "batcher.h"
+#include "net_util.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+static std::atomic<bool> g_stop(false);
+
+static void on_signal(int) { g_stop = true; }
+
+// Conexões abertas: no encerramento são derrubadas e o main espera todas
+// terminarem antes de destruir o batcher
+class Connections {
+public:
+    void add(int fd) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_.insert(fd);
+    }
+    void remove(int fd) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_.erase(fd);
+        close(fd);
+        if (open_.empty()) idle_.notify_all();
+    }
+    void shutdown_all() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (int fd : open_) shutdown(fd, SHUT_RDWR);
+        idle_.wait(lock, [this] { return open_.empty(); });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    std::set<int> open_;
+};
+
+static Connections g_connections;
+
+static std::string metrics_json(const fire::MicroBatcher &batcher, const fire::Engine &engine) {
+    fire::BatcherMetrics m = batcher.metrics();
+    char buf[768];
+    snprintf(buf, sizeof(buf),
+             "{\"requests\":%llu,\"rejected\":%llu,\"failures\":%llu,\"batches\":%llu,\"avg_batch\":%.2f,"
+             "\"queue_depth\":%zu,\"max_queue_depth\":%zu,\"in_flight\":%zu,"
+             "\"wait_us\":{\"p50\":%u,\"p95\":%u,\"p99\":%u},"
+             "\"latency_us\":{\"p50\":%u,\"p95\":%u,\"p99\":%u},"
+             "\"threads\":%d,\"kernels\":\"%s\"}",
+             (unsigned long long)m.requests, (unsigned long long)m.rejected, (unsigned long long)m.failures,
+             (unsigned long long)m.batches, m.avg_batch, m.queue_depth, m.max_queue_depth, m.in_flight,
+             m.wait_p50_us, m.wait_p95_us, m.wait_p99_us, m.total_p50_us, m.total_p95_us, m.total_p99_us,
+             engine.threads(), fire::kernel_isa_name(engine.isa()));
+    return buf;
+}
+
+static void serve_unix(int fd, fire::MicroBatcher *batcher) {
+    for (;;) {
+        uint32_t len;
+        if (!net_read_all(fd, &len, 4) || len > FIRE_FRAME_MAX_BYTES) break;
+        std::vector<uint8_t> jpg(len);
+        if (!net_read_all(fd, jpg.data(), len)) break;
+        float score;
+        if (!batcher->score(std::move(jpg), &score)) score = -2.0f;
+        if (!net_write_all(fd, &score, 4)) break;
+    }
+    g_connections.remove(fd);
+}
+
+static bool http_reply(int fd, const char *status, const std::string &body, bool keep_alive) {
+    char head[256];
+    int n = snprintf(head, sizeof(head),
+                     "HTTP/1.1 %s\r\nContent-Type: application/json\r\nContent-Length: %zu\r\nConnection: %s\r\n\r\n",
+                     status, body.size(), keep_alive ? "keep-alive" : "close");
+    // Uma escrita só: cabeçalho e corpo separados esbarram no Nagle + ACK atrasado
+    std::string msg(head, (size_t)n);
+    msg += body;
+    return net_write_all(fd, msg.data(), msg.size());
+}
+
+static void serve_http(int fd, fire::MicroBatcher *batcher, const fire::Engine *engine) {
+    std::string pending;
+    HttpMessage req;
+    while (http_read(fd, pending, &req, FIRE_FRAME_MAX_BYTES)) {
+        auto conn = req.headers.find("connection");
+        const bool keep_alive = conn == req.headers.end() || strcasecmp(conn->second.c_str(), "close") != 0;
+        bool ok;
+        if (req.start_line.compare(0, 12, "POST /score ") == 0) {
+            float score;
+            char body[64];
+            if (!batcher->score(std::move(req.body), &score)) {
+                ok = http_reply(fd, "503 Service Unavailable", "{\"error\":\"fila cheia\"}", keep_alive);
+            } else if (score < 0.0f) {
+                ok = http_reply(fd, "400 Bad Request", "{\"error\":\"jpeg invalido\"}", keep_alive);
+            } else {
+                snprintf(body, sizeof(body), "{\"score\":%.4f}", score);
+                ok = http_reply(fd, "200 OK", body, keep_alive);
+            }
+        } else if (req.start_line.compare(0, 13, "GET /metrics ") == 0) {
+            ok = http_reply(fd, "200 OK", metrics_json(*batcher, *engine), keep_alive);
+        } else {
+            ok = http_reply(fd, "404 Not Found", "{\"error\":\"not found\"}", keep_alive);
+        }
+        if (!ok || !keep_alive) break;
+    }
+    g_connections.remove(fd);
+}
+
+// Uma thread por conexão: as câmeras mantêm a conexão aberta e mandam um
+// frame por vez, então o paralelismo vem do número de câmeras
+template <typename Fn>
+static std::thread accept_loop(int listen_fd, Fn serve) {
+    return std::thread([listen_fd, serve] {
+        while (!g_stop) {
+            // poll com timeout: o accept não acorda sozinho no encerramento
+            pollfd p = {listen_fd, POLLIN, 0};
+            if (poll(&p, 1, 200) <= 0) continue;
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd < 0) continue;
+            g_connections.add(fd);
+            std::thread(serve, fd).detach();
+        }
+    });
+}
+
+int main(int argc, char **argv) {
+    fire::EngineConfig cfg;
+    cfg.model_path = FIRE_MODEL_PATH;
+    fire::BatcherConfig bcfg;
+    std::string unix_path, bind_addr = "127.0.0.1";
+    int http_port = 0;
+    double stats_s = 10.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--model" && has_val) cfg.model_path = argv[++i];
+        else if (a == "--threads" && has_val) cfg.threads = atoi(argv[++i]);
+        else if (a == "--batch" && has_val) cfg.batch = atoi(argv[++i]);
+        else if (a == "--memory-budget" && has_val) cfg.memory_budget = (size_t)(atof(argv[++i]) * 1024 * 1024);
+        else if (a == "--max-batch" && has_val) bcfg.max_batch = atoi(argv[++i]);
+        else if (a == "--window-us" && has_val) bcfg.window_us = atoi(argv[++i]);
+        else if (a == "--max-queue" && has_val) bcfg.max_queue = (size_t)atol(argv[++i]);
+        else if (a == "--unix" && has_val) unix_path = argv[++i];
+        else if (a == "--http" && has_val) http_port = atoi(argv[++i]);
+        else if (a == "--bind" && has_val) bind_addr = argv[++i];
+        else if (a == "--stats-s" && has_val) stats_s = atof(argv[++i]);
+        else if (a == "--kernels" && has_val) {
+            cfg.isa = fire::parse_kernel_isa(argv[++i]);
+            if (cfg.isa == fire::kIsaAuto) {
+                fprintf(stderr, "Kernels desconhecidos: %s (ref, avx2, vnni)\n", argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+    if (unix_path.empty() && !http_port) {
+        fprintf(stderr, "Uso: fire_server [--model ARQ] [--threads N] [--batch N] [--kernels ref|avx2|vnni] "
+                        "[--memory-budget MB] [--max-batch N] [--window-us US] [--max-queue N] "
+                        "[--unix CAMINHO] [--http PORTA] [--bind ENDERECO] [--stats-s S]\n");
+        return 2;
+    }
+    // O lote do interpretador acompanha o micro-lote, salvo pedido explícito
+    if (cfg.batch <= 1) cfg.batch = bcfg.max_batch;
+
+    std::string err;
+    std::unique_ptr<fire::Engine> engine = fire::Engine::create(cfg, &err);
+    if (!engine) {
+        fprintf(stderr, "Falha ao carregar %s: %s\n", cfg.model_path.c_str(), err.c_str());
+        return 1;
+    }
+    fire::MicroBatcher batcher(*engine, bcfg);
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    std::vector<std::thread> acceptors;
+    std::vector<int> listeners;
+    if (!unix_path.empty()) {
+        int fd = net_listen_unix(unix_path);
+        if (fd < 0) {
+            fprintf(stderr, "Falha ao abrir o socket %s: %s\n", unix_path.c_str(), strerror(errno));
+            return 1;
+        }
+        listeners.push_back(fd);
+        acceptors.push_back(accept_loop(fd, [&batcher](int c) { serve_unix(c, &batcher); }));
+    }
+    if (http_port) {
+        int fd = net_listen_tcp(bind_addr, http_port);
+        if (fd < 0) {
+            fprintf(stderr, "Falha ao escutar em %s:%d: %s\n", bind_addr.c_str(), http_port, strerror(errno));
+            return 1;
+        }
+        listeners.push_back(fd);
+        const fire::Engine *e = engine.get();
+        acceptors.push_back(accept_loop(fd, [&batcher, e](int c) { serve_http(c, &batcher, e); }));
+    }
+    fprintf(stderr, "fire_server: %d threads, kernels %s, micro-lote %d / %d us%s%s%s\n", engine->threads(),
+            fire::kernel_isa_name(engine->isa()), bcfg.max_batch, bcfg.window_us,
+            unix_path.empty() ? "" : ", unix ", unix_path.c_str(),
+            http_port ? (", http " + bind_addr + ":" + std::to_string(http_port)).c_str() : "");
+
+    auto last = std::chrono::steady_clock::now();
+    while (!g_stop) {
+        usleep(100 * 1000);
+        if (stats_s > 0 && std::chrono::steady_clock::now() - last >= std::chrono::duration<double>(stats_s)) {
+            last = std::chrono::steady_clock::now();
+            fprintf(stderr, "%s\n", metrics_json(batcher, *engine).c_str());
+        }
+    }
+
+    for (std::thread &t : acceptors) t.join();
+    for (int fd : listeners) close(fd);
+    g_connections.shutdown_all();
+    if (!unix_path.empty()) unlink(unix_path.c_str());
+    fprintf(stderr, "%s\n", metrics_json(batcher, *engine).c_str());
+    return 0;
+}
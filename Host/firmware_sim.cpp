@@ -0,0 +1,195 @@
+// Firmware inteiro (Firmware/main: main.cpp, classifier.cpp, server.cpp) rodando
+// no host sobre os shims de Host/sim: câmera virtual com imagens do dataset,
+// httpd em socket real, NVS em arquivo e tarefas do FreeRTOS como threads.
+// Serve a mesma API HTTP do dispositivo (a UI do Qt e o fire_load podem
+// apontar para cá) ou, com --bench, mede os handlers sem socket. Os
+// símbolos do firmware ficam no binário para perf record/report.
+//
+// A câmera virtual replaya os splits do dataset (--split train,valid,test ou
+// all) ou um vídeo MJPEG gravado, no ritmo de --fps com jitter e perdas
+// injetadas; a mesma --seed reproduz a mesma sequência de capturas.
+//
+// --trace grava a linha do tempo do firmware (trace.h) desde o boot e a
+// salva em JSON do Chrome trace ao sair (Ctrl+C ou fim do --bench); o
+// mesmo conteúdo que o GET /trace do dispositivo.
+//
+// Uso: firmware_sim [--split test] [--data DIR] [--mjpeg ARQ] [--fps 0]
+//                   [--jitter-ms 0] [--drop 0] [--seed 1] [--port 8080]
+//                   [--nvs ARQ] [--quality 12] [--bench N] [--trace ARQ]
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include "dataset.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "sim/sim.h"
+#include "classifier.h"
+#include "trace.h"
+
+extern "C" void app_main();
+
+using Clock = std::chrono::steady_clock;
+
+static void app_task(void *) { app_main(); }
+
+static double ms_since(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+static bool write_chunk(void *ctx, const char *buf, size_t len) { return fwrite(buf, 1, len, (FILE *)ctx) == len; }
+
+static bool save_trace(const std::string &path) {
+    FILE *f = fopen(path.c_str(), "w");
+    int n = f ? trace_write_json(write_chunk, f) : -1;
+    if (f) fclose(f);
+    if (n < 0) {
+        fprintf(stderr, "Falha ao gravar o trace em %s\n", path.c_str());
+        return false;
+    }
+    printf("Trace: %d eventos em %s (abrir no Perfetto)\n", n, path.c_str());
+    return true;
+}
+
+static void print_latency(const char *name, std::vector<double> ms) {
+    if (ms.empty()) return;
+    std::sort(ms.begin(), ms.end());
+    double sum = 0;
+    for (double v : ms) sum += v;
+    printf("  %-22s n=%zu  media %.2f ms  p50 %.2f  p95 %.2f  max %.2f\n", name, ms.size(), sum / ms.size(),
+           ms[ms.size() / 2], ms[ms.size() * 95 / 100], ms.back());
+}
+
+int main(int argc, char **argv) {
+    std::string data_dir = FIRE_DATA_DIR, split = "test", mjpeg_path, nvs_path, trace_path;
+    int port = 8080, quality = 12, bench = 0;
+    SimCameraTiming timing;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--mjpeg" && has_val) mjpeg_path = argv[++i];
+        else if (a == "--fps" && has_val) timing.fps = strtof(argv[++i], nullptr);
+        else if (a == "--jitter-ms" && has_val) timing.jitter_ms = strtof(argv[++i], nullptr);
+        else if (a == "--drop" && has_val) timing.drop_rate = strtof(argv[++i], nullptr);
+        else if (a == "--seed" && has_val) timing.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else if (a == "--port" && has_val) port = atoi(argv[++i]);
+        else if (a == "--nvs" && has_val) nvs_path = argv[++i];
+        else if (a == "--quality" && has_val) quality = atoi(argv[++i]);
+        else if (a == "--bench" && has_val) bench = atoi(argv[++i]);
+        else if (a == "--trace" && has_val) trace_path = argv[++i];
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+
+    // Frames na resolução do sensor (QVGA, a do init_camera do firmware)
+    std::string err;
+    if (!mjpeg_path.empty()) {
+        if (!sim_camera_load_mjpeg(mjpeg_path, 320, 240, quality, &err)) {
+            fprintf(stderr, "%s\n", err.c_str());
+            return 1;
+        }
+    } else {
+        if (split == "all") split = "train,valid,test";
+        std::vector<std::string> paths;
+        for (size_t pos = 0; pos <= split.size();) {
+            size_t comma = std::min(split.find(',', pos), split.size());
+            for (const DatasetImage &img : dataset_list(data_dir, split.substr(pos, comma - pos)))
+                paths.push_back(img.image_path);
+            pos = comma + 1;
+        }
+        if (paths.empty() || !sim_camera_load_images(paths, 320, 240, quality, &err)) {
+            fprintf(stderr, "Sem frames em %s (%s) %s\n", data_dir.c_str(), split.c_str(), err.c_str());
+            return 1;
+        }
+    }
+    printf("Camera virtual: %zu frames 320x240 (qualidade JPEG %d), ", sim_camera_frame_count(), quality);
+    if (timing.fps > 0) {
+        printf("%.1f fps, jitter %.1f ms, perda %.1f%%, seed %u\n", timing.fps, timing.jitter_ms,
+               timing.drop_rate * 100.0f, timing.seed);
+    } else {
+        printf("sem ritmo (um frame por fb_get)\n");
+    }
+    sim_nvs_set_file(nvs_path);
+    if (!trace_path.empty()) trace_set_enabled(true);
+    sim_httpd_set_port(port);
+
+    // app_main numa tarefa, como o main_task do ESP-IDF (não retorna)
+    xTaskCreate(app_task, "main", 8192, nullptr, 1, nullptr);
+    Clock::time_point t0 = Clock::now();
+    while (sim_httpd_call("GET", "/status", nullptr, 0, nullptr) != 200) {
+        if (ms_since(t0) > 10000) {
+            fprintf(stderr, "O firmware nao subiu o httpd\n");
+            return 1;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    printf("httpd em 127.0.0.1:%d\n", sim_httpd_port());
+    // O relógio do sensor parte daqui: o boot do firmware não consome capturas
+    sim_camera_set_timing(timing);
+
+    if (!bench) {
+        // Só o sinal interrompe; o firmware roda nas próprias threads
+        sigset_t set;
+        sigemptyset(&set);
+        sigaddset(&set, SIGINT);
+        sigaddset(&set, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &set, nullptr);
+        int sig;
+        sigwait(&set, &sig);
+        return trace_path.empty() || save_trace(trace_path) ? 0 : 1;
+    }
+
+    // Handler de captura completo (câmera + agendador + CNN + fusão) e, à
+    // parte, só o classifier_predict sobre os mesmos frames
+    std::vector<double> capture_ms, status_ms, predict_ms;
+    std::string body;
+    Clock::time_point bench_t0 = Clock::now();
+    for (int i = 0; i < bench; i++) {
+        Clock::time_point t = Clock::now();
+        if (sim_httpd_call("GET", "/capture", nullptr, 0, nullptr) != 200) {
+            fprintf(stderr, "GET /capture falhou\n");
+            return 1;
+        }
+        capture_ms.push_back(ms_since(t));
+        t = Clock::now();
+        sim_httpd_call("GET", "/status", nullptr, 0, &body);
+        status_ms.push_back(ms_since(t));
+    }
+    const double bench_s = ms_since(bench_t0) / 1000.0;
+    SimCameraStats cam;
+    sim_camera_get_stats(&cam);
+    std::vector<uint8_t> jpg;
+    for (int i = 0; i < bench && i < (int)sim_camera_frame_count(); i++) {
+        if (!sim_camera_frame(i, jpg)) continue;
+        Clock::time_point t = Clock::now();
+        classifier_predict(jpg.data(), jpg.size());
+        predict_ms.push_back(ms_since(t));
+    }
+
+    printf("Latencia (%s, sem socket):\n", SIM_TFLM_BACKEND);
+    print_latency("GET /capture", capture_ms);
+    print_latency("GET /status", status_ms);
+    print_latency("classifier_predict", predict_ms);
+    printf("Camera: %llu frames servidos (%.1f/s), %llu perdidos pelo sensor, %llu sobrescritos; "
+           "idade do frame media %.1f ms, max %.1f ms\n",
+           (unsigned long long)cam.served, bench / bench_s, (unsigned long long)cam.dropped,
+           (unsigned long long)cam.overwritten, cam.served ? cam.age_us_sum / 1000.0 / cam.served : 0.0,
+           cam.age_us_max / 1000.0);
+    printf("Heap interna: pico %zu de %zu bytes; PSRAM: pico %zu de %zu bytes\n",
+           heap_caps_get_total_size(MALLOC_CAP_INTERNAL) - heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL),
+           heap_caps_get_total_size(MALLOC_CAP_INTERNAL),
+           heap_caps_get_total_size(MALLOC_CAP_SPIRAM) - heap_caps_get_minimum_free_size(MALLOC_CAP_SPIRAM),
+           heap_caps_get_total_size(MALLOC_CAP_SPIRAM));
+    printf("/status: %s\n", body.c_str());
+    return trace_path.empty() || save_trace(trace_path) ? 0 : 1;
+}
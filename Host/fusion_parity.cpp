@@ -0,0 +1,97 @@
+// Paridade da fusão temporal: fusion_update_q no domínio da saída do modelo
+// contra a referência float (fusion_update, usada pelas ferramentas do host).
+// Para cada configuração e domínio, alimenta os dois caminhos com a mesma
+// sequência de scores (trechos uniformes e passeios aleatórios em torno dos
+// limiares, para exercitar votos e histerese) e compara decisão e EMA a cada
+// passo. Sai com 1 se alguma decisão divergir.
+//
+// Uso: fusion_parity [--steps N] [--seed S]
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "fusion.h"
+#include "score_quant.h"
+
+static uint32_t lcg(uint32_t &seed) {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+// Próximo q (índice 0..255 na faixa do domínio): alterna trechos de ruído
+// uniforme com passeios de passo pequeno, que cruzam os limiares devagar
+static int next_index(int prev, uint32_t &seed) {
+    static int mode = 0, left = 0;
+    if (left-- <= 0) {
+        mode = (int)(lcg(seed) % 2);
+        left = 20 + (int)(lcg(seed) % 200);
+    }
+    if (mode == 0) return (int)(lcg(seed) % 256);
+    int v = prev + (int)(lcg(seed) % 41) - 20;
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+struct Case {
+    const char *name;
+    fusion_config_t cfg;
+};
+
+struct Domain {
+    const char *name;
+    score_quant_t sq;
+};
+
+int main(int argc, char **argv) {
+    long steps = 200000;
+    uint32_t seed0 = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        if (a == "--steps" && i + 1 < argc) steps = atol(argv[++i]);
+        else if (a == "--seed" && i + 1 < argc) seed0 = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        else {
+            fprintf(stderr, "Uso: fusion_parity [--steps N] [--seed S]\n");
+            return 2;
+        }
+    }
+
+    fusion_config_t def;
+    fusion_default_config(&def);
+    // Padrão do firmware e a fusão documentada em main.cpp (USE_FUSION)
+    const Case cases[] = {{"padrao", def}, {"ema0.6_2de3_off0.45", {0.6f, 2, 3, 0.60f, 0.45f}}};
+    // uint8 dos modelos do repositório e o mesmo score em int8 (zero_point -128)
+    const Domain domains[] = {{"uint8", {1.0f / 255.0f, 0, 0, 255}}, {"int8", {1.0f / 255.0f, -128, -128, 127}}};
+
+    bool ok = true;
+    for (const Case &c : cases) {
+        for (const Domain &d : domains) {
+            fusion_qconfig_t qcfg;
+            fusion_quantize_config(&c.cfg, &d.sq, &qcfg);
+            fusion_t fq, ff;
+            fusion_reset(&fq);
+            fusion_reset(&ff);
+            uint32_t seed = seed0;
+            int idx = 0;
+            long decision_diff = 0, ema_diff = 0, alarms = 0, first_diff = -1;
+            for (long s = 0; s < steps; s++) {
+                idx = next_index(idx, seed);
+                const int32_t q = d.sq.q_min + idx;
+                const bool was_fire = fq.fire;
+                const int32_t ema_q8 = fusion_update_q(&fq, &qcfg, q);
+                fusion_update(&ff, &c.cfg, score_quant_to_float(&d.sq, q));
+                if (fq.fire != ff.fire) {
+                    decision_diff++;
+                    if (first_diff < 0) first_diff = s;
+                }
+                // Mesma EMA: o q * 256 do caminho inteiro, deslocado para a grade uint8
+                if (ema_q8 - d.sq.zero_point * 256 != ff.ema_q8) ema_diff++;
+                if (fq.fire && !was_fire) alarms++;
+            }
+            printf("%-22s %-6s passos=%ld alarmes=%ld decisoes_divergentes=%ld ema_divergente=%ld",
+                   c.name, d.name, steps, alarms, decision_diff, ema_diff);
+            if (first_diff >= 0) printf(" (primeira no passo %ld)", first_diff);
+            printf("\n");
+            if (decision_diff || ema_diff) ok = false;
+        }
+    }
+    printf("%s\n", ok ? "OK" : "FALHOU");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+"""Golden do TFLite para o Host/tflite_golden.
+
+Roda o interpretador TFLite com os kernels de referência (BUILTIN_REF) sobre
+as entradas já pré-processadas pelo host (tflite_golden --dump-inputs) e
+escreve, por imagem, o FNV-1a de 64 bits da saída de cada operador.
+
+Uso: python3 make_golden.py MODELO.tflite entradas.bin > MODELO.test.golden
+"""
+import sys
+
+import numpy as np
+
+try:
+    from ai_edge_litert.interpreter import Interpreter, OpResolverType
+except ImportError:
+    import tensorflow as tf
+
+    Interpreter, OpResolverType = tf.lite.Interpreter, tf.lite.experimental.OpResolverType
+
+
+def fnv1a64(data):
+    h = 1469598103934665603
+    for b in data:
+        h ^= b
+        h = (h * 1099511628211) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def read_inputs(path):
+    with open(path, "rb") as f:
+        header = f.readline().split()
+        if not header or header[0] != b"fire_golden_inputs":
+            raise SystemExit(f"{path} nao veio do tflite_golden --dump-inputs")
+        while True:
+            line = f.readline()
+            if not line:
+                return
+            name, size = line.split()
+            yield name.decode(), f.read(int(size))
+
+
+def main():
+    if len(sys.argv) != 3:
+        raise SystemExit(__doc__)
+    model_path, inputs_path = sys.argv[1:]
+    interp = Interpreter(
+        model_path=model_path,
+        experimental_op_resolver_type=OpResolverType.BUILTIN_REF,
+        experimental_preserve_all_tensors=True,
+    )
+    interp.allocate_tensors()
+    inp = interp.get_input_details()[0]
+    outputs = [t for op in interp._get_ops_details() for t in op["outputs"]]
+
+    print(f"# fire_golden v1 {model_path} (TFLite, BUILTIN_REF)")
+    for name, raw in read_inputs(inputs_path):
+        interp.set_tensor(inp["index"], np.frombuffer(raw, dtype=inp["dtype"]).reshape(inp["shape"]))
+        interp.invoke()
+        hashes = " ".join(f"{t}:{fnv1a64(interp.get_tensor(t).tobytes()):016x}" for t in outputs)
+        print(f"{name} {hashes}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,122 @@
+#include "batcher.h"
+#include <algorithm>
+#include <future>
+#include <memory>
+
+namespace fire {
+
+void LatencyWindow::add(uint32_t us) {
+    samples_[next_] = us;
+    next_ = (next_ + 1) % samples_.size();
+    filled_ = std::min(filled_ + 1, samples_.size());
+}
+
+uint32_t LatencyWindow::percentile(double p) const {
+    if (!filled_) return 0;
+    std::vector<uint32_t> sorted(samples_.begin(), samples_.begin() + filled_);
+    const size_t k = std::min(filled_ - 1, (size_t)(p / 100.0 * (filled_ - 1) + 0.5));
+    std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+    return sorted[k];
+}
+
+MicroBatcher::MicroBatcher(Engine &engine, const BatcherConfig &cfg) : engine_(engine), cfg_(cfg) {
+    cfg_.max_batch = std::max(cfg_.max_batch, 1);
+    cfg_.window_us = std::max(cfg_.window_us, 0);
+    dispatcher_ = std::thread(&MicroBatcher::dispatch_loop, this);
+}
+
+MicroBatcher::~MicroBatcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    dispatcher_.join();
+    // Lotes já despachados terminam antes do Engine sair de cena
+    engine_.wait();
+}
+
+bool MicroBatcher::submit(std::vector<uint8_t> jpg, Done done) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_ || queue_.size() >= cfg_.max_queue) {
+            counters_.rejected++;
+            return false;
+        }
+        queue_.push_back(Request{std::move(jpg), std::move(done), Clock::now()});
+        counters_.requests++;
+        counters_.max_queue_depth = std::max(counters_.max_queue_depth, queue_.size());
+    }
+    wake_.notify_one();
+    return true;
+}
+
+bool MicroBatcher::score(std::vector<uint8_t> jpg, float *score) {
+    auto result = std::make_shared<std::promise<float>>();
+    std::future<float> f = result->get_future();
+    if (!submit(std::move(jpg), [result](float s) { result->set_value(s); })) return false;
+    *score = f.get();
+    return true;
+}
+
+// Despacha quando há worker livre e o lote enche ou o frame mais antigo
+// completa a janela; com a fila vazia dorme até o próximo submit
+void MicroBatcher::dispatch_loop() {
+    const int workers = engine_.threads();
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return (stop_ || !queue_.empty()) && busy_ < workers; });
+        if (queue_.empty()) return;
+        const Clock::time_point deadline = queue_.front().enqueued + std::chrono::microseconds(cfg_.window_us);
+        wake_.wait_until(lock, deadline, [this] { return stop_ || queue_.size() >= (size_t)cfg_.max_batch; });
+
+        const size_t n = std::min(queue_.size(), (size_t)cfg_.max_batch);
+        auto batch = std::make_shared<std::vector<Request>>();
+        const Clock::time_point now = Clock::now();
+        for (size_t i = 0; i < n; i++) {
+            batch->push_back(std::move(queue_.front()));
+            queue_.pop_front();
+            wait_.add((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(now - batch->back().enqueued)
+                          .count());
+        }
+        counters_.batches++;
+        counters_.in_flight += n;
+        busy_++;
+        counters_.avg_batch += (n - counters_.avg_batch) / counters_.batches;
+
+        lock.unlock();
+        std::vector<std::vector<uint8_t>> jpgs(n);
+        for (size_t i = 0; i < n; i++) jpgs[i] = std::move((*batch)[i].jpg);
+        engine_.submit(std::move(jpgs), [this, batch](const float *scores, size_t count) {
+            const Clock::time_point end = Clock::now();
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                counters_.in_flight -= count;
+                busy_--;
+                for (size_t i = 0; i < count; i++) {
+                    if (scores[i] < 0.0f) counters_.failures++;
+                    total_.add((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                                   end - (*batch)[i].enqueued).count());
+                }
+            }
+            wake_.notify_all();
+            for (size_t i = 0; i < count; i++) (*batch)[i].done(scores[i]);
+        });
+        lock.lock();
+    }
+}
+
+BatcherMetrics MicroBatcher::metrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BatcherMetrics m = counters_;
+    m.queue_depth = queue_.size();
+    m.wait_p50_us = wait_.percentile(50);
+    m.wait_p95_us = wait_.percentile(95);
+    m.wait_p99_us = wait_.percentile(99);
+    m.total_p50_us = total_.percentile(50);
+    m.total_p95_us = total_.percentile(95);
+    m.total_p99_us = total_.percentile(99);
+    return m;
+}
+
+} // namespace fire
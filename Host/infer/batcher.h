@@ -0,0 +1,92 @@
+#pragma once
+// Micro-lotes para o servidor de inferência: frames que chegam de várias
+// conexões esperam no máximo window_us (ou até juntar max_batch) e seguem
+// como um lote para um worker livre do Engine. Só há um lote em execução por
+// worker: enquanto todos estão ocupados a fila cresce e o próximo lote sai
+// maior, em vez de acumular lotes pequenos na fila do pool. Expõe profundidade da fila e
+// latências (espera na fila e total) para o endpoint de métricas.
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "fire_infer.h"
+
+namespace fire {
+
+struct BatcherConfig {
+    int max_batch = 8;       // Frames por lote enviado a um worker
+    int window_us = 2000;    // Espera máxima do primeiro frame da fila
+    size_t max_queue = 1024; // Acima disso submit recusa (backpressure)
+};
+
+// Percentis sobre as últimas N amostras (microssegundos)
+class LatencyWindow {
+public:
+    explicit LatencyWindow(size_t capacity = 4096) : samples_(capacity) {}
+    void add(uint32_t us);
+    // p em [0, 100]; 0 se não há amostras
+    uint32_t percentile(double p) const;
+    size_t count() const { return filled_; }
+
+private:
+    std::vector<uint32_t> samples_;
+    size_t next_ = 0, filled_ = 0;
+};
+
+struct BatcherMetrics {
+    uint64_t requests = 0;  // Frames aceitos
+    uint64_t rejected = 0;  // Recusados com a fila cheia
+    uint64_t failures = 0;  // JPEG inválido
+    uint64_t batches = 0;
+    double avg_batch = 0;
+    size_t queue_depth = 0; // Esperando o dispatcher
+    size_t max_queue_depth = 0;
+    size_t in_flight = 0;   // Já despachados, sem resposta
+    uint32_t wait_p50_us = 0, wait_p95_us = 0, wait_p99_us = 0;
+    uint32_t total_p50_us = 0, total_p95_us = 0, total_p99_us = 0;
+};
+
+class MicroBatcher {
+public:
+    // done(score) roda em uma thread do Engine; score < 0 = falha de decode
+    using Done = std::function<void(float score)>;
+
+    MicroBatcher(Engine &engine, const BatcherConfig &cfg);
+    ~MicroBatcher();
+
+    bool submit(std::vector<uint8_t> jpg, Done done);
+    // Conveniência bloqueante; false se recusado (fila cheia), score < 0 se
+    // o JPEG é inválido
+    bool score(std::vector<uint8_t> jpg, float *score);
+
+    BatcherMetrics metrics() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Request {
+        std::vector<uint8_t> jpg;
+        Done done;
+        Clock::time_point enqueued;
+    };
+
+    void dispatch_loop();
+
+    Engine &engine_;
+    BatcherConfig cfg_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Request> queue_;
+    bool stop_ = false;
+    int busy_ = 0; // Lotes em execução (no máximo um por worker)
+    std::thread dispatcher_;
+
+    BatcherMetrics counters_;
+    LatencyWindow wait_, total_;
+};
+
+} // namespace fire
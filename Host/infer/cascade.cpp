@@ -0,0 +1,58 @@
+#include "cascade.h"
+#include <algorithm>
+#include <cstdlib>
+#include "dataset.h"
+
+namespace fire {
+
+std::unique_ptr<Cascade> Cascade::create(const CascadeConfig &cfg, std::string *error) {
+    std::unique_ptr<Cascade> c(new Cascade());
+    c->cfg_ = cfg;
+
+    InterpreterOptions options;
+    options.isa = cfg.isa;
+    options.external_arena = true;
+    std::shared_ptr<const TfliteModel> a = TfliteModel::load(cfg.first_model, error);
+    if (!a) return nullptr;
+    std::shared_ptr<const TfliteModel> b = TfliteModel::load(cfg.second_model, error);
+    if (!b) return nullptr;
+    c->first_ = Classifier::create(a, 1, cfg.gamma, error, options);
+    if (!c->first_) return nullptr;
+    c->second_ = Classifier::create(b, 1, cfg.gamma, error, options);
+    if (!c->second_) return nullptr;
+
+    c->arena_bytes_ = std::max(c->first_->interpreter().arena_bytes(), c->second_->interpreter().arena_bytes());
+    c->arena_.reset((uint8_t *)aligned_alloc(64, (std::max(c->arena_bytes_, (size_t)64) + 63) / 64 * 64));
+    if (!c->arena_) {
+        if (error) *error = "falha de memoria";
+        return nullptr;
+    }
+    c->first_->interpreter().bind_arena(c->arena_.get());
+    c->second_->interpreter().bind_arena(c->arena_.get());
+    return c;
+}
+
+size_t Cascade::separate_arena_bytes() const {
+    return first_->interpreter().arena_bytes() + second_->interpreter().arena_bytes();
+}
+
+bool Cascade::predict_rgb(const uint8_t *rgb, int w, int h, CascadeResult *r) {
+    *r = CascadeResult();
+    if (!first_->predict_rgb(rgb, w, h, &r->first)) return false;
+    r->score = r->first;
+    if (r->first < cfg_.band_lo || r->first > cfg_.band_hi) return true;
+
+    // A entrada do segundo modelo ocupa a mesma arena: pré-processa de novo
+    r->escalated = true;
+    if (!second_->predict_rgb(rgb, w, h, &r->second)) return false;
+    r->score = r->second;
+    return true;
+}
+
+bool Cascade::predict(const uint8_t *jpg, size_t len, CascadeResult *r) {
+    int w, h;
+    if (!jpeg_decode(jpg, len, rgb_, w, h)) return false;
+    return predict_rgb(rgb_.data(), w, h, r);
+}
+
+} // namespace fire
@@ -0,0 +1,57 @@
+#pragma once
+// Cascata de dois modelos com saída antecipada: o modelo barato roda em todo
+// frame e o segundo só quando o score do primeiro cai na faixa de incerteza.
+// Os dois rodam em sequência, então usam uma arena só (a maior das duas):
+// o score do primeiro é lido antes do segundo pré-processar a entrada.
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "fire_infer.h"
+
+namespace fire {
+
+struct CascadeConfig {
+    std::string first_model;  // Barato, roda em todo frame
+    std::string second_model; // Só na faixa de incerteza do primeiro
+    float band_lo = 0.20f;    // score do primeiro em [band_lo, band_hi] -> segundo modelo
+    float band_hi = 0.90f;
+    float gamma = 12.0f;
+    KernelIsa isa = kIsaAuto;
+};
+
+struct CascadeResult {
+    float score = 0.0f;  // Decisão da cascata (segundo modelo quando ele roda)
+    float first = 0.0f;
+    float second = -1.0f; // -1 se o segundo não rodou
+    bool escalated = false;
+};
+
+class Cascade {
+public:
+    static std::unique_ptr<Cascade> create(const CascadeConfig &cfg, std::string *error);
+
+    bool predict(const uint8_t *jpg, size_t len, CascadeResult *r);
+    bool predict_rgb(const uint8_t *rgb, int w, int h, CascadeResult *r);
+
+    // Cada modelo sozinho (mesma arena; comparações e calibração da faixa)
+    Classifier &first() { return *first_; }
+    Classifier &second() { return *second_; }
+    const CascadeConfig &config() const { return cfg_; }
+
+    size_t arena_bytes() const { return arena_bytes_; }
+    // Arenas separadas, como dois interpretadores independentes
+    size_t separate_arena_bytes() const;
+
+private:
+    Cascade() = default;
+
+    CascadeConfig cfg_;
+    std::unique_ptr<Classifier> first_, second_;
+    std::unique_ptr<uint8_t[], FreeDeleter> arena_;
+    size_t arena_bytes_ = 0;
+    std::vector<uint8_t> rgb_;
+};
+
+} // namespace fire
@@ -0,0 +1,80 @@
+#include "cpu_features.h"
+#include <cstdlib>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace fire {
+
+#if defined(__x86_64__) || defined(__i386__)
+static unsigned long long read_xcr0() {
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+}
+
+static CpuFeatures detect() {
+    CpuFeatures f;
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return f;
+    const bool osxsave = ecx & (1u << 27);
+    const bool avx = ecx & (1u << 28);
+    if (!osxsave || !avx) return f;
+
+    // O SO precisa salvar YMM (bits 1-2) e, para AVX-512, opmask/ZMM (bits 5-7)
+    const unsigned long long xcr0 = read_xcr0();
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;
+    const bool zmm_state = (xcr0 & 0xE6) == 0xE6;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return f;
+    f.avx2 = ymm_state && (ebx & (1u << 5));
+    const bool avx512f = ebx & (1u << 16);
+    const bool avx512bw = ebx & (1u << 30);
+    const bool avx512vl = ebx & (1u << 31);
+    const bool vnni = ecx & (1u << 11);
+    f.avx512_vnni = f.avx2 && zmm_state && avx512f && avx512bw && avx512vl && vnni;
+    return f;
+}
+#else
+static CpuFeatures detect() { return CpuFeatures(); }
+#endif
+
+const CpuFeatures &cpu_features() {
+    static const CpuFeatures f = detect();
+    return f;
+}
+
+KernelIsa resolve_kernel_isa(KernelIsa requested) {
+    if (requested == kIsaAuto) {
+        const char *env = getenv("FIRE_KERNELS");
+        requested = env ? parse_kernel_isa(env) : kIsaAuto;
+        if (requested == kIsaAuto) requested = kIsaAvx512Vnni;
+    }
+#ifndef FIRE_X86_KERNELS
+    return kIsaReference;
+#else
+    const CpuFeatures &f = cpu_features();
+    if (requested == kIsaAvx512Vnni && !f.avx512_vnni) requested = kIsaAvx2;
+    if (requested == kIsaAvx2 && !f.avx2) requested = kIsaReference;
+    return requested;
+#endif
+}
+
+const char *kernel_isa_name(KernelIsa isa) {
+    switch (isa) {
+    case kIsaReference: return "ref";
+    case kIsaAvx2: return "avx2";
+    case kIsaAvx512Vnni: return "vnni";
+    default: return "auto";
+    }
+}
+
+KernelIsa parse_kernel_isa(const char *name) {
+    if (!strcmp(name, "ref")) return kIsaReference;
+    if (!strcmp(name, "avx2")) return kIsaAvx2;
+    if (!strcmp(name, "vnni")) return kIsaAvx512Vnni;
+    return kIsaAuto;
+}
+
+} // namespace fire
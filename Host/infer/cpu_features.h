@@ -0,0 +1,27 @@
+#pragma once
+// Detecção de extensões x86 (CPUID + XGETBV) e escolha dos kernels int8.
+
+namespace fire {
+
+enum KernelIsa {
+    kIsaAuto = -1,      // Melhor disponível (ou FIRE_KERNELS=ref|avx2|vnni)
+    kIsaReference = 0,  // Kernels _ref, portáveis
+    kIsaAvx2 = 1,       // Depthwise 3x3 e pointwise em AVX2
+    kIsaAvx512Vnni = 2, // Pointwise com VPDPBUSD (AVX-512 VNNI); depthwise em AVX2
+};
+
+struct CpuFeatures {
+    bool avx2 = false;
+    bool avx512_vnni = false; // AVX-512 F/BW/VL/VNNI com estado salvo pelo SO
+};
+
+const CpuFeatures &cpu_features();
+
+// Resolve kIsaAuto e rebaixa pedidos que a CPU (ou o build) não suporta
+KernelIsa resolve_kernel_isa(KernelIsa requested);
+
+const char *kernel_isa_name(KernelIsa isa);
+// "ref", "avx2", "vnni"; retorna kIsaAuto para nomes desconhecidos
+KernelIsa parse_kernel_isa(const char *name);
+
+} // namespace fire
@@ -0,0 +1,203 @@
+#include "fire_infer.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include "dataset.h"
+#include "preprocess.h"
+
+namespace fire {
+
+std::unique_ptr<Classifier> Classifier::create(std::shared_ptr<const TfliteModel> model, int batch,
+                                               float gamma, std::string *error, const InterpreterOptions &options) {
+    std::unique_ptr<Classifier> c(new Classifier());
+    c->interp_ = Interpreter::create(std::move(model), batch, error, options);
+    if (!c->interp_) return nullptr;
+
+    const TensorInfo &in = c->interp_->input_info();
+    if (in.shape.size() != 4 || in.shape[1] != DST_H || in.shape[2] != DST_W || in.shape[3] != 3) {
+        if (error) *error = "entrada do modelo deve ser 1x96x96x3";
+        return nullptr;
+    }
+    if (in.type != kTypeUInt8) c->input_.resize(DST_W * DST_H * 3);
+
+    const TensorInfo &out = c->interp_->output_info();
+    c->fire_idx_ = (out.shape.size() == 2 && out.shape[1] == 1) ? 0 : 1;
+    preprocess_build_gamma_lut(gamma, c->lut_);
+    return c;
+}
+
+std::unique_ptr<Classifier> Classifier::clone(std::string *error) const {
+    std::unique_ptr<Classifier> c(new Classifier());
+    c->interp_ = interp_->clone(error);
+    if (!c->interp_) return nullptr;
+    memcpy(c->lut_, lut_, sizeof(lut_));
+    c->input_.resize(input_.size());
+    c->fire_idx_ = fire_idx_;
+    return c;
+}
+
+// Pré-processa um frame RGB no slot do lote (recorte central + resize + gamma)
+bool Classifier::load_slot(int slot, const uint8_t *rgb, int w, int h) {
+    const int crop = std::min(w, h);
+    return load_crop(slot, rgb, w, h, (w - crop) / 2, (h - crop) / 2, crop);
+}
+
+bool Classifier::load_crop(int slot, const uint8_t *rgb, int w, int h, int x, int y, int size) {
+    const TensorInfo &in = interp_->input_info();
+    uint8_t *dst = interp_->input(slot);
+    if (in.type == kTypeUInt8) {
+        preprocess_crop(rgb, w, h, x, y, size, lut_, dst, nullptr, nullptr);
+        return true;
+    }
+
+    preprocess_crop(rgb, w, h, x, y, size, lut_, input_.data(), nullptr, nullptr);
+    return normalize_input(slot);
+}
+
+// Mesma normalização do run_model do firmware para entradas int8 (input_ -> slot)
+bool Classifier::normalize_input(int slot) {
+    const TensorInfo &in = interp_->input_info();
+    if (in.type != kTypeInt8) return false;
+    int8_t *in_i8 = (int8_t *)interp_->input(slot);
+    for (int i = 0; i < DST_W * DST_H * 3; i++) {
+        in_i8[i] = (int8_t)((input_[i] / 255.0f) / in.scale() + in.zero_point());
+    }
+    return true;
+}
+
+float Classifier::read_score(int slot) const {
+    const TensorInfo &out = interp_->output_info();
+    const uint8_t *o = interp_->output(slot);
+    if (out.type == kTypeUInt8) return o[fire_idx_] / 255.0f;
+    if (out.type == kTypeInt8) return ((int)(int8_t)o[fire_idx_] - out.zero_point()) * out.scale();
+    return 0.0f;
+}
+
+bool Classifier::predict_rgb(const uint8_t *rgb, int w, int h, float *score) {
+    if (!load_slot(0, rgb, w, h) || !interp_->invoke()) return false;
+    *score = read_score(0);
+    return true;
+}
+
+bool Classifier::predict_crop(const uint8_t *rgb, int w, int h, int x, int y, int size, float *score) {
+    if (!load_crop(0, rgb, w, h, x, y, size) || !interp_->invoke()) return false;
+    *score = read_score(0);
+    return true;
+}
+
+bool Classifier::predict_input(const uint8_t *input, float *score) {
+    if (interp_->input_info().type == kTypeUInt8) {
+        memcpy(interp_->input(0), input, DST_W * DST_H * 3);
+    } else {
+        memcpy(input_.data(), input, DST_W * DST_H * 3);
+        if (!normalize_input(0)) return false;
+    }
+    if (!interp_->invoke()) return false;
+    *score = read_score(0);
+    return true;
+}
+
+bool Classifier::predict(const uint8_t *jpg, size_t len, float *score) {
+    int w, h;
+    if (!jpeg_decode(jpg, len, rgb_, w, h)) return false;
+    return predict_rgb(rgb_.data(), w, h, score);
+}
+
+int Classifier::predict_batch(const uint8_t *const *jpgs, const size_t *lens, size_t n, float *scores) {
+    int ok = 0;
+    for (size_t start = 0; start < n; start += batch()) {
+        const size_t count = std::min(n - start, (size_t)batch());
+        std::vector<char> valid(count);
+        for (size_t i = 0; i < count; i++) {
+            int w, h;
+            valid[i] = jpgs[start + i] && jpeg_decode(jpgs[start + i], lens[start + i], rgb_, w, h) &&
+                       load_slot((int)i, rgb_.data(), w, h);
+        }
+        const bool ran = interp_->invoke();
+        for (size_t i = 0; i < count; i++) {
+            scores[start + i] = (ran && valid[i]) ? read_score((int)i) : -1.0f;
+            if (ran && valid[i]) ok++;
+        }
+    }
+    return ok;
+}
+
+std::unique_ptr<Engine> Engine::create(const EngineConfig &cfg, std::string *error) {
+    std::unique_ptr<Engine> e(new Engine());
+    e->cfg_ = cfg;
+    e->model_ = TfliteModel::load(cfg.model_path, error);
+    if (!e->model_) return nullptr;
+
+    InterpreterOptions options;
+    options.isa = cfg.isa;
+    options.fuse = cfg.fuse;
+    std::unique_ptr<Classifier> first = Classifier::create(e->model_, std::max(cfg.batch, 1), cfg.gamma, error, options);
+    if (!first) return nullptr;
+
+    int threads = cfg.threads > 0 ? cfg.threads : (int)std::thread::hardware_concurrency();
+    threads = std::max(threads, 1);
+    if (cfg.memory_budget) {
+        // Um invoke em branco leva os buffers de trabalho ao tamanho final
+        Interpreter &interp = first->interpreter();
+        interp.invoke();
+        const size_t per_instance = interp.memory_bytes();
+        const size_t shared = interp.packed_bytes();
+        const size_t fit = cfg.memory_budget > shared ? (cfg.memory_budget - shared) / per_instance : 0;
+        if (fit < 1) {
+            if (error)
+                *error = "orcamento de memoria insuficiente (" + std::to_string(per_instance / 1024) +
+                         " KB por instancia + " + std::to_string(shared / 1024) + " KB de pesos)";
+            return nullptr;
+        }
+        threads = (int)std::min((size_t)threads, fit);
+    }
+
+    e->pool_.reset(new ThreadPool(threads));
+    e->workers_.push_back(std::move(first));
+    for (int i = 1; i < e->pool_->size(); i++) {
+        std::unique_ptr<Classifier> c = e->workers_[0]->clone(error);
+        if (!c) return nullptr;
+        e->workers_.push_back(std::move(c));
+    }
+    return e;
+}
+
+void Engine::score(size_t n, const JpegSource &source, float *scores) {
+    const size_t batch = (size_t)std::max(cfg_.batch, 1);
+    const size_t tasks = (n + batch - 1) / batch;
+
+    // Uma tarefa por lote; cada worker usa seu próprio Classifier
+    pool_->parallel_for(tasks, [&](size_t t, int worker) {
+        const size_t start = t * batch;
+        const size_t count = std::min(n - start, batch);
+        std::vector<std::vector<uint8_t>> bufs(count);
+        std::vector<const uint8_t *> ptrs(count, nullptr);
+        std::vector<size_t> lens(count, 0);
+        for (size_t i = 0; i < count; i++) {
+            if (source(start + i, bufs[i])) {
+                ptrs[i] = bufs[i].data();
+                lens[i] = bufs[i].size();
+            }
+        }
+        workers_[worker]->predict_batch(ptrs.data(), lens.data(), count, scores + start);
+    });
+}
+
+void Engine::submit(std::vector<std::vector<uint8_t>> jpgs, BatchDone done) {
+    auto frames = std::make_shared<std::vector<std::vector<uint8_t>>>(std::move(jpgs));
+    pool_->submit([this, frames, done](int worker) {
+        const size_t n = frames->size();
+        std::vector<const uint8_t *> ptrs(n, nullptr);
+        std::vector<size_t> lens(n, 0);
+        std::vector<float> scores(n, -1.0f);
+        for (size_t i = 0; i < n; i++) {
+            if ((*frames)[i].empty()) continue;
+            ptrs[i] = (*frames)[i].data();
+            lens[i] = (*frames)[i].size();
+        }
+        workers_[worker]->predict_batch(ptrs.data(), lens.data(), n, scores.data());
+        done(scores.data(), n);
+    });
+}
+
+} // namespace fire
@@ -0,0 +1,100 @@
+#pragma once
+// Motor de inferência do modelo de fogo para Linux (NVR): mesmo grafo int8 e
+// mesmo pré-processamento do classifier_predict do firmware.
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "interpreter.h"
+#include "thread_pool.h"
+
+namespace fire {
+
+// Um interpretador + buffers; não é thread-safe (um por thread)
+class Classifier {
+public:
+    static std::unique_ptr<Classifier> create(std::shared_ptr<const TfliteModel> model, int batch,
+                                              float gamma, std::string *error,
+                                              const InterpreterOptions &options = InterpreterOptions());
+    // Mesma configuração, com os pesos reempacotados compartilhados
+    std::unique_ptr<Classifier> clone(std::string *error) const;
+
+    // Score de fogo em [0, 1], na mesma escala do classifier_predict
+    bool predict(const uint8_t *jpg, size_t len, float *score);
+    bool predict_rgb(const uint8_t *rgb, int w, int h, float *score);
+    // Recorte quadrado (x, y, size) do frame, como o classifier_predict_crops
+    bool predict_crop(const uint8_t *rgb, int w, int h, int x, int y, int size, float *score);
+    // Entrada já pré-processada (DST_W x DST_H x 3 RGB, antes da normalização do modelo)
+    bool predict_input(const uint8_t *input, float *score);
+    // Até batch() frames em um único invoke; frames inválidos recebem -1.
+    // Retorna quantos foram pontuados.
+    int predict_batch(const uint8_t *const *jpgs, const size_t *lens, size_t n, float *scores);
+
+    int batch() const { return interp_->batch(); }
+    Interpreter &interpreter() { return *interp_; }
+    const Interpreter &interpreter() const { return *interp_; }
+
+private:
+    Classifier() = default;
+    bool load_slot(int slot, const uint8_t *rgb, int w, int h);
+    bool load_crop(int slot, const uint8_t *rgb, int w, int h, int x, int y, int size);
+    bool normalize_input(int slot);
+    float read_score(int slot) const;
+
+    std::unique_ptr<Interpreter> interp_;
+    uint8_t lut_[256];
+    std::vector<uint8_t> rgb_;   // Frame decodificado
+    std::vector<uint8_t> input_; // Só quando a entrada do modelo não é uint8
+    int fire_idx_ = 0;
+};
+
+struct EngineConfig {
+    std::string model_path;
+    float gamma = 12.0f; // Mesmo valor do classifier_init no main.cpp
+    int threads = 0;     // 0 = todos os núcleos
+    int batch = 1;       // Frames por invoke em cada thread
+    KernelIsa isa = kIsaAuto;
+    bool fuse = true;    // Blocos invertidos fundidos (InterpreterOptions)
+    // Teto de memória para todas as instâncias (arenas + buffers de trabalho
+    // dos kernels + pesos compartilhados, sem o buffer de decode do JPEG, que
+    // depende da resolução); limita o número de workers. 0 = sem teto.
+    size_t memory_budget = 0;
+};
+
+// Fonte de frames: escreve o JPEG i em buf; false se indisponível
+using JpegSource = std::function<bool(size_t i, std::vector<uint8_t> &buf)>;
+
+// Pool de threads com um Classifier por worker; os workers compartilham os
+// pesos reempacotados e cada um tem só a sua arena de ativações
+class Engine {
+public:
+    static std::unique_ptr<Engine> create(const EngineConfig &cfg, std::string *error);
+
+    // Pontua n frames distribuídos entre os workers; falhas recebem -1
+    void score(size_t n, const JpegSource &source, float *scores);
+
+    // Assíncrono: os frames viram um lote em um worker livre, que chama
+    // done(scores, n) na própria thread; falhas recebem -1
+    using BatchDone = std::function<void(const float *scores, size_t n)>;
+    void submit(std::vector<std::vector<uint8_t>> jpgs, BatchDone done);
+    // Espera todos os submit pendentes
+    void wait() { pool_->wait(); }
+
+    int threads() const { return pool_->size(); }
+    KernelIsa isa() const { return workers_[0]->interpreter().isa(); }
+    size_t packed_bytes() const { return workers_[0]->interpreter().packed_bytes(); }
+    const Interpreter &interpreter() const { return workers_[0]->interpreter(); }
+    const TfliteModel &model() const { return *model_; }
+
+private:
+    Engine() = default;
+
+    EngineConfig cfg_;
+    std::shared_ptr<const TfliteModel> model_;
+    std::unique_ptr<ThreadPool> pool_;
+    std::vector<std::unique_ptr<Classifier>> workers_;
+};
+
+} // namespace fire
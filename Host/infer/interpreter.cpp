@@ -0,0 +1,678 @@
+#include "interpreter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include "memory_planner.h"
+#include "quant.h"
+
+namespace fire {
+
+// Implementação escolhida no prepare para CONV_2D / DEPTHWISE_CONV_2D / FULLY_CONNECTED
+enum OpKernel {
+    kKernelRef,         // Kernels _ref sobre os pesos do flatbuffer
+    kKernelGemm,        // Conv 1x1 stride 1 ou fully connected: GEMM direto na ativação
+    kKernelIm2colGemm,  // Demais CONV_2D: im2col + GEMM
+    kKernelDepthwise3x3 // Depthwise 3x3 dm 1
+};
+
+// Operador preparado: formas, parâmetros quantizados e ponteiros já resolvidos
+struct Interpreter::Op {
+    int builtin = -1;
+    int kernel = kKernelRef;
+    int in0 = -1, in1 = -1, out = -1;
+    Shape4 s_in0, s_in1, s_out, s_filter;
+    const int8_t *filter = nullptr;
+
+    ConvParams conv;
+    std::vector<int32_t> multiplier, shift, bias;
+    FullyConnectedParams fc;
+    AddParams add;
+    MulParams mul;
+    MeanParams mean;
+    LogisticParams logistic;
+    RequantizeParams requant;
+    size_t bytes = 0; // RESHAPE / QUANTIZE: bytes por invoke
+    PackedWeights packed; // Pesos reempacotados para os kernels x86
+
+    // Bloco fundido: o primeiro operador guarda quantos o bloco cobre (3 ou 4,
+    // com o ADD) e a altura da faixa de saída; os demais são pulados no invoke
+    int fused = 0;
+    bool fused_member = false;
+    int tile_rows = 0;
+};
+
+static const size_t kAlign = 64;
+static const size_t kNoBuffer = (size_t)-1;
+// Alvo para as linhas da expansão mantidas por faixa (cabe no L2 com folga)
+static const size_t kFusedTileBytes = 64 * 1024;
+// Linhas por chamada do GEMM (múltiplo da altura do tile de 4 linhas)
+static const size_t kGemmRowBlock = 256;
+
+static bool is_8bit(int type) { return type == kTypeInt8 || type == kTypeUInt8; }
+
+// Forma 4D NHWC a partir de uma forma de posto <= 4 (completa à esquerda com 1)
+static Shape4 to_shape4(const std::vector<int> &shape) {
+    int d[4] = {1, 1, 1, 1};
+    size_t r = shape.size() > 4 ? 4 : shape.size();
+    for (size_t i = 0; i < r; i++) d[4 - r + i] = shape[shape.size() - r + i];
+    Shape4 s;
+    s.n = d[0];
+    s.h = d[1];
+    s.w = d[2];
+    s.c = d[3];
+    return s;
+}
+
+#ifdef FIRE_X86_KERNELS
+static void pack_gemm(KernelIsa isa, const int8_t *w, int out_c, int in_c, const int32_t *bias,
+                      const int32_t *mult, const int32_t *shift, int32_t input_offset, PackedWeights *packed) {
+    if (isa == kIsaAvx512Vnni) pack_gemm_vnni(w, out_c, in_c, bias, mult, shift, input_offset, packed);
+    else pack_gemm_avx2(w, out_c, in_c, bias, mult, shift, input_offset, packed);
+}
+#endif
+
+static int compute_padding(int stride, int dilation, int in_size, int filter_size, int out_size) {
+    int effective = (filter_size - 1) * dilation + 1;
+    int total = (out_size - 1) * stride + effective - in_size;
+    return total > 0 ? total / 2 : 0;
+}
+
+std::unique_ptr<Interpreter> Interpreter::create(std::shared_ptr<const TfliteModel> model, int batch,
+                                                 std::string *error, const InterpreterOptions &options) {
+    if (!model || batch < 1) {
+        if (error) *error = "parametros invalidos";
+        return nullptr;
+    }
+    std::unique_ptr<Interpreter> it(new Interpreter());
+    it->model_ = std::move(model);
+    it->batch_ = batch;
+    it->isa_ = resolve_kernel_isa(options.isa);
+    it->preserve_all_ = options.preserve_all_tensors;
+    it->external_arena_ = options.external_arena;
+    if (!it->prepare(error)) return nullptr;
+#ifdef FIRE_X86_KERNELS
+    if (options.fuse) it->fuse_blocks();
+#endif
+    if (!it->plan_arena(error)) return nullptr;
+    return it;
+}
+
+std::unique_ptr<Interpreter> Interpreter::clone(std::string *error) const {
+    std::unique_ptr<Interpreter> it(new Interpreter());
+    it->model_ = model_;
+    it->batch_ = batch_;
+    it->isa_ = isa_;
+    it->preserve_all_ = preserve_all_;
+    // Sempre com arena própria: a externa do original não vale para o clone
+    it->external_arena_ = false;
+    it->input_bytes_ = input_bytes_;
+    it->output_bytes_ = output_bytes_;
+    it->fused_blocks_ = fused_blocks_;
+    it->fused_saved_ = fused_saved_;
+    it->ops_ = ops_;
+    // ConvParams aponta para os vetores do próprio Op
+    for (Op &op : it->ops_) {
+        if (op.builtin != kOpConv2D && op.builtin != kOpDepthwiseConv2D) continue;
+        op.conv.multiplier = op.multiplier.data();
+        op.conv.shift = op.shift.data();
+    }
+    it->buffers_.assign(model_->tensors().size(), nullptr);
+    if (!it->plan_arena(error)) return nullptr;
+    return it;
+}
+
+Interpreter::~Interpreter() = default;
+
+const TensorInfo &Interpreter::input_info() const { return model_->tensors()[model_->inputs()[0]]; }
+const TensorInfo &Interpreter::output_info() const { return model_->tensors()[model_->outputs()[0]]; }
+
+uint8_t *Interpreter::input(int b) { return buffers_[model_->inputs()[0]] + (size_t)b * input_bytes_; }
+
+const uint8_t *Interpreter::output(int b) const {
+    return buffers_[model_->outputs()[0]] + (size_t)b * output_bytes_;
+}
+
+size_t Interpreter::tensor_bytes(int tensor) const {
+    const TensorInfo &t = model_->tensors()[tensor];
+    return t.is_constant() ? t.data_size : shape_of(tensor).size();
+}
+
+Shape4 Interpreter::shape_of(int tensor) const {
+    const TensorInfo &t = model_->tensors()[tensor];
+    Shape4 s = to_shape4(t.shape);
+    if (!t.is_constant()) s.n *= batch_;
+    return s;
+}
+
+uint8_t *Interpreter::buffer(int tensor) const {
+    const TensorInfo &t = model_->tensors()[tensor];
+    return t.is_constant() ? const_cast<uint8_t *>(t.data) : buffers_[tensor];
+}
+
+bool Interpreter::prepare(std::string *error) {
+    const std::vector<TensorInfo> &tensors = model_->tensors();
+    if (model_->inputs().size() != 1 || model_->outputs().size() != 1) {
+        if (error) *error = "modelo deve ter uma entrada e uma saida";
+        return false;
+    }
+
+    // Os buffers só são posicionados na arena depois da fusão (plan_arena)
+    buffers_.assign(tensors.size(), nullptr);
+    for (size_t i = 0; i < tensors.size(); i++) {
+        const TensorInfo &t = tensors[i];
+        if (t.is_constant()) continue;
+        if (!is_8bit(t.type)) {
+            if (error) *error = "tensor de ativacao nao int8/uint8: " + t.name;
+            return false;
+        }
+        if (!t.shape.empty() && t.shape[0] != 1) {
+            if (error) *error = "modelo com lote fixo != 1: " + t.name;
+            return false;
+        }
+    }
+    input_bytes_ = tensors[model_->inputs()[0]].num_elements();
+    output_bytes_ = tensors[model_->outputs()[0]].num_elements();
+
+    ops_.resize(model_->operators().size());
+    for (size_t i = 0; i < ops_.size(); i++) {
+        if (!prepare_op(model_->operators()[i], &ops_[i], error)) return false;
+    }
+    return true;
+}
+
+// Cada passo do invoke (um bloco fundido conta como um) marca os tensores que
+// toca; o intervalo [primeiro, último] passo define o tempo de vida. Tensores
+// eliminados pela fusão não aparecem em nenhum passo e ficam sem buffer.
+bool Interpreter::plan_arena(std::string *error) {
+    const std::vector<TensorInfo> &tensors = model_->tensors();
+    std::vector<TensorLifetime> life(tensors.size());
+    std::vector<char> used(tensors.size(), 0);
+    auto touch = [&](int t, int step) {
+        if (t < 0 || tensors[t].is_constant()) return;
+        TensorLifetime &l = life[t];
+        if (!used[t]) {
+            used[t] = 1;
+            l.first = l.last = step;
+        }
+        l.first = std::min(l.first, step);
+        l.last = std::max(l.last, step);
+    };
+
+    int step = 0;
+    for (size_t i = 0; i < ops_.size(); i++) {
+        const Op &op = ops_[i];
+        if (op.fused_member) continue;
+        if (op.fused) {
+            // A entrada do bloco (também o residual) é lida até a última faixa
+            touch(op.in0, step);
+            touch(ops_[i + op.fused - 1].out, step);
+        } else {
+            touch(op.in0, step);
+            touch(op.in1, step);
+            touch(op.out, step);
+        }
+        step++;
+    }
+    // Entrada escrita antes do invoke, saída lida depois dele
+    touch(model_->inputs()[0], 0);
+    touch(model_->outputs()[0], step);
+
+    unplanned_bytes_ = 0;
+    for (size_t t = 0; t < tensors.size(); t++) {
+        if (!used[t]) continue;
+        life[t].bytes = tensor_bytes((int)t);
+        unplanned_bytes_ += (life[t].bytes + kAlign - 1) / kAlign * kAlign;
+        if (preserve_all_) {
+            life[t].first = 0;
+            life[t].last = step;
+        }
+    }
+
+    arena_bytes_ = plan_memory(life, kAlign, &offsets_);
+    for (size_t t = 0; t < tensors.size(); t++)
+        if (!used[t]) offsets_[t] = kNoBuffer;
+    if (external_arena_) return true;
+
+    arena_.reset((uint8_t *)aligned_alloc(kAlign, std::max(arena_bytes_, kAlign)));
+    if (!arena_) {
+        if (error) *error = "falha de memoria";
+        return false;
+    }
+    memset(arena_.get(), 0, arena_bytes_);
+    bind_arena(arena_.get());
+    return true;
+}
+
+void Interpreter::bind_arena(uint8_t *base) {
+    for (size_t t = 0; t < buffers_.size(); t++) buffers_[t] = offsets_[t] == kNoBuffer ? nullptr : base + offsets_[t];
+}
+
+bool Interpreter::prepare_op(const OperatorInfo &info, Op *op, std::string *error) {
+    const std::vector<TensorInfo> &tensors = model_->tensors();
+    auto fail = [&](const std::string &msg) {
+        if (error) *error = std::string(builtin_op_name(info.builtin)) + ": " + msg;
+        return false;
+    };
+
+    op->builtin = info.builtin;
+    if (info.inputs.empty() || info.outputs.empty() || info.inputs[0] < 0) return fail("operandos invalidos");
+    op->in0 = info.inputs[0];
+    op->in1 = info.inputs.size() > 1 ? info.inputs[1] : -1;
+    op->out = info.outputs[0];
+    const TensorInfo &in = tensors[op->in0];
+    const TensorInfo &out = tensors[op->out];
+    if (out.is_constant()) return fail("saida constante");
+    op->s_in0 = shape_of(op->in0);
+    op->s_out = shape_of(op->out);
+
+    switch (info.builtin) {
+    case kOpConv2D:
+    case kOpDepthwiseConv2D: {
+        if (op->in1 < 0) return fail("sem filtro");
+        const TensorInfo &filter = tensors[op->in1];
+        if (in.type != kTypeInt8 || filter.type != kTypeInt8 || out.type != kTypeInt8 || !filter.is_constant())
+            return fail("so int8 com filtro constante");
+        op->filter = (const int8_t *)filter.data;
+        op->s_filter = to_shape4(filter.shape);
+        const bool dw = info.builtin == kOpDepthwiseConv2D;
+        const int out_c = op->s_out.c;
+
+        ConvParams &p = op->conv;
+        p.stride_w = info.stride_w;
+        p.stride_h = info.stride_h;
+        p.dilation_w = info.dilation_w;
+        p.dilation_h = info.dilation_h;
+        p.depth_multiplier = dw ? info.depth_multiplier : 1;
+        if (dw && p.depth_multiplier * op->s_in0.c != out_c) p.depth_multiplier = out_c / op->s_in0.c;
+        if (info.padding == kPaddingSame) {
+            p.pad_w = compute_padding(p.stride_w, p.dilation_w, op->s_in0.w, op->s_filter.w, op->s_out.w);
+            p.pad_h = compute_padding(p.stride_h, p.dilation_h, op->s_in0.h, op->s_filter.h, op->s_out.h);
+        }
+        p.input_offset = -in.zero_point();
+        p.output_offset = out.zero_point();
+        CalculateActivationRangeQuantized(info.activation, out.scale(), out.zero_point(), -128, 127,
+                                          &p.act_min, &p.act_max);
+
+        // Multiplicadores por canal (PopulateConvolutionQuantizationParams)
+        op->multiplier.resize(out_c);
+        op->shift.resize(out_c);
+        for (int c = 0; c < out_c; c++) {
+            float fs = filter.scales.size() > 1 ? filter.scales[c] : filter.scale();
+            double real = (double)in.scale() * (double)fs / (double)out.scale();
+            QuantizeMultiplier(real, &op->multiplier[c], &op->shift[c]);
+        }
+        p.multiplier = op->multiplier.data();
+        p.shift = op->shift.data();
+
+        if (info.inputs.size() > 2 && info.inputs[2] >= 0) {
+            const TensorInfo &bias = tensors[info.inputs[2]];
+            if (bias.type != kTypeInt32 || bias.data_size < out_c * sizeof(int32_t)) return fail("bias invalido");
+            op->bias.resize(out_c);
+            memcpy(op->bias.data(), bias.data, out_c * sizeof(int32_t));
+        }
+
+#ifdef FIRE_X86_KERNELS
+        // Pesos reempacotados uma vez aqui; o invoke só percorre os painéis
+        const int32_t *bias_ptr = op->bias.empty() ? nullptr : op->bias.data();
+        if (isa_ >= kIsaAvx2 && !dw) {
+            const bool pointwise = op->s_filter.h == 1 && op->s_filter.w == 1 && p.stride_w == 1 && p.stride_h == 1;
+            const int k = op->s_filter.h * op->s_filter.w * op->s_filter.c;
+            pack_gemm(isa_, op->filter, out_c, k, bias_ptr, p.multiplier, p.shift, p.input_offset, &op->packed);
+            op->kernel = pointwise ? kKernelGemm : kKernelIm2colGemm;
+        } else if (isa_ >= kIsaAvx2 && op->s_filter.h == 3 && op->s_filter.w == 3 && p.depth_multiplier == 1 &&
+                   p.dilation_w == 1 && p.dilation_h == 1) {
+            pack_depthwise3x3_avx2(op->filter, out_c, bias_ptr, p.multiplier, p.shift, &op->packed);
+            op->kernel = kKernelDepthwise3x3;
+        }
+#endif
+        return true;
+    }
+
+    case kOpFullyConnected: {
+        if (op->in1 < 0) return fail("sem pesos");
+        const TensorInfo &filter = tensors[op->in1];
+        if (in.type != kTypeInt8 || filter.type != kTypeInt8 || out.type != kTypeInt8 || !filter.is_constant())
+            return fail("so int8 com pesos constantes");
+        op->filter = (const int8_t *)filter.data;
+        op->s_filter = to_shape4(filter.shape);
+
+        FullyConnectedParams &p = op->fc;
+        p.input_offset = -in.zero_point();
+        p.filter_offset = -filter.zero_point();
+        p.output_offset = out.zero_point();
+        // GetQuantizedConvolutionMultipler: produto das escalas em float
+        double real = (double)(in.scale() * filter.scale()) / (double)out.scale();
+        QuantizeMultiplier(real, &p.multiplier, &p.shift);
+        CalculateActivationRangeQuantized(info.activation, out.scale(), out.zero_point(), -128, 127,
+                                          &p.act_min, &p.act_max);
+
+        const int out_depth = filter.shape.empty() ? 1 : filter.shape[0];
+        if (info.inputs.size() > 2 && info.inputs[2] >= 0) {
+            const TensorInfo &bias = tensors[info.inputs[2]];
+            if (bias.type != kTypeInt32 || bias.data_size < out_depth * sizeof(int32_t)) return fail("bias invalido");
+            op->bias.resize(out_depth);
+            memcpy(op->bias.data(), bias.data, out_depth * sizeof(int32_t));
+        }
+
+#ifdef FIRE_X86_KERNELS
+        // Pesos int8 simétricos (offset 0): mesmo GEMM das convs, com o
+        // multiplicador único repetido por canal
+        if (isa_ >= kIsaAvx2 && p.filter_offset == 0) {
+            op->multiplier.assign(out_depth, p.multiplier);
+            op->shift.assign(out_depth, p.shift);
+            pack_gemm(isa_, op->filter, out_depth, op->s_filter.c, op->bias.empty() ? nullptr : op->bias.data(),
+                      op->multiplier.data(), op->shift.data(), p.input_offset, &op->packed);
+            op->kernel = kKernelGemm;
+        }
+#endif
+        return true;
+    }
+
+    case kOpAdd:
+    case kOpMul: {
+        if (op->in1 < 0) return fail("sem segundo operando");
+        const TensorInfo &in2 = tensors[op->in1];
+        if (in.type != kTypeInt8 || in2.type != kTypeInt8 || out.type != kTypeInt8) return fail("so int8");
+        op->s_in1 = shape_of(op->in1);
+        if (info.builtin == kOpAdd) {
+            AddParams &p = op->add;
+            p.input1_offset = -in.zero_point();
+            p.input2_offset = -in2.zero_point();
+            p.output_offset = out.zero_point();
+            p.left_shift = 20;
+            const double twice_max_input_scale = 2 * (double)std::max(in.scale(), in2.scale());
+            QuantizeMultiplier((double)in.scale() / twice_max_input_scale, &p.input1_multiplier, &p.input1_shift);
+            QuantizeMultiplier((double)in2.scale() / twice_max_input_scale, &p.input2_multiplier, &p.input2_shift);
+            QuantizeMultiplier(twice_max_input_scale / ((1 << p.left_shift) * (double)out.scale()),
+                               &p.output_multiplier, &p.output_shift);
+            CalculateActivationRangeQuantized(info.activation, out.scale(), out.zero_point(), -128, 127,
+                                              &p.act_min, &p.act_max);
+        } else {
+            MulParams &p = op->mul;
+            p.input1_offset = -in.zero_point();
+            p.input2_offset = -in2.zero_point();
+            p.output_offset = out.zero_point();
+            QuantizeMultiplier((double)in.scale() * (double)in2.scale() / (double)out.scale(),
+                               &p.output_multiplier, &p.output_shift);
+            CalculateActivationRangeQuantized(info.activation, out.scale(), out.zero_point(), -128, 127,
+                                              &p.act_min, &p.act_max);
+        }
+        return true;
+    }
+
+    case kOpMean: {
+        if (in.type != kTypeInt8 || out.type != kTypeInt8) return fail("so int8");
+        // Só a média global (eixos 1 e 2) do MobileNetV2
+        const TensorInfo *axes = op->in1 >= 0 ? &tensors[op->in1] : nullptr;
+        if (!axes || !axes->is_constant() || axes->type != kTypeInt32 || axes->data_size != 8 ||
+            in.shape.size() != 4)
+            return fail("eixos nao suportados");
+        int32_t ax[2];
+        memcpy(ax, axes->data, 8);
+        if (std::min(ax[0], ax[1]) != 1 || std::max(ax[0], ax[1]) != 2) return fail("eixos nao suportados");
+        MeanParams &p = op->mean;
+        p.input_zero_point = in.zero_point();
+        p.output_zero_point = out.zero_point();
+        if (info.keep_dims) p.path = kMeanIntegerOps;
+        else if (in.zero_point() == out.zero_point() && in.scale() == out.scale()) p.path = kMeanSameQuant;
+        else p.path = kMeanRescale;
+        QuantizeMultiplier((double)in.scale() / (double)out.scale(), &p.multiplier, &p.shift);
+        return true;
+    }
+
+    case kOpLogistic: {
+        if (in.type != kTypeInt8 || out.type != kTypeInt8) return fail("so int8");
+        if (out.zero_point() != -128) return fail("zero point de saida deve ser -128");
+        static const int kInputIntegerBits = 4;
+        LogisticParams &p = op->logistic;
+        p.input_zero_point = in.zero_point();
+        const double input_real_multiplier = (double)in.scale() * (double)(1 << (31 - kInputIntegerBits));
+        const double q = std::frexp(input_real_multiplier, &p.input_left_shift);
+        p.input_multiplier = (int32_t)std::round(q * (1ll << 31));
+        // CalculateInputRadius
+        const double max_input_rescaled = 1.0 * ((1 << kInputIntegerBits) - 1) *
+                                          (1ll << (31 - kInputIntegerBits)) / (1ll << p.input_left_shift);
+        p.input_range_radius = (int32_t)std::floor(max_input_rescaled);
+        return true;
+    }
+
+    case kOpQuantize: {
+        if (!is_8bit(in.type) || !is_8bit(out.type)) return fail("so entre tipos de 8 bits");
+        RequantizeParams &p = op->requant;
+        QuantizeMultiplier((double)in.scale() / (double)out.scale(), &p.multiplier, &p.shift);
+        p.input_zero_point = in.zero_point();
+        p.output_zero_point = out.zero_point();
+        p.input_signed = in.type == kTypeInt8;
+        p.output_signed = out.type == kTypeInt8;
+        op->bytes = op->s_out.size();
+        return true;
+    }
+
+    case kOpReshape:
+        if (in.type != out.type) return fail("tipos diferentes");
+        op->bytes = op->s_out.size();
+        if (op->bytes != op->s_in0.size()) return fail("tamanhos diferentes");
+        return true;
+
+    default:
+        return fail("operador nao suportado (codigo " + std::to_string(info.builtin) + ")");
+    }
+}
+
+void Interpreter::run_gemm(const PackedWeights &w, size_t rows, const int8_t *x, int32_t output_offset,
+                           int32_t act_min, int32_t act_max, int8_t *out) {
+#ifdef FIRE_X86_KERNELS
+    // Em blocos de linhas: a cópia convertida da ativação dentro do kernel
+    // fica limitada (memória por instância) e quente no cache
+    for (size_t r = 0; r < rows; r += kGemmRowBlock) {
+        const size_t n = std::min(kGemmRowBlock, rows - r);
+        const int8_t *xb = x + r * w.in_c;
+        int8_t *ob = out + r * w.out_c;
+        if (isa_ == kIsaAvx512Vnni) gemm_vnni(w, n, xb, output_offset, act_min, act_max, ob, scratch_);
+        else gemm_avx2(w, n, xb, output_offset, act_min, act_max, ob, scratch_);
+    }
+#endif
+}
+
+#ifdef FIRE_X86_KERNELS
+// Procura expand 1x1 -> depthwise 3x3 -> project 1x1 (+ ADD com a entrada do
+// bloco), em que cada intermediário só é lido pelo operador seguinte. Esses
+// tensores deixam de existir (sem lugar na arena): o bloco roda por faixas
+// de linhas de saída.
+void Interpreter::fuse_blocks() {
+    const std::vector<TensorInfo> &tensors = model_->tensors();
+    std::vector<int> readers(tensors.size(), 0);
+    for (const Op &op : ops_) {
+        readers[op.in0]++;
+        if (op.in1 >= 0) readers[op.in1]++;
+    }
+    readers[model_->outputs()[0]]++;
+
+    for (size_t i = 0; i + 2 < ops_.size(); i++) {
+        Op &e = ops_[i];
+        const Op &d = ops_[i + 1], &p = ops_[i + 2];
+        if (e.builtin != kOpConv2D || e.kernel != kKernelGemm || d.kernel != kKernelDepthwise3x3 ||
+            p.builtin != kOpConv2D || p.kernel != kKernelGemm)
+            continue;
+        if (d.in0 != e.out || p.in0 != d.out || readers[e.out] != 1 || readers[d.out] != 1) continue;
+
+        int count = 3;
+        if (i + 3 < ops_.size()) {
+            const Op &a = ops_[i + 3];
+            const bool operands = (a.in0 == p.out && a.in1 == e.in0) || (a.in1 == p.out && a.in0 == e.in0);
+            if (a.builtin == kOpAdd && operands && readers[p.out] == 1 && a.s_in0.size() == a.s_out.size() &&
+                a.s_in1.size() == a.s_out.size())
+                count = 4;
+        }
+
+        const Shape4 &es = e.s_out;
+        const size_t row_bytes = (size_t)es.w * es.c;
+        const int stride = d.conv.stride_h;
+        const int rows_fit = (int)(kFusedTileBytes / row_bytes);
+        e.tile_rows = std::min(std::max((rows_fit - 3) / stride + 1, 1), d.s_out.h);
+        e.fused = count;
+
+        const int eliminated[3] = {e.out, d.out, p.out};
+        for (int k = 0; k < count - 1; k++) fused_saved_ += 2 * tensor_bytes(eliminated[k]);
+        for (int k = 1; k < count; k++) ops_[i + k].fused_member = true;
+        fused_blocks_++;
+        i += count - 1;
+    }
+}
+
+// Uma imagem por vez, faixa a faixa: as linhas da expansão necessárias à
+// faixa (stride/padding do depthwise) ficam num buffer rolante, sem recálculo
+// das linhas compartilhadas entre faixas vizinhas.
+void Interpreter::run_fused(size_t first) {
+    const Op &e = ops_[first], &d = ops_[first + 1], &p = ops_[first + 2];
+    const Op *add = e.fused == 4 ? &ops_[first + 3] : nullptr;
+
+    const Shape4 &xs = e.s_in0, &es = e.s_out, &ds = d.s_out, &ps = p.s_out;
+    const int stride = d.conv.stride_h, pad = d.conv.pad_h;
+    const int tile = e.tile_rows;
+    const int cap = (tile - 1) * stride + 3;
+    const size_t erow = (size_t)es.w * es.c, drow = (size_t)ds.w * ds.c, prow = (size_t)ps.w * ps.c;
+    const size_t xrow = (size_t)xs.w * xs.c;
+
+    const size_t e_bytes = (cap * erow + kAlign - 1) / kAlign * kAlign;
+    const size_t d_bytes = (tile * drow + kAlign - 1) / kAlign * kAlign;
+    uint8_t *base = tiles_.reserve(e_bytes + d_bytes + (add ? tile * prow : 0));
+    int8_t *etile = (int8_t *)base, *dtile = (int8_t *)(base + e_bytes), *ptile = (int8_t *)(base + e_bytes + d_bytes);
+
+    Shape4 eimg = es, dimg = ds;
+    eimg.n = dimg.n = 1;
+    for (int b = 0; b < xs.n; b++) {
+        const int8_t *x = (const int8_t *)buffer(e.in0) + b * xs.h * xrow;
+        int8_t *dst = (int8_t *)buffers_[add ? add->out : p.out] + b * ps.h * prow;
+        int c0 = 0, c1 = 0; // Linhas da expansão presentes em etile
+        for (int oy0 = 0; oy0 < ds.h; oy0 += tile) {
+            const int oy1 = std::min(ds.h, oy0 + tile);
+            const int need0 = std::max(0, oy0 * stride - pad);
+            const int need1 = std::min(es.h, (oy1 - 1) * stride - pad + 3);
+            if (need0 < c1 && need0 >= c0) {
+                memmove(etile, etile + (need0 - c0) * erow, (c1 - need0) * erow);
+                c0 = need0;
+            } else {
+                c0 = c1 = need0;
+            }
+            if (need1 > c1) {
+                run_gemm(e.packed, (size_t)(need1 - c1) * es.w, x + c1 * xrow, e.conv.output_offset, e.conv.act_min,
+                         e.conv.act_max, etile + (c1 - c0) * erow);
+                c1 = need1;
+            }
+
+            depthwise3x3_avx2(d.packed, d.conv, eimg, etile, c0, d.filter, d.bias.empty() ? nullptr : d.bias.data(),
+                              dimg, oy0, oy1, dtile);
+
+            const size_t rows = (size_t)(oy1 - oy0) * ds.w;
+            int8_t *proj = add ? ptile : dst + oy0 * prow;
+            run_gemm(p.packed, rows, dtile, p.conv.output_offset, p.conv.act_min, p.conv.act_max, proj);
+            if (add) {
+                Shape4 flat;
+                flat.c = (int)(rows * ps.c);
+                const int8_t *resid = x + oy0 * xrow;
+                const bool proj_first = add->in0 == p.out;
+                add_ref(add->add, flat, proj_first ? proj : resid, flat, proj_first ? resid : proj, flat,
+                        dst + oy0 * prow);
+            }
+        }
+    }
+}
+#endif
+
+size_t Interpreter::memory_bytes() const {
+    return arena_bytes_ + scratch_.capacity() + cols_.capacity() + tiles_.capacity();
+}
+
+size_t Interpreter::packed_bytes() const {
+    size_t total = 0;
+    for (const Op &op : ops_) total += op.packed.bytes;
+    return total;
+}
+
+bool Interpreter::invoke() {
+    for (size_t i = 0; i < ops_.size(); i++) {
+        const Op &op = ops_[i];
+        if (op.fused_member) continue;
+#ifdef FIRE_X86_KERNELS
+        if (op.fused) {
+            run_fused(i);
+            continue;
+        }
+#endif
+        const uint8_t *in0 = buffer(op.in0);
+        uint8_t *out = buffers_[op.out];
+        const int32_t *bias = op.bias.empty() ? nullptr : op.bias.data();
+        switch (op.builtin) {
+        case kOpConv2D:
+        case kOpDepthwiseConv2D:
+#ifdef FIRE_X86_KERNELS
+            if (op.kernel == kKernelGemm || op.kernel == kKernelIm2colGemm) {
+                const int8_t *x = (const int8_t *)in0;
+                if (op.kernel == kKernelIm2colGemm) {
+                    int8_t *cols = (int8_t *)cols_.reserve(op.s_out.n * op.s_out.h * op.s_out.w * op.packed.in_c);
+                    im2col(op.conv, op.s_in0, x, op.s_filter, op.s_out, cols);
+                    x = cols;
+                }
+                run_gemm(op.packed, (size_t)op.s_out.n * op.s_out.h * op.s_out.w, x, op.conv.output_offset,
+                         op.conv.act_min, op.conv.act_max, (int8_t *)out);
+                break;
+            }
+            if (op.kernel == kKernelDepthwise3x3) {
+                Shape4 is = op.s_in0, os = op.s_out;
+                is.n = os.n = 1;
+                for (int b = 0; b < op.s_out.n; b++) {
+                    depthwise3x3_avx2(op.packed, op.conv, is, (const int8_t *)in0 + b * is.size(), 0, op.filter, bias,
+                                      os, 0, os.h, (int8_t *)out + b * os.size());
+                }
+                break;
+            }
+#endif
+            if (op.builtin == kOpConv2D)
+                conv_per_channel_ref(op.conv, op.s_in0, (const int8_t *)in0, op.s_filter, op.filter, bias, op.s_out,
+                                     (int8_t *)out);
+            else
+                depthwise_per_channel_ref(op.conv, op.s_in0, (const int8_t *)in0, op.s_filter, op.filter, bias,
+                                          op.s_out, (int8_t *)out);
+            break;
+        case kOpFullyConnected:
+#ifdef FIRE_X86_KERNELS
+            if (op.kernel == kKernelGemm) {
+                run_gemm(op.packed, (size_t)op.s_out.n * op.s_out.h * op.s_out.w, (const int8_t *)in0,
+                         op.fc.output_offset, op.fc.act_min, op.fc.act_max, (int8_t *)out);
+                break;
+            }
+#endif
+            fully_connected_ref(op.fc, op.s_out.n * op.s_out.h * op.s_out.w, (int)op.s_filter.c,
+                                (const int8_t *)in0, op.s_out.c, op.filter, bias, (int8_t *)out);
+            break;
+        case kOpAdd:
+            add_ref(op.add, op.s_in0, (const int8_t *)in0, op.s_in1, (const int8_t *)buffer(op.in1), op.s_out,
+                    (int8_t *)out);
+            break;
+        case kOpMul:
+            mul_ref(op.mul, op.s_in0, (const int8_t *)in0, op.s_in1, (const int8_t *)buffer(op.in1), op.s_out,
+                    (int8_t *)out);
+            break;
+        case kOpMean:
+            mean_hw_ref(op.mean, op.s_in0, (const int8_t *)in0, (int8_t *)out,
+                        (int32_t *)scratch_.reserve(op.s_in0.c * sizeof(int32_t)));
+            break;
+        case kOpLogistic:
+            logistic_ref(op.logistic, op.s_out.size(), (const int8_t *)in0, (int8_t *)out);
+            break;
+        case kOpQuantize:
+            requantize_ref(op.requant, op.bytes, in0, out);
+            break;
+        case kOpReshape:
+            memcpy(out, in0, op.bytes);
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace fire
@@ -0,0 +1,113 @@
+#pragma once
+// Interpretador int8 do grafo TFLite no host. Prepara uma vez os parâmetros
+// de cada operador (multiplicadores, padding, faixas de ativação) e os
+// buffers de ativação; cada invoke só executa os kernels. As ativações vivem
+// em uma arena única planejada pelo tempo de vida de cada tensor.
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "cpu_features.h"
+#include "kernels.h"
+#include "tflite_model.h"
+
+namespace fire {
+
+struct InterpreterOptions {
+    KernelIsa isa = kIsaAuto; // Kernels de conv (kIsaAuto = detecção da CPU)
+    // Junta os blocos expand -> depthwise -> project (+ ADD residual) em um
+    // único passo por faixas de linhas (só com kernels x86)
+    bool fuse = true;
+    // Sem reuso da arena: todo tensor continua legível depois do invoke
+    // (comparação de intermediários); custa a soma de todas as ativações
+    bool preserve_all_tensors = false;
+    // Planeja sem alocar: as ativações só existem depois de bind_arena, com
+    // memória do chamador (ex.: uma arena para modelos que rodam em sequência)
+    bool external_arena = false;
+};
+
+class Interpreter {
+public:
+    // batch > 1 replica a dimensão 0 das ativações: N imagens por invoke.
+    static std::unique_ptr<Interpreter> create(std::shared_ptr<const TfliteModel> model, int batch,
+                                               std::string *error,
+                                               const InterpreterOptions &options = InterpreterOptions());
+    // Outra instância do mesmo grafo: reaproveita operadores preparados e
+    // pesos reempacotados (somente leitura), com arena própria (também
+    // quando o original usa external_arena)
+    std::unique_ptr<Interpreter> clone(std::string *error) const;
+    ~Interpreter();
+
+    bool invoke();
+
+    int batch() const { return batch_; }
+    const TensorInfo &input_info() const;
+    const TensorInfo &output_info() const;
+    // Entrada/saída de uma amostra do lote (bytes crus do tipo do tensor)
+    uint8_t *input(int b = 0);
+    const uint8_t *output(int b = 0) const;
+    size_t input_bytes() const { return input_bytes_; }
+    size_t output_bytes() const { return output_bytes_; }
+
+    const TfliteModel &model() const { return *model_; }
+    KernelIsa isa() const { return isa_; }
+    // Bytes de pesos reempacotados no prepare (0 com kernels _ref),
+    // compartilhados com os clones
+    size_t packed_bytes() const;
+
+    // Arena planejada (pico de ativações) e quanto seria com um buffer por tensor
+    size_t arena_bytes() const { return arena_bytes_; }
+    size_t unplanned_bytes() const { return unplanned_bytes_; }
+    // Memória própria desta instância: arena + buffers de trabalho dos
+    // kernels (estes só atingem o tamanho final depois do primeiro invoke)
+    size_t memory_bytes() const;
+    // Aponta as ativações para `base` (alinhado a 64, >= arena_bytes()).
+    // Sem external_arena a arena própria já vem ligada.
+    void bind_arena(uint8_t *base);
+
+    // Blocos fundidos e bytes de ativação por invoke que deixaram de passar
+    // pela memória (escrita + leitura de cada tensor intermediário eliminado)
+    int fused_blocks() const { return fused_blocks_; }
+    size_t fused_traffic_saved() const { return fused_saved_; }
+
+    // Conteúdo atual de qualquer tensor (ativações com o lote inteiro).
+    // nullptr para intermediários de blocos fundidos, que não existem mais.
+    // Sem preserve_all_tensors, só entrada e saída são garantidas: os demais
+    // podem ter sido sobrescritos por tensores que reutilizam a arena.
+    const uint8_t *tensor_data(int tensor) const { return buffer(tensor); }
+    size_t tensor_bytes(int tensor) const;
+
+private:
+    struct Op;
+
+    Interpreter() = default;
+    bool prepare(std::string *error);
+    bool plan_arena(std::string *error);
+    bool prepare_op(const OperatorInfo &info, Op *op, std::string *error);
+    void fuse_blocks();
+    void run_fused(size_t first);
+    Shape4 shape_of(int tensor) const;
+    uint8_t *buffer(int tensor) const;
+    void run_gemm(const PackedWeights &w, size_t rows, const int8_t *x, int32_t output_offset, int32_t act_min,
+                  int32_t act_max, int8_t *out);
+
+    std::shared_ptr<const TfliteModel> model_;
+    int batch_ = 1;
+    KernelIsa isa_ = kIsaReference;
+    bool preserve_all_ = false;
+    bool external_arena_ = false;
+    KernelScratch scratch_; // Conversão da ativação dentro dos kernels
+    KernelScratch cols_;    // Saída do im2col
+    KernelScratch tiles_;   // Faixas de linhas dos blocos fundidos
+    std::vector<Op> ops_;
+    std::unique_ptr<uint8_t[], FreeDeleter> arena_;
+    std::vector<uint8_t *> buffers_; // Ativações na arena (nullptr para constantes)
+    std::vector<size_t> offsets_;    // Posição de cada tensor na arena planejada
+    size_t input_bytes_ = 0, output_bytes_ = 0;
+    size_t arena_bytes_ = 0, unplanned_bytes_ = 0;
+    int fused_blocks_ = 0;
+    size_t fused_saved_ = 0;
+};
+
+} // namespace fire
@@ -0,0 +1,180 @@
+#pragma once
+// Kernels int8 de referência: transcrição dos kernels de referência do TFLite
+// Micro (reference_integer_ops / reference_ops); o tflite_golden os confere
+// contra o interpretador TFLite.
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+
+namespace fire {
+
+// Formato NHWC (filtros de conv: OHWI; depthwise: 1HWC)
+struct Shape4 {
+    int n = 1, h = 1, w = 1, c = 1;
+    size_t size() const { return (size_t)n * h * w * c; }
+};
+
+struct ConvParams {
+    int stride_w = 1, stride_h = 1;
+    int dilation_w = 1, dilation_h = 1;
+    int pad_w = 0, pad_h = 0;
+    int depth_multiplier = 1;      // Só depthwise
+    int32_t input_offset = 0;      // -zero_point da entrada
+    int32_t output_offset = 0;     // zero_point da saída
+    int32_t act_min = -128, act_max = 127;
+    const int32_t *multiplier = nullptr; // Por canal de saída
+    const int32_t *shift = nullptr;
+};
+
+void conv_per_channel_ref(const ConvParams &p, const Shape4 &in_shape, const int8_t *in,
+                          const Shape4 &filter_shape, const int8_t *filter, const int32_t *bias,
+                          const Shape4 &out_shape, int8_t *out);
+
+void depthwise_per_channel_ref(const ConvParams &p, const Shape4 &in_shape, const int8_t *in,
+                               const Shape4 &filter_shape, const int8_t *filter,
+                               const int32_t *bias, const Shape4 &out_shape, int8_t *out);
+
+struct FullyConnectedParams {
+    int32_t input_offset = 0, filter_offset = 0, output_offset = 0;
+    int32_t multiplier = 0;
+    int shift = 0;
+    int32_t act_min = -128, act_max = 127;
+};
+
+void fully_connected_ref(const FullyConnectedParams &p, int batches, int in_depth, const int8_t *in,
+                         int out_depth, const int8_t *filter, const int32_t *bias, int8_t *out);
+
+// Operações elemento a elemento. Broadcast: um lado pode ter 1 elemento
+// ou as formas 4D podem ter dimensões 1 (BroadcastBinaryFunction4DSlow).
+struct AddParams {
+    int32_t input1_offset = 0, input2_offset = 0, output_offset = 0;
+    int left_shift = 20;
+    int32_t input1_multiplier = 0, input2_multiplier = 0, output_multiplier = 0;
+    int input1_shift = 0, input2_shift = 0, output_shift = 0;
+    int32_t act_min = -128, act_max = 127;
+};
+
+struct MulParams {
+    int32_t input1_offset = 0, input2_offset = 0, output_offset = 0;
+    int32_t output_multiplier = 0;
+    int output_shift = 0;
+    int32_t act_min = -128, act_max = 127;
+};
+
+void add_ref(const AddParams &p, const Shape4 &s1, const int8_t *in1, const Shape4 &s2,
+             const int8_t *in2, const Shape4 &out_shape, int8_t *out);
+void mul_ref(const MulParams &p, const Shape4 &s1, const int8_t *in1, const Shape4 &s2,
+             const int8_t *in2, const Shape4 &out_shape, int8_t *out);
+
+// MEAN sobre H e W (eixos 1 e 2) de um tensor NHWC. O caminho segue o
+// EvalIntegerMean do TFLite Micro: keep_dims usa reference_integer_ops::Mean;
+// sem ele, mesma quantização usa reference_ops::Mean (divisão inteira) e
+// quantizações diferentes usam reference_ops::QuantizedMeanOrSum.
+enum MeanPath { kMeanIntegerOps = 0, kMeanSameQuant, kMeanRescale };
+
+struct MeanParams {
+    int path = kMeanSameQuant;
+    int32_t input_zero_point = 0, output_zero_point = 0;
+    int32_t multiplier = 0;  // input_scale / output_scale (QuantizeMultiplier)
+    int shift = 0;
+};
+
+// sums: in_shape.c acumuladores de trabalho do chamador (o Invoke não aloca)
+void mean_hw_ref(const MeanParams &p, const Shape4 &in_shape, const int8_t *in, int8_t *out, int32_t *sums);
+
+struct LogisticParams {
+    int32_t input_zero_point = 0;
+    int32_t input_range_radius = 0;
+    int32_t input_multiplier = 0;
+    int input_left_shift = 0;
+};
+
+void logistic_ref(const LogisticParams &p, size_t size, const int8_t *in, int8_t *out);
+
+// QUANTIZE entre tipos inteiros de 8 bits (uint8 <-> int8, int8 -> int8)
+struct RequantizeParams {
+    int32_t multiplier = 0;
+    int shift = 0;
+    int32_t input_zero_point = 0, output_zero_point = 0;
+    bool input_signed = false, output_signed = true;
+};
+
+void requantize_ref(const RequantizeParams &p, size_t size, const uint8_t *in, uint8_t *out);
+
+// Área de trabalho reaproveitada entre invokes (uma por interpretador)
+class KernelScratch {
+public:
+    KernelScratch() = default;
+    KernelScratch(const KernelScratch &) = delete;
+    KernelScratch &operator=(const KernelScratch &) = delete;
+    ~KernelScratch() { free(data_); }
+
+    // Buffer alinhado a 64 bytes com pelo menos `bytes` (conteúdo não preservado)
+    uint8_t *reserve(size_t bytes) {
+        if (bytes > size_) {
+            free(data_);
+            size_ = (bytes + 63) / 64 * 64;
+            data_ = (uint8_t *)aligned_alloc(64, size_);
+        }
+        return data_;
+    }
+    size_t capacity() const { return size_; }
+
+private:
+    uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Copia as janelas de uma conv em linhas [pixel][fy][fx][c] (im2col), para
+// que qualquer CONV_2D vire um GEMM. Taps fora da imagem recebem o zero point
+// da entrada: (x + input_offset) = 0, o mesmo que a referência pular o tap.
+void im2col(const ConvParams &p, const Shape4 &in_shape, const int8_t *in, const Shape4 &filter_shape,
+            const Shape4 &out_shape, int8_t *cols);
+
+struct FreeDeleter {
+    void operator()(void *p) const { free(p); }
+};
+
+// Pesos reempacotados uma vez no prepare, no layout que o kernel percorre
+// linearmente (painéis de 8/16 canais de saída, alinhados a 64 bytes), com o
+// bias já corrigido pelo zero point da entrada e os shifts por canal separados.
+struct PackedWeights {
+    int in_c = 0, out_c = 0;
+    int blocks = 0;   // Painéis de canais de saída (GEMM) ou grupos de 16 canais (depthwise)
+    size_t kstep = 0; // Vetores de peso por painel (GEMM)
+    const void *weights = nullptr;
+    const int32_t *bias = nullptr, *mult = nullptr, *lshift = nullptr, *rshift = nullptr;
+    size_t bytes = 0;
+    std::shared_ptr<uint8_t> storage; // Compartilhado entre interpretadores clonados
+};
+
+// ---- Kernels x86 (kernels_avx2.cpp / kernels_vnni.cpp) ----
+// Mesma saída, bit a bit, de conv_per_channel_ref / depthwise_per_channel_ref /
+// fully_connected_ref, com bias, requantização e clamp (ReLU6) fundidos.
+
+// GEMM int8: out[rows][out_c] = requant(x[rows][in_c] * W^T + bias). Pesos W
+// [out_c][in_c] (conv 1x1, im2col ou fully connected sem offset de filtro);
+// mult/shift por canal de saída.
+void pack_gemm_avx2(const int8_t *w, int out_c, int in_c, const int32_t *bias, const int32_t *mult,
+                    const int32_t *shift, int32_t input_offset, PackedWeights *packed);
+void gemm_avx2(const PackedWeights &w, size_t rows, const int8_t *x, int32_t output_offset, int32_t act_min,
+               int32_t act_max, int8_t *out, KernelScratch &scratch);
+
+void pack_gemm_vnni(const int8_t *w, int out_c, int in_c, const int32_t *bias, const int32_t *mult,
+                    const int32_t *shift, int32_t input_offset, PackedWeights *packed);
+void gemm_vnni(const PackedWeights &w, size_t rows, const int8_t *x, int32_t output_offset, int32_t act_min,
+               int32_t act_max, int8_t *out, KernelScratch &scratch);
+
+// Depthwise 3x3, depth_multiplier 1, sem dilatação, qualquer stride/padding.
+// Canais que não fecham 16 usam filter/bias/p.multiplier originais.
+void pack_depthwise3x3_avx2(const int8_t *filter, int channels, const int32_t *bias, const int32_t *mult,
+                            const int32_t *shift, PackedWeights *packed);
+// Uma imagem (in_shape/out_shape com n = 1), linhas de saída [oy_begin, oy_end).
+// `in` aponta para a linha in_row0 da entrada e `out` para a linha oy_begin da
+// saída, o que permite rodar sobre faixas de linhas (blocos fundidos).
+void depthwise3x3_avx2(const PackedWeights &w, const ConvParams &p, const Shape4 &in_shape, const int8_t *in,
+                       int in_row0, const int8_t *filter, const int32_t *bias, const Shape4 &out_shape,
+                       int oy_begin, int oy_end, int8_t *out);
+
+} // namespace fire
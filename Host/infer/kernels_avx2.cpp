@@ -0,0 +1,303 @@
+// Kernels int8 em AVX2 para as convoluções do MobileNetV2 (GEMM para conv
+// 1x1 / im2col / fully connected e depthwise 3x3). Compilado com -mavx2; só é chamado após a detecção em
+// cpu_features.cpp. A saída é idêntica, bit a bit, à dos kernels _ref:
+// produtos int8 x int8 exatos em int16/int32 (madd, sem saturação) e
+// requantização com a mesma aritmética de MultiplyByQuantizedMultiplier.
+#include <immintrin.h>
+#include <algorithm>
+#include <cstring>
+#include "kernels.h"
+#include "quant.h"
+
+namespace fire {
+
+namespace {
+
+// MultiplyByQuantizedMultiplier em 8 lanes. Com multiplicador positivo o
+// SaturatingRoundingDoublingHighMul se reduz a floor((x*m + 2^30) / 2^31),
+// e os 32 bits baixos do shift lógico de 64 bits já são o resultado.
+inline __m256i requantize8(__m256i x, __m256i mult, __m256i lshift, __m256i rshift) {
+    const __m256i nudge = _mm256_set1_epi64x(1ll << 30);
+    const __m256i one = _mm256_set1_epi32(1);
+    x = _mm256_sllv_epi32(x, lshift);
+    __m256i even = _mm256_add_epi64(_mm256_mul_epi32(x, mult), nudge);
+    __m256i odd = _mm256_add_epi64(_mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(mult, 32)), nudge);
+    __m256i high = _mm256_blend_epi32(_mm256_srli_epi64(even, 31), _mm256_slli_epi64(odd, 1), 0xAA);
+
+    // RoundingDivideByPOT com expoente por lane
+    __m256i mask = _mm256_sub_epi32(_mm256_sllv_epi32(one, rshift), one);
+    __m256i remainder = _mm256_and_si256(high, mask);
+    __m256i threshold = _mm256_add_epi32(_mm256_srai_epi32(mask, 1), _mm256_srli_epi32(high, 31));
+    __m256i round = _mm256_srli_epi32(_mm256_cmpgt_epi32(remainder, threshold), 31);
+    return _mm256_add_epi32(_mm256_srav_epi32(high, rshift), round);
+}
+
+// Parâmetros de saída por canal, em blocos de 8 lanes
+struct Requant8 {
+    const int32_t *mult, *lshift, *rshift;
+    __m256i out_offset, act_min, act_max;
+};
+
+inline __m256i finish8(__m256i acc, const Requant8 &q, size_t off) {
+    __m256i v = requantize8(acc, _mm256_load_si256((const __m256i *)(q.mult + off)),
+                            _mm256_load_si256((const __m256i *)(q.lshift + off)),
+                            _mm256_load_si256((const __m256i *)(q.rshift + off)));
+    v = _mm256_add_epi32(v, q.out_offset);
+    return _mm256_min_epi32(_mm256_max_epi32(v, q.act_min), q.act_max);
+}
+
+// Grava até 8 valores int32 (já no intervalo int8)
+inline void store8(int8_t *dst, __m256i v, int n) {
+    __m128i s16 = _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    __m128i s8 = _mm_packs_epi16(s16, s16);
+    if (n == 8) {
+        _mm_storel_epi64((__m128i *)dst, s8);
+    } else {
+        alignas(16) int8_t tmp[16];
+        _mm_store_si128((__m128i *)tmp, s8);
+        memcpy(dst, tmp, n);
+    }
+}
+
+// Multiplicador/shift de cada canal separados em shift à esquerda e à direita
+inline void split_shift(int shift, int32_t *l, int32_t *r) {
+    *l = shift > 0 ? shift : 0;
+    *r = shift > 0 ? 0 : -shift;
+}
+
+inline size_t round_up(size_t v, size_t m) { return (v + m - 1) / m * m; }
+
+// ---- GEMM ----
+
+// Bloco de NP linhas x NB painéis de 8 canais de saída
+template <int NP, int NB>
+inline void gemm_tile(const int16_t *x, size_t x_stride, const __m256i *w, size_t kstep, const int32_t *bias,
+                      const Requant8 &q, size_t r0, int b0, int out_c, int8_t *out) {
+    __m256i acc[NP][NB];
+    for (int j = 0; j < NB; j++) {
+        __m256i bj = _mm256_load_si256((const __m256i *)(bias + (b0 + j) * 8));
+        for (int i = 0; i < NP; i++) acc[i][j] = bj;
+    }
+    for (size_t k = 0; k < kstep; k++) {
+        __m256i wv[NB];
+        for (int j = 0; j < NB; j++) wv[j] = _mm256_load_si256(w + (b0 + j) * kstep + k);
+        for (int i = 0; i < NP; i++) {
+            int32_t pair;
+            memcpy(&pair, x + (r0 + i) * x_stride + 2 * k, 4);
+            __m256i xv = _mm256_set1_epi32(pair);
+            for (int j = 0; j < NB; j++) acc[i][j] = _mm256_add_epi32(acc[i][j], _mm256_madd_epi16(xv, wv[j]));
+        }
+    }
+    for (int i = 0; i < NP; i++) {
+        for (int j = 0; j < NB; j++) {
+            const int oc = (b0 + j) * 8;
+            store8(out + (r0 + i) * out_c + oc, finish8(acc[i][j], q, oc), std::min(8, out_c - oc));
+        }
+    }
+}
+
+} // namespace
+
+void pack_gemm_avx2(const int8_t *w, int out_c, int in_c, const int32_t *bias, const int32_t *mult,
+                    const int32_t *shift, int32_t input_offset, PackedWeights *pw) {
+    const int blocks = (out_c + 7) / 8;
+    const size_t oc8 = (size_t)blocks * 8;
+    const size_t kstep = (in_c + 1) / 2; // Pares de entradas por painel
+
+    // [painel][k/2][8 canais][2] int16, seguido de bias, mult, lshift, rshift
+    pw->bytes = blocks * kstep * 32 + 4 * oc8 * 4;
+    pw->storage.reset((uint8_t *)aligned_alloc(64, round_up(pw->bytes, 64)), FreeDeleter());
+    uint8_t *base = pw->storage.get();
+    int16_t *wp = (int16_t *)base;
+    int32_t *b_eff = (int32_t *)(base + blocks * kstep * 32);
+    int32_t *m = b_eff + oc8, *ls = m + oc8, *rs = ls + oc8;
+
+    for (int b = 0; b < blocks; b++) {
+        for (size_t k = 0; k < kstep; k++) {
+            for (int l = 0; l < 8; l++) {
+                const int oc = b * 8 + l;
+                for (int t = 0; t < 2; t++) {
+                    const size_t ic = 2 * k + t;
+                    *wp++ = (oc < out_c && (int)ic < in_c) ? w[(size_t)oc * in_c + ic] : 0;
+                }
+            }
+        }
+    }
+    // Correção do zero point da entrada embutida no bias: sum(w * (x + off)) = sum(w * x) + off * sum(w)
+    for (size_t oc = 0; oc < oc8; oc++) {
+        if ((int)oc < out_c) {
+            int32_t wsum = 0;
+            for (int k = 0; k < in_c; k++) wsum += w[oc * in_c + k];
+            b_eff[oc] = (bias ? bias[oc] : 0) + input_offset * wsum;
+            m[oc] = mult[oc];
+            split_shift(shift[oc], &ls[oc], &rs[oc]);
+        } else {
+            b_eff[oc] = m[oc] = ls[oc] = rs[oc] = 0;
+        }
+    }
+
+    pw->in_c = in_c;
+    pw->out_c = out_c;
+    pw->blocks = blocks;
+    pw->kstep = kstep;
+    pw->weights = base;
+    pw->bias = b_eff;
+    pw->mult = m;
+    pw->lshift = ls;
+    pw->rshift = rs;
+}
+
+void gemm_avx2(const PackedWeights &pw, size_t rows, const int8_t *x, int32_t output_offset, int32_t act_min,
+               int32_t act_max, int8_t *out, KernelScratch &scratch) {
+    const int in_c = pw.in_c, out_c = pw.out_c, blocks = pw.blocks;
+    const size_t kstep = pw.kstep, x_stride = 2 * kstep;
+    const __m256i *w = (const __m256i *)pw.weights;
+
+    // Só a ativação é convertida a cada chamada (int16, linhas com in_c par)
+    int16_t *x16 = (int16_t *)scratch.reserve(rows * x_stride * 2);
+    for (size_t r = 0; r < rows; r++) {
+        const int8_t *src = x + r * in_c;
+        int16_t *dst = x16 + r * x_stride;
+        for (int c = 0; c < in_c; c++) dst[c] = src[c];
+        if ((size_t)in_c < x_stride) dst[in_c] = 0;
+    }
+
+    Requant8 q = {pw.mult, pw.lshift, pw.rshift, _mm256_set1_epi32(output_offset), _mm256_set1_epi32(act_min),
+                  _mm256_set1_epi32(act_max)};
+
+    size_t r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        int b = 0;
+        for (; b + 2 <= blocks; b += 2) gemm_tile<4, 2>(x16, x_stride, w, kstep, pw.bias, q, r, b, out_c, out);
+        if (b < blocks) gemm_tile<4, 1>(x16, x_stride, w, kstep, pw.bias, q, r, b, out_c, out);
+    }
+    for (; r < rows; r++) {
+        for (int b = 0; b < blocks; b++) gemm_tile<1, 1>(x16, x_stride, w, kstep, pw.bias, q, r, b, out_c, out);
+    }
+}
+
+// ---- Depthwise 3x3 ----
+
+// Um canal pela fórmula de referência (canais que não fecham 16)
+static int8_t depthwise_channel(const ConvParams &p, const Shape4 &is, const int8_t *in, int in_row0,
+                                int channels, const int8_t *filter, const int32_t *bias, int oy, int ox, int c) {
+    int32_t acc = 0;
+    for (int fy = 0; fy < 3; fy++) {
+        const int iy = oy * p.stride_h - p.pad_h + fy;
+        for (int fx = 0; fx < 3; fx++) {
+            const int ix = ox * p.stride_w - p.pad_w + fx;
+            if (ix < 0 || ix >= is.w || iy < 0 || iy >= is.h) continue;
+            acc += (int32_t)filter[(fy * 3 + fx) * channels + c] *
+                   ((int32_t)in[((size_t)(iy - in_row0) * is.w + ix) * is.c + c] + p.input_offset);
+        }
+    }
+    if (bias) acc += bias[c];
+    acc = MultiplyByQuantizedMultiplier(acc, p.multiplier[c], p.shift[c]) + p.output_offset;
+    return (int8_t)std::min(std::max(acc, p.act_min), p.act_max);
+}
+
+void pack_depthwise3x3_avx2(const int8_t *filter, int channels, const int32_t *bias, const int32_t *mult,
+                            const int32_t *shift, PackedWeights *pw) {
+    const int groups = channels / 16;
+
+    // Por grupo de 16 canais: 5 pares de taps x (lo, hi) em int16 intercalado,
+    // e os parâmetros na ordem em que unpacklo/unpackhi deixam os canais
+    // (lo = 0-3 e 8-11, hi = 4-7 e 12-15)
+    const size_t wbytes = (size_t)groups * 10 * 32;
+    pw->bytes = wbytes + (size_t)groups * 8 * 32;
+    pw->storage.reset((uint8_t *)aligned_alloc(64, round_up(std::max(pw->bytes, (size_t)64), 64)),
+                      FreeDeleter());
+    __m256i *w = (__m256i *)pw->storage.get();
+    int32_t *params = (int32_t *)(pw->storage.get() + wbytes);
+
+    static const int kLo[8] = {0, 1, 2, 3, 8, 9, 10, 11};
+    static const int kHi[8] = {4, 5, 6, 7, 12, 13, 14, 15};
+    for (int g = 0; g < groups; g++) {
+        const int c0 = g * 16;
+        for (int k = 0; k < 5; k++) {
+            const int t0 = 2 * k, t1 = 2 * k + 1;
+            __m256i w0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(filter + t0 * channels + c0)));
+            __m256i w1 = t1 < 9 ? _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(filter + t1 * channels + c0)))
+                                : _mm256_setzero_si256();
+            w[g * 10 + 2 * k] = _mm256_unpacklo_epi16(w0, w1);
+            w[g * 10 + 2 * k + 1] = _mm256_unpackhi_epi16(w0, w1);
+        }
+        int32_t *gp = params + g * 64;
+        for (int l = 0; l < 8; l++) {
+            const int lo = c0 + kLo[l], hi = c0 + kHi[l];
+            gp[l] = bias ? bias[lo] : 0;
+            gp[8 + l] = bias ? bias[hi] : 0;
+            gp[16 + l] = mult[lo];
+            gp[24 + l] = mult[hi];
+            split_shift(shift[lo], &gp[32 + l], &gp[48 + l]);
+            split_shift(shift[hi], &gp[40 + l], &gp[56 + l]);
+        }
+    }
+
+    pw->in_c = pw->out_c = channels;
+    pw->blocks = groups;
+    pw->weights = w;
+    pw->bias = params;
+}
+
+void depthwise3x3_avx2(const PackedWeights &pw, const ConvParams &p, const Shape4 &is, const int8_t *in,
+                       int in_row0, const int8_t *filter, const int32_t *bias, const Shape4 &os, int oy_begin,
+                       int oy_end, int8_t *out) {
+    const int channels = os.c;
+    const int groups = pw.blocks;
+    const __m256i *w = (const __m256i *)pw.weights;
+    const int32_t *params = pw.bias;
+
+    const __m256i in_off = _mm256_set1_epi16((int16_t)p.input_offset);
+    const __m256i out_off = _mm256_set1_epi32(p.output_offset);
+    const __m256i act_min = _mm256_set1_epi32(p.act_min), act_max = _mm256_set1_epi32(p.act_max);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (int oy = oy_begin; oy < oy_end; oy++) {
+        for (int ox = 0; ox < os.w; ox++) {
+            // Taps fora da imagem não contribuem (nem com o offset)
+            const int8_t *tap[10];
+            for (int t = 0; t < 9; t++) {
+                const int iy = oy * p.stride_h - p.pad_h + t / 3;
+                const int ix = ox * p.stride_w - p.pad_w + t % 3;
+                tap[t] = (iy < 0 || iy >= is.h || ix < 0 || ix >= is.w)
+                             ? nullptr
+                             : in + ((size_t)(iy - in_row0) * is.w + ix) * is.c;
+            }
+            tap[9] = nullptr;
+            int8_t *dst = out + ((size_t)(oy - oy_begin) * os.w + ox) * os.c;
+
+            for (int g = 0; g < groups; g++) {
+                const int c0 = g * 16;
+                const int32_t *gp = params + g * 64;
+                __m256i acc_lo = _mm256_load_si256((const __m256i *)gp);
+                __m256i acc_hi = _mm256_load_si256((const __m256i *)(gp + 8));
+                for (int k = 0; k < 5; k++) {
+                    const int8_t *a = tap[2 * k], *b = tap[2 * k + 1];
+                    __m256i x0 = a ? _mm256_add_epi16(_mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(a + c0))), in_off)
+                                   : zero;
+                    __m256i x1 = b ? _mm256_add_epi16(_mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(b + c0))), in_off)
+                                   : zero;
+                    acc_lo = _mm256_add_epi32(acc_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(x0, x1), w[g * 10 + 2 * k]));
+                    acc_hi = _mm256_add_epi32(acc_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(x0, x1), w[g * 10 + 2 * k + 1]));
+                }
+                __m256i lo = requantize8(acc_lo, _mm256_load_si256((const __m256i *)(gp + 16)),
+                                         _mm256_load_si256((const __m256i *)(gp + 32)),
+                                         _mm256_load_si256((const __m256i *)(gp + 48)));
+                __m256i hi = requantize8(acc_hi, _mm256_load_si256((const __m256i *)(gp + 24)),
+                                         _mm256_load_si256((const __m256i *)(gp + 40)),
+                                         _mm256_load_si256((const __m256i *)(gp + 56)));
+                lo = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(lo, out_off), act_min), act_max);
+                hi = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(hi, out_off), act_min), act_max);
+                // packs volta à ordem natural dos canais dentro de cada metade
+                __m256i s16 = _mm256_packs_epi32(lo, hi);
+                __m256i s8 = _mm256_permute4x64_epi64(_mm256_packs_epi16(s16, s16), 0x08);
+                _mm_storeu_si128((__m128i *)(dst + c0), _mm256_castsi256_si128(s8));
+            }
+            for (int c = groups * 16; c < channels; c++)
+                dst[c] = depthwise_channel(p, is, in, in_row0, channels, filter, bias, oy, ox, c);
+        }
+    }
+}
+
+} // namespace fire
@@ -0,0 +1,264 @@
+#include "kernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+#include "quant.h"
+
+namespace fire {
+
+static inline int8_t clamp_i8(int32_t v, int32_t lo, int32_t hi) {
+    return (int8_t)std::min(std::max(v, lo), hi);
+}
+
+void conv_per_channel_ref(const ConvParams &p, const Shape4 &is, const int8_t *in,
+                          const Shape4 &fs, const int8_t *filter, const int32_t *bias,
+                          const Shape4 &os, int8_t *out) {
+    for (int b = 0; b < os.n; b++) {
+        for (int oy = 0; oy < os.h; oy++) {
+            const int in_y_origin = oy * p.stride_h - p.pad_h;
+            for (int ox = 0; ox < os.w; ox++) {
+                const int in_x_origin = ox * p.stride_w - p.pad_w;
+                for (int oc = 0; oc < os.c; oc++) {
+                    int32_t acc = 0;
+                    for (int fy = 0; fy < fs.h; fy++) {
+                        const int iy = in_y_origin + p.dilation_h * fy;
+                        if (iy < 0 || iy >= is.h) continue;
+                        for (int fx = 0; fx < fs.w; fx++) {
+                            const int ix = in_x_origin + p.dilation_w * fx;
+                            if (ix < 0 || ix >= is.w) continue;
+                            const int8_t *ip = in + (((size_t)b * is.h + iy) * is.w + ix) * is.c;
+                            const int8_t *fp = filter + (((size_t)oc * fs.h + fy) * fs.w + fx) * fs.c;
+                            for (int ic = 0; ic < is.c; ic++) {
+                                acc += (int32_t)fp[ic] * ((int32_t)ip[ic] + p.input_offset);
+                            }
+                        }
+                    }
+                    if (bias) acc += bias[oc];
+                    acc = MultiplyByQuantizedMultiplier(acc, p.multiplier[oc], p.shift[oc]);
+                    acc += p.output_offset;
+                    out[(((size_t)b * os.h + oy) * os.w + ox) * os.c + oc] = clamp_i8(acc, p.act_min, p.act_max);
+                }
+            }
+        }
+    }
+}
+
+void depthwise_per_channel_ref(const ConvParams &p, const Shape4 &is, const int8_t *in,
+                               const Shape4 &fs, const int8_t *filter, const int32_t *bias,
+                               const Shape4 &os, int8_t *out) {
+    for (int b = 0; b < os.n; b++) {
+        for (int oy = 0; oy < os.h; oy++) {
+            for (int ox = 0; ox < os.w; ox++) {
+                for (int ic = 0; ic < is.c; ic++) {
+                    for (int m = 0; m < p.depth_multiplier; m++) {
+                        const int oc = m + ic * p.depth_multiplier;
+                        const int in_x_origin = ox * p.stride_w - p.pad_w;
+                        const int in_y_origin = oy * p.stride_h - p.pad_h;
+                        int32_t acc = 0;
+                        for (int fy = 0; fy < fs.h; fy++) {
+                            const int iy = in_y_origin + p.dilation_h * fy;
+                            for (int fx = 0; fx < fs.w; fx++) {
+                                const int ix = in_x_origin + p.dilation_w * fx;
+                                if (ix < 0 || ix >= is.w || iy < 0 || iy >= is.h) continue;
+                                int32_t iv = in[(((size_t)b * is.h + iy) * is.w + ix) * is.c + ic];
+                                int32_t fv = filter[((size_t)fy * fs.w + fx) * fs.c + oc];
+                                acc += fv * (iv + p.input_offset);
+                            }
+                        }
+                        if (bias) acc += bias[oc];
+                        acc = MultiplyByQuantizedMultiplier(acc, p.multiplier[oc], p.shift[oc]);
+                        acc += p.output_offset;
+                        out[(((size_t)b * os.h + oy) * os.w + ox) * os.c + oc] = clamp_i8(acc, p.act_min, p.act_max);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void fully_connected_ref(const FullyConnectedParams &p, int batches, int in_depth, const int8_t *in,
+                         int out_depth, const int8_t *filter, const int32_t *bias, int8_t *out) {
+    for (int b = 0; b < batches; b++) {
+        for (int oc = 0; oc < out_depth; oc++) {
+            int32_t acc = 0;
+            for (int d = 0; d < in_depth; d++) {
+                int32_t iv = in[(size_t)b * in_depth + d];
+                int32_t fv = filter[(size_t)oc * in_depth + d];
+                acc += (fv + p.filter_offset) * (iv + p.input_offset);
+            }
+            if (bias) acc += bias[oc];
+            acc = MultiplyByQuantizedMultiplier(acc, p.multiplier, p.shift);
+            acc += p.output_offset;
+            out[(size_t)b * out_depth + oc] = clamp_i8(acc, p.act_min, p.act_max);
+        }
+    }
+}
+
+static inline int8_t add_element(const AddParams &p, int8_t a, int8_t b) {
+    const int32_t input1_val = p.input1_offset + a;
+    const int32_t input2_val = p.input2_offset + b;
+    const int32_t shifted_input1_val = input1_val * (1 << p.left_shift);
+    const int32_t shifted_input2_val = input2_val * (1 << p.left_shift);
+    const int32_t scaled_input1_val = MultiplyByQuantizedMultiplierSmallerThanOneExp(
+        shifted_input1_val, p.input1_multiplier, p.input1_shift);
+    const int32_t scaled_input2_val = MultiplyByQuantizedMultiplierSmallerThanOneExp(
+        shifted_input2_val, p.input2_multiplier, p.input2_shift);
+    const int32_t raw_sum = scaled_input1_val + scaled_input2_val;
+    const int32_t raw_output = MultiplyByQuantizedMultiplierSmallerThanOneExp(
+                                   raw_sum, p.output_multiplier, p.output_shift) + p.output_offset;
+    return clamp_i8(raw_output, p.act_min, p.act_max);
+}
+
+static inline int8_t mul_element(const MulParams &p, int8_t a, int8_t b) {
+    const int32_t input1_val = p.input1_offset + a;
+    const int32_t input2_val = p.input2_offset + b;
+    const int32_t unclamped = p.output_offset + MultiplyByQuantizedMultiplier(
+                                                    input1_val * input2_val, p.output_multiplier, p.output_shift);
+    return clamp_i8(unclamped, p.act_min, p.act_max);
+}
+
+template <typename F>
+static void broadcast_binary(const Shape4 &s1, const int8_t *in1, const Shape4 &s2, const int8_t *in2,
+                             const Shape4 &os, int8_t *out, F f) {
+    size_t n1 = s1.size(), n2 = s2.size(), no = os.size();
+    if (n1 == no && n2 == no) {
+        for (size_t i = 0; i < no; i++) out[i] = f(in1[i], in2[i]);
+    } else if (n2 == 1 && n1 == no) {
+        for (size_t i = 0; i < no; i++) out[i] = f(in1[i], in2[0]);
+    } else if (n1 == 1 && n2 == no) {
+        for (size_t i = 0; i < no; i++) out[i] = f(in1[0], in2[i]);
+    } else {
+        // Broadcast 4D genérico: dimensões 1 repetem o mesmo elemento
+        for (int b = 0; b < os.n; b++)
+            for (int y = 0; y < os.h; y++)
+                for (int x = 0; x < os.w; x++)
+                    for (int c = 0; c < os.c; c++) {
+                        size_t i1 = (((size_t)(s1.n > 1 ? b : 0) * s1.h + (s1.h > 1 ? y : 0)) * s1.w +
+                                     (s1.w > 1 ? x : 0)) * s1.c + (s1.c > 1 ? c : 0);
+                        size_t i2 = (((size_t)(s2.n > 1 ? b : 0) * s2.h + (s2.h > 1 ? y : 0)) * s2.w +
+                                     (s2.w > 1 ? x : 0)) * s2.c + (s2.c > 1 ? c : 0);
+                        *out++ = f(in1[i1], in2[i2]);
+                    }
+    }
+}
+
+void add_ref(const AddParams &p, const Shape4 &s1, const int8_t *in1, const Shape4 &s2,
+             const int8_t *in2, const Shape4 &os, int8_t *out) {
+    broadcast_binary(s1, in1, s2, in2, os, out, [&p](int8_t a, int8_t b) { return add_element(p, a, b); });
+}
+
+void mul_ref(const MulParams &p, const Shape4 &s1, const int8_t *in1, const Shape4 &s2,
+             const int8_t *in2, const Shape4 &os, int8_t *out) {
+    broadcast_binary(s1, in1, s2, in2, os, out, [&p](int8_t a, int8_t b) { return mul_element(p, a, b); });
+}
+
+void mean_hw_ref(const MeanParams &p, const Shape4 &is, const int8_t *in, int8_t *out, int32_t *sum) {
+    const int32_t count = is.h * is.w;
+
+    // QuantizedMeanOrSum: o 1/count entra no multiplicador, com o deslocamento
+    // limitado como no TFLite (<= 32 e output_shift - shift >= -31)
+    int32_t multiplier = p.multiplier;
+    int shift = p.shift;
+    if (p.path == kMeanRescale) {
+        int s = 0;
+        while ((2ll << s) <= count) s++; // 63 - CountLeadingZeros(count)
+        s = std::min(s, 32);
+        s = std::min(s, 31 + p.shift);
+        multiplier = (int32_t)(((int64_t)p.multiplier << s) / count);
+        shift = p.shift - s;
+    }
+
+    for (int b = 0; b < is.n; b++) {
+        std::fill(sum, sum + is.c, 0);
+        const int8_t *ip = in + (size_t)b * is.h * is.w * is.c;
+        for (int i = 0; i < count; i++)
+            for (int c = 0; c < is.c; c++) sum[c] += ip[(size_t)i * is.c + c];
+
+        int8_t *op = out + (size_t)b * is.c;
+        for (int c = 0; c < is.c; c++) {
+            int32_t acc;
+            if (p.path == kMeanIntegerOps) {
+                // reference_integer_ops::Mean: reescala a soma e divide arredondando
+                acc = MultiplyByQuantizedMultiplier(sum[c] - p.input_zero_point * count, multiplier, shift);
+                acc = acc > 0 ? (acc + count / 2) / count : (acc - count / 2) / count;
+                acc += p.output_zero_point;
+            } else if (p.path == kMeanSameQuant) {
+                // reference_ops::Mean: divisão inteira (trunca para zero)
+                acc = sum[c] / count;
+            } else {
+                // reference_ops::QuantizedMeanOrSum (compute_sum = false)
+                acc = MultiplyByQuantizedMultiplier(sum[c] - p.input_zero_point * count, multiplier, shift) +
+                      p.output_zero_point;
+            }
+            op[c] = clamp_i8(acc, -128, 127);
+        }
+    }
+}
+
+void logistic_ref(const LogisticParams &p, size_t size, const int8_t *in, int8_t *out) {
+    static constexpr int32_t kInputIntegerBits = 4;
+    static constexpr int32_t kOutputIntegerBits = 8;
+    static constexpr int32_t kOutputZeroPoint = -128;
+
+    for (size_t i = 0; i < size; i++) {
+        const int32_t input = (int32_t)in[i] - p.input_zero_point;
+        if (input <= -p.input_range_radius) {
+            out[i] = -128;
+        } else if (input >= p.input_range_radius) {
+            out[i] = 127;
+        } else {
+            const int32_t input_in_q4 = MultiplyByQuantizedMultiplier(input, p.input_multiplier, p.input_left_shift);
+            using FixedPoint4 = gemmlowp::FixedPoint<kInputIntegerBits>;
+            const int32_t output_in_q0 = gemmlowp::logistic(FixedPoint4::FromRaw(input_in_q4)).raw;
+            int32_t output_in_q23 = RoundingDivideByPOT(output_in_q0, 31 - kOutputIntegerBits);
+            output_in_q23 = std::min(std::max(output_in_q23 + kOutputZeroPoint, (int32_t)-128), (int32_t)127);
+            out[i] = (int8_t)output_in_q23;
+        }
+    }
+}
+
+void im2col(const ConvParams &p, const Shape4 &is, const int8_t *in, const Shape4 &fs, const Shape4 &os,
+            int8_t *cols) {
+    const int8_t pad_value = (int8_t)(-p.input_offset);
+    for (int b = 0; b < os.n; b++) {
+        for (int oy = 0; oy < os.h; oy++) {
+            for (int ox = 0; ox < os.w; ox++) {
+                for (int fy = 0; fy < fs.h; fy++) {
+                    const int iy = oy * p.stride_h - p.pad_h + p.dilation_h * fy;
+                    for (int fx = 0; fx < fs.w; fx++) {
+                        const int ix = ox * p.stride_w - p.pad_w + p.dilation_w * fx;
+                        if (iy < 0 || iy >= is.h || ix < 0 || ix >= is.w) {
+                            memset(cols, pad_value, is.c);
+                        } else {
+                            memcpy(cols, in + (((size_t)b * is.h + iy) * is.w + ix) * is.c, is.c);
+                        }
+                        cols += is.c;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void requantize_ref(const RequantizeParams &p, size_t size, const uint8_t *in, uint8_t *out) {
+    const bool same_scale = p.multiplier == (1 << 30) && p.shift == 1;
+    const int32_t zp_diff = p.input_zero_point - p.output_zero_point;
+    if (same_scale && p.input_signed != p.output_signed &&
+        ((p.input_signed && zp_diff == -128) || (!p.input_signed && zp_diff == 128))) {
+        for (size_t i = 0; i < size; i++) out[i] = in[i] ^ 0x80;
+        return;
+    }
+
+    const int32_t out_min = p.output_signed ? -128 : 0;
+    const int32_t out_max = p.output_signed ? 127 : 255;
+    for (size_t i = 0; i < size; i++) {
+        const int32_t v = p.input_signed ? (int32_t)(int8_t)in[i] : (int32_t)in[i];
+        int32_t o = MultiplyByQuantizedMultiplier(v - p.input_zero_point, p.multiplier, p.shift) + p.output_zero_point;
+        o = std::min(std::max(o, out_min), out_max);
+        out[i] = (uint8_t)(p.output_signed ? (uint8_t)(int8_t)o : (uint8_t)o);
+    }
+}
+
+} // namespace fire
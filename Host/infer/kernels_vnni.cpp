@@ -0,0 +1,150 @@
+// GEMM int8 (conv 1x1 / im2col / fully connected) com AVX-512 VNNI.
+// Compilado com -mavx512vnni; só é chamado quando cpu_features() confirma o
+// suporte. VPDPBUSD multiplica
+// u8 x s8 e soma 4 produtos em int32 sem saturação: a entrada vira u8
+// (x + 128) e a diferença entra na correção de zero point do bias.
+#include <immintrin.h>
+#include <algorithm>
+#include <cstring>
+#include "kernels.h"
+
+namespace fire {
+
+namespace {
+
+// Mesma requantização do requantize8 (kernels_avx2.cpp), em 16 lanes
+inline __m512i requantize16(__m512i x, __m512i mult, __m512i lshift, __m512i rshift) {
+    const __m512i nudge = _mm512_set1_epi64(1ll << 30);
+    const __m512i one = _mm512_set1_epi32(1);
+    x = _mm512_sllv_epi32(x, lshift);
+    __m512i even = _mm512_add_epi64(_mm512_mul_epi32(x, mult), nudge);
+    __m512i odd = _mm512_add_epi64(_mm512_mul_epi32(_mm512_srli_epi64(x, 32), _mm512_srli_epi64(mult, 32)), nudge);
+    __m512i high = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 31), _mm512_slli_epi64(odd, 1));
+
+    __m512i mask = _mm512_sub_epi32(_mm512_sllv_epi32(one, rshift), one);
+    __m512i remainder = _mm512_and_si512(high, mask);
+    __m512i threshold = _mm512_add_epi32(_mm512_srai_epi32(mask, 1), _mm512_srli_epi32(high, 31));
+    __mmask16 round = _mm512_cmpgt_epi32_mask(remainder, threshold);
+    return _mm512_mask_add_epi32(_mm512_srav_epi32(high, rshift), round, _mm512_srav_epi32(high, rshift), one);
+}
+
+struct Requant16 {
+    const int32_t *mult, *lshift, *rshift;
+    __m512i out_offset, act_min, act_max;
+};
+
+inline size_t round_up(size_t v, size_t m) { return (v + m - 1) / m * m; }
+
+template <int NP, int NB>
+inline void gemm_tile(const uint8_t *x, size_t x_stride, const __m512i *w, size_t kstep, const int32_t *bias,
+                      const Requant16 &q, size_t r0, int b0, int out_c, int8_t *out) {
+    __m512i acc[NP][NB];
+    for (int j = 0; j < NB; j++) {
+        __m512i bj = _mm512_load_si512(bias + (b0 + j) * 16);
+        for (int i = 0; i < NP; i++) acc[i][j] = bj;
+    }
+    for (size_t k = 0; k < kstep; k++) {
+        __m512i wv[NB];
+        for (int j = 0; j < NB; j++) wv[j] = _mm512_load_si512(w + (b0 + j) * kstep + k);
+        for (int i = 0; i < NP; i++) {
+            int32_t quad;
+            memcpy(&quad, x + (r0 + i) * x_stride + 4 * k, 4);
+            __m512i xv = _mm512_set1_epi32(quad);
+            for (int j = 0; j < NB; j++) acc[i][j] = _mm512_dpbusd_epi32(acc[i][j], xv, wv[j]);
+        }
+    }
+    for (int i = 0; i < NP; i++) {
+        for (int j = 0; j < NB; j++) {
+            const int oc = (b0 + j) * 16;
+            __m512i v = requantize16(acc[i][j], _mm512_load_si512(q.mult + oc), _mm512_load_si512(q.lshift + oc),
+                                     _mm512_load_si512(q.rshift + oc));
+            v = _mm512_add_epi32(v, q.out_offset);
+            v = _mm512_min_epi32(_mm512_max_epi32(v, q.act_min), q.act_max);
+            const int n = std::min(16, out_c - oc);
+            _mm_mask_storeu_epi8(out + (r0 + i) * out_c + oc, (__mmask16)((1u << n) - 1), _mm512_cvtepi32_epi8(v));
+        }
+    }
+}
+
+} // namespace
+
+void pack_gemm_vnni(const int8_t *w, int out_c, int in_c, const int32_t *bias, const int32_t *mult,
+                    const int32_t *shift, int32_t input_offset, PackedWeights *pw) {
+    const int blocks = (out_c + 15) / 16;
+    const size_t oc16 = (size_t)blocks * 16;
+    const size_t kstep = (in_c + 3) / 4; // Quádruplas de entradas por painel
+
+    // [painel][k/4][16 canais][4] int8, seguido de bias, mult, lshift, rshift
+    pw->bytes = blocks * kstep * 64 + 4 * oc16 * 4;
+    pw->storage.reset((uint8_t *)aligned_alloc(64, round_up(pw->bytes, 64)), FreeDeleter());
+    uint8_t *base = pw->storage.get();
+    int8_t *wp = (int8_t *)base;
+    int32_t *b_eff = (int32_t *)(base + blocks * kstep * 64);
+    int32_t *m = b_eff + oc16, *ls = m + oc16, *rs = ls + oc16;
+
+    for (int b = 0; b < blocks; b++) {
+        for (size_t k = 0; k < kstep; k++) {
+            for (int l = 0; l < 16; l++) {
+                const int oc = b * 16 + l;
+                for (int t = 0; t < 4; t++) {
+                    const size_t ic = 4 * k + t;
+                    *wp++ = (oc < out_c && (int)ic < in_c) ? w[(size_t)oc * in_c + ic] : 0;
+                }
+            }
+        }
+    }
+    // sum(w * (x + off)) = sum(w * (x + 128)) + (off - 128) * sum(w)
+    for (size_t oc = 0; oc < oc16; oc++) {
+        if ((int)oc < out_c) {
+            int32_t wsum = 0;
+            for (int k = 0; k < in_c; k++) wsum += w[oc * in_c + k];
+            b_eff[oc] = (bias ? bias[oc] : 0) + (input_offset - 128) * wsum;
+            m[oc] = mult[oc];
+            ls[oc] = shift[oc] > 0 ? shift[oc] : 0;
+            rs[oc] = shift[oc] > 0 ? 0 : -shift[oc];
+        } else {
+            b_eff[oc] = m[oc] = ls[oc] = rs[oc] = 0;
+        }
+    }
+
+    pw->in_c = in_c;
+    pw->out_c = out_c;
+    pw->blocks = blocks;
+    pw->kstep = kstep;
+    pw->weights = base;
+    pw->bias = b_eff;
+    pw->mult = m;
+    pw->lshift = ls;
+    pw->rshift = rs;
+}
+
+void gemm_vnni(const PackedWeights &pw, size_t rows, const int8_t *x, int32_t output_offset, int32_t act_min,
+               int32_t act_max, int8_t *out, KernelScratch &scratch) {
+    const int in_c = pw.in_c, out_c = pw.out_c, blocks = pw.blocks;
+    const size_t kstep = pw.kstep, x_stride = 4 * kstep;
+    const __m512i *w = (const __m512i *)pw.weights;
+
+    // Só a ativação é convertida a cada chamada (u8, linhas múltiplas de 4)
+    uint8_t *xu8 = scratch.reserve(rows * x_stride);
+    for (size_t r = 0; r < rows; r++) {
+        const int8_t *src = x + r * in_c;
+        uint8_t *dst = xu8 + r * x_stride;
+        for (int c = 0; c < in_c; c++) dst[c] = (uint8_t)src[c] ^ 0x80;
+        for (size_t c = in_c; c < x_stride; c++) dst[c] = 0;
+    }
+
+    Requant16 q = {pw.mult, pw.lshift, pw.rshift, _mm512_set1_epi32(output_offset), _mm512_set1_epi32(act_min),
+                   _mm512_set1_epi32(act_max)};
+
+    size_t r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        int b = 0;
+        for (; b + 2 <= blocks; b += 2) gemm_tile<4, 2>(xu8, x_stride, w, kstep, pw.bias, q, r, b, out_c, out);
+        if (b < blocks) gemm_tile<4, 1>(xu8, x_stride, w, kstep, pw.bias, q, r, b, out_c, out);
+    }
+    for (; r < rows; r++) {
+        for (int b = 0; b < blocks; b++) gemm_tile<1, 1>(xu8, x_stride, w, kstep, pw.bias, q, r, b, out_c, out);
+    }
+}
+
+} // namespace fire
@@ -0,0 +1,44 @@
+#include "memory_planner.h"
+#include <algorithm>
+
+namespace fire {
+
+size_t plan_memory(const std::vector<TensorLifetime> &tensors, size_t align, std::vector<size_t> *offsets) {
+    auto round_up = [align](size_t v) { return (v + align - 1) / align * align; };
+
+    std::vector<size_t> order;
+    for (size_t i = 0; i < tensors.size(); i++)
+        if (tensors[i].bytes) order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (tensors[a].bytes != tensors[b].bytes) return tensors[a].bytes > tensors[b].bytes;
+        return tensors[a].first < tensors[b].first;
+    });
+
+    offsets->assign(tensors.size(), 0);
+    std::vector<size_t> placed;
+    std::vector<std::pair<size_t, size_t>> busy; // [início, fim) dos vivos ao mesmo tempo
+    size_t arena = 0;
+    for (size_t t : order) {
+        const TensorLifetime &cur = tensors[t];
+        busy.clear();
+        for (size_t p : placed) {
+            const TensorLifetime &o = tensors[p];
+            if (o.first <= cur.last && cur.first <= o.last)
+                busy.push_back({(*offsets)[p], (*offsets)[p] + round_up(o.bytes)});
+        }
+        std::sort(busy.begin(), busy.end());
+
+        const size_t need = round_up(cur.bytes);
+        size_t offset = 0;
+        for (const auto &b : busy) {
+            if (b.first >= offset + need) break;
+            offset = std::max(offset, b.second);
+        }
+        (*offsets)[t] = offset;
+        placed.push_back(t);
+        arena = std::max(arena, offset + need);
+    }
+    return arena;
+}
+
+} // namespace fire
@@ -0,0 +1,20 @@
+#pragma once
+// Planejador estático das ativações (guloso, como o GreedyMemoryPlanner do
+// TFLM): cada tensor recebe um offset em uma arena única e tensores cujos
+// intervalos de vida se cruzam nunca se sobrepõem. Os maiores são
+// posicionados primeiro, no primeiro vão livre a partir do offset 0.
+#include <cstddef>
+#include <vector>
+
+namespace fire {
+
+struct TensorLifetime {
+    size_t bytes = 0; // 0 = tensor sem buffer (não planejado)
+    int first = 0;    // Passo do invoke em que é escrito
+    int last = 0;     // Último passo em que é lido (inclusive)
+};
+
+// Offsets (múltiplos de align) por tensor; retorna o tamanho da arena
+size_t plan_memory(const std::vector<TensorLifetime> &tensors, size_t align, std::vector<size_t> *offsets);
+
+} // namespace fire
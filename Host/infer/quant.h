@@ -0,0 +1,217 @@
+#pragma once
+// Aritmética de ponto fixo dos kernels int8 do TFLite (reference_integer_ops)
+// e do gemmlowp. Reproduzida aqui para que o motor host dê o mesmo resultado,
+// bit a bit, que o TFLite Micro no ESP32.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace fire {
+
+inline int32_t SaturatingRoundingDoublingHighMul(int32_t a, int32_t b) {
+    bool overflow = a == b && a == std::numeric_limits<int32_t>::min();
+    int64_t ab_64 = (int64_t)a * (int64_t)b;
+    int32_t nudge = ab_64 >= 0 ? (1 << 30) : (1 - (1 << 30));
+    int32_t ab_x2_high32 = (int32_t)((ab_64 + nudge) / (1ll << 31));
+    return overflow ? std::numeric_limits<int32_t>::max() : ab_x2_high32;
+}
+
+inline int32_t RoundingDivideByPOT(int32_t x, int exponent) {
+    const int32_t mask = (int32_t)((1ll << exponent) - 1);
+    const int32_t remainder = x & mask;
+    const int32_t threshold = (mask >> 1) + ((x < 0) ? 1 : 0);
+    return (x >> exponent) + ((remainder > threshold) ? 1 : 0);
+}
+
+inline int32_t MultiplyByQuantizedMultiplier(int32_t x, int32_t quantized_multiplier, int shift) {
+    int left_shift = shift > 0 ? shift : 0;
+    int right_shift = shift > 0 ? 0 : -shift;
+    return RoundingDivideByPOT(
+        SaturatingRoundingDoublingHighMul(x * (1 << left_shift), quantized_multiplier), right_shift);
+}
+
+inline int32_t MultiplyByQuantizedMultiplierSmallerThanOneExp(int32_t x, int32_t quantized_multiplier,
+                                                              int left_shift) {
+    return RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(x, quantized_multiplier), -left_shift);
+}
+
+// Converte um multiplicador real em (mantissa Q31, expoente), como o TFLite
+inline void QuantizeMultiplier(double double_multiplier, int32_t *quantized_multiplier, int *shift) {
+    if (double_multiplier == 0.) {
+        *quantized_multiplier = 0;
+        *shift = 0;
+        return;
+    }
+    const double q = std::frexp(double_multiplier, shift);
+    int64_t q_fixed = (int64_t)std::round(q * (1ll << 31));
+    if (q_fixed == (1ll << 31)) {
+        q_fixed /= 2;
+        ++*shift;
+    }
+    if (*shift < -31) {
+        *shift = 0;
+        q_fixed = 0;
+    }
+    if (*shift > 30) {
+        *shift = 30;
+        q_fixed = (1ll << 31) - 1;
+    }
+    *quantized_multiplier = (int32_t)q_fixed;
+}
+
+// Faixa de saída [min, max] da ativação fundida no domínio quantizado
+enum Activation { kActNone = 0, kActRelu = 1, kActReluN1To1 = 2, kActRelu6 = 3 };
+
+inline void CalculateActivationRangeQuantized(int activation, float scale, int32_t zero_point,
+                                              int32_t qmin, int32_t qmax, int32_t *act_min,
+                                              int32_t *act_max) {
+    auto quantize = [scale, zero_point](float f) {
+        return zero_point + (int32_t)std::round(f / scale);
+    };
+    *act_min = qmin;
+    *act_max = qmax;
+    if (activation == kActRelu) {
+        *act_min = std::max(qmin, quantize(0.0f));
+    } else if (activation == kActRelu6) {
+        *act_min = std::max(qmin, quantize(0.0f));
+        *act_max = std::min(qmax, quantize(6.0f));
+    } else if (activation == kActReluN1To1) {
+        *act_min = std::max(qmin, quantize(-1.0f));
+        *act_max = std::min(qmax, quantize(1.0f));
+    }
+}
+
+// ---- gemmlowp: logística em ponto fixo (usada pelo LOGISTIC int8) ----
+namespace gemmlowp {
+
+// Valor em ponto fixo com kIntegerBits bits inteiros (raw int32)
+template <int kIntegerBits>
+struct FixedPoint {
+    int32_t raw;
+    static constexpr int kFractionalBits = 31 - kIntegerBits;
+    static FixedPoint FromRaw(int32_t r) { return FixedPoint{r}; }
+    static FixedPoint Zero() { return FixedPoint{0}; }
+    static FixedPoint One() {
+        return FixedPoint{kIntegerBits == 0 ? std::numeric_limits<int32_t>::max()
+                                            : (int32_t)(1u << kFractionalBits)};
+    }
+    template <int Exponent>
+    static FixedPoint ConstantPOT() {
+        return FixedPoint{(int32_t)(1u << (kFractionalBits + Exponent))};
+    }
+};
+
+template <int A, int B>
+inline FixedPoint<A + B> operator*(FixedPoint<A> a, FixedPoint<B> b) {
+    return FixedPoint<A + B>{SaturatingRoundingDoublingHighMul(a.raw, b.raw)};
+}
+template <int A>
+inline FixedPoint<A> operator+(FixedPoint<A> a, FixedPoint<A> b) {
+    return FixedPoint<A>{(int32_t)((uint32_t)a.raw + (uint32_t)b.raw)};
+}
+template <int A>
+inline FixedPoint<A> operator-(FixedPoint<A> a, FixedPoint<A> b) {
+    return FixedPoint<A>{(int32_t)((uint32_t)a.raw - (uint32_t)b.raw)};
+}
+template <int A>
+inline FixedPoint<A> operator-(FixedPoint<A> a) {
+    return FixedPoint<A>{(int32_t)(0u - (uint32_t)a.raw)};
+}
+
+template <int Exponent>
+inline int32_t SaturatingRoundingMultiplyByPOT(int32_t x) {
+    if (Exponent > 0) {
+        const int32_t threshold = (int32_t)((1ll << (31 - Exponent)) - 1);
+        if (x > threshold) return std::numeric_limits<int32_t>::max();
+        if (x < -threshold) return std::numeric_limits<int32_t>::min();
+        return (int32_t)((uint32_t)x << (Exponent > 0 ? Exponent : 0));
+    }
+    if (Exponent < 0) return RoundingDivideByPOT(x, -Exponent);
+    return x;
+}
+
+template <int Dst, int Src>
+inline FixedPoint<Dst> Rescale(FixedPoint<Src> x) {
+    return FixedPoint<Dst>{SaturatingRoundingMultiplyByPOT<Src - Dst>(x.raw)};
+}
+
+inline int32_t RoundingHalfSum(int32_t a, int32_t b) {
+    int64_t sum = (int64_t)a + (int64_t)b;
+    int64_t sign = sum >= 0 ? 1 : -1;
+    return (int32_t)((sum + sign) / 2);
+}
+
+inline FixedPoint<0> exp_on_interval_between_negative_one_quarter_and_0_excl(FixedPoint<0> a) {
+    typedef FixedPoint<0> F;
+    const F constant_term = F::FromRaw(1895147668);     // exp(-1/8)
+    const F constant_1_over_3 = F::FromRaw(715827883);  // 1/3
+    F x = a + F::ConstantPOT<-3>();
+    F x2 = x * x;
+    F x3 = x2 * x;
+    F x4 = x2 * x2;
+    F x4_over_4 = F::FromRaw(SaturatingRoundingMultiplyByPOT<-2>(x4.raw));
+    F x4_over_24_plus_x3_over_6_plus_x2_over_2 =
+        F::FromRaw(SaturatingRoundingMultiplyByPOT<-1>((((x4_over_4 + x3) * constant_1_over_3) + x2).raw));
+    return constant_term + constant_term * (x + x4_over_24_plus_x3_over_6_plus_x2_over_2);
+}
+
+template <int kIntegerBits>
+inline FixedPoint<0> exp_on_negative_values(FixedPoint<kIntegerBits> a) {
+    typedef FixedPoint<kIntegerBits> InputF;
+    typedef FixedPoint<0> ResultF;
+    constexpr int kFractionalBits = InputF::kFractionalBits;
+    const InputF kOneQuarter = InputF::template ConstantPOT<-2>();
+    const int32_t mask = kOneQuarter.raw - 1;
+    InputF a_mod_quarter_minus_one_quarter = InputF::FromRaw(a.raw & mask) - kOneQuarter;
+    ResultF result = exp_on_interval_between_negative_one_quarter_and_0_excl(
+        Rescale<0>(a_mod_quarter_minus_one_quarter));
+    int32_t remainder = (a_mod_quarter_minus_one_quarter - a).raw;
+
+    // Barrel shifter: multiplica por exp(-2^k) para cada bit do resto
+    struct Step { int exponent; int32_t multiplier; };
+    static const Step steps[] = {{-2, 1672461947}, {-1, 1302514674}, {0, 790015084},
+                                 {1, 290630308},   {2, 39332535},    {3, 720401},
+                                 {4, 242}};
+    for (const Step &s : steps) {
+        if (kIntegerBits > s.exponent) {
+            const int shift = kFractionalBits + s.exponent;
+            if (remainder & (int32_t)(1u << shift)) result = result * ResultF::FromRaw(s.multiplier);
+        }
+    }
+
+    if (kIntegerBits > 5) {
+        const int clamp_b = 36 - kIntegerBits;
+        if (a.raw < -(1 << clamp_b)) result = ResultF::Zero();
+    }
+    if (a.raw == 0) result = ResultF::One();
+    return result;
+}
+
+inline FixedPoint<0> one_over_one_plus_x_for_x_in_0_1(FixedPoint<0> a) {
+    typedef FixedPoint<0> F0;
+    typedef FixedPoint<2> F2;
+    F0 half_denominator = F0::FromRaw(RoundingHalfSum(a.raw, F0::One().raw));
+    const F2 constant_48_over_17 = F2::FromRaw(1515870810);
+    const F2 constant_neg_32_over_17 = F2::FromRaw(-1010580540);
+    F2 x = constant_48_over_17 + half_denominator * constant_neg_32_over_17;
+    for (int i = 0; i < 3; i++) {
+        F2 half_denominator_times_x = half_denominator * x;
+        F2 one_minus_half_denominator_times_x = F2::One() - half_denominator_times_x;
+        x = x + Rescale<2>(x * one_minus_half_denominator_times_x);
+    }
+    // ExactMulByPot<-1> só reinterpreta o raw como Q1; depois Rescale<0>
+    return Rescale<0>(FixedPoint<1>::FromRaw(x.raw));
+}
+
+template <int kIntegerBits>
+inline FixedPoint<0> logistic(FixedPoint<kIntegerBits> a) {
+    typedef FixedPoint<0> ResultF;
+    if (a.raw == 0) return ResultF::FromRaw(1 << 30); // 0.5
+    FixedPoint<kIntegerBits> abs_input = a.raw > 0 ? a : -a;
+    ResultF result_if_positive = one_over_one_plus_x_for_x_in_0_1(exp_on_negative_values(-abs_input));
+    return a.raw > 0 ? result_if_positive : ResultF::One() - result_if_positive;
+}
+
+} // namespace gemmlowp
+} // namespace fire
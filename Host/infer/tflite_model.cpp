@@ -0,0 +1,303 @@
+#include "tflite_model.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fire {
+
+namespace {
+
+// Tabela flatbuffer: posição da tabela + vtable, com verificação de limites
+class FbTable {
+public:
+    FbTable() = default;
+    FbTable(const uint8_t *base, size_t size, size_t pos) : base_(base), size_(size), pos_(pos) {
+        if (pos + 4 > size) return;
+        int32_t soff;
+        memcpy(&soff, base + pos, 4);
+        int64_t vt = (int64_t)pos - soff;
+        if (vt < 0 || (size_t)vt + 4 > size) return;
+        vt_ = (size_t)vt;
+        uint16_t vlen;
+        memcpy(&vlen, base + vt_, 2);
+        if (vt_ + vlen > size) return;
+        vlen_ = vlen;
+        valid_ = true;
+    }
+
+    bool valid() const { return valid_; }
+
+    template <typename T>
+    T scalar(int field, T def) const {
+        size_t off = field_offset(field);
+        if (!off || pos_ + off + sizeof(T) > size_) return def;
+        T v;
+        memcpy(&v, base_ + pos_ + off, sizeof(T));
+        return v;
+    }
+
+    FbTable table(int field) const {
+        size_t p;
+        if (!indirect(field, &p)) return FbTable();
+        return FbTable(base_, size_, p);
+    }
+
+    // Vetor de escalares: retorna ponteiro (possivelmente desalinhado) e tamanho
+    bool vector(int field, const uint8_t **data, uint32_t *count, size_t elem_size) const {
+        size_t p;
+        if (!indirect(field, &p) || p + 4 > size_) return false;
+        uint32_t n;
+        memcpy(&n, base_ + p, 4);
+        if (p + 4 + (uint64_t)n * elem_size > size_) return false;
+        *data = base_ + p + 4;
+        *count = n;
+        return true;
+    }
+
+    template <typename T>
+    std::vector<T> scalar_vector(int field) const {
+        const uint8_t *d;
+        uint32_t n;
+        std::vector<T> out;
+        if (!vector(field, &d, &n, sizeof(T))) return out;
+        out.resize(n);
+        if (n) memcpy(out.data(), d, n * sizeof(T));
+        return out;
+    }
+
+    std::vector<FbTable> table_vector(int field) const {
+        const uint8_t *d;
+        uint32_t n;
+        std::vector<FbTable> out;
+        if (!vector(field, &d, &n, 4)) return out;
+        for (uint32_t i = 0; i < n; i++) {
+            size_t elem = (size_t)(d - base_) + 4 * i;
+            uint32_t rel;
+            memcpy(&rel, base_ + elem, 4);
+            out.push_back(FbTable(base_, size_, elem + rel));
+        }
+        return out;
+    }
+
+    std::string string(int field) const {
+        const uint8_t *d;
+        uint32_t n;
+        if (!vector(field, &d, &n, 1)) return std::string();
+        return std::string((const char *)d, n);
+    }
+
+private:
+    size_t field_offset(int field) const {
+        if (!valid_) return 0;
+        size_t o = 4 + 2 * (size_t)field;
+        if (o + 2 > vlen_) return 0;
+        uint16_t off;
+        memcpy(&off, base_ + vt_ + o, 2);
+        return off;
+    }
+
+    bool indirect(int field, size_t *out) const {
+        size_t off = field_offset(field);
+        if (!off || pos_ + off + 4 > size_) return false;
+        uint32_t rel;
+        memcpy(&rel, base_ + pos_ + off, 4);
+        *out = pos_ + off + rel;
+        return *out < size_;
+    }
+
+    const uint8_t *base_ = nullptr;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+    size_t vt_ = 0;
+    size_t vlen_ = 0;
+    bool valid_ = false;
+};
+
+// Índices de campos do schema TFLite
+enum { kModelVersion = 0, kModelOperatorCodes = 1, kModelSubgraphs = 2, kModelBuffers = 4 };
+enum { kCodeDeprecatedBuiltin = 0, kCodeVersion = 2, kCodeBuiltin = 3 };
+enum { kSubgraphTensors = 0, kSubgraphInputs = 1, kSubgraphOutputs = 2, kSubgraphOperators = 3 };
+enum { kTensorShape = 0, kTensorType = 1, kTensorBuffer = 2, kTensorName = 3, kTensorQuant = 4 };
+enum { kQuantScale = 2, kQuantZeroPoint = 3, kQuantDimension = 6 };
+enum { kOpOpcodeIndex = 0, kOpInputs = 1, kOpOutputs = 2, kOpBuiltinOptions = 4 };
+enum { kBufferData = 0, kBufferOffset = 1, kBufferSize = 2 };
+
+} // namespace
+
+size_t TensorInfo::num_elements() const {
+    size_t n = 1;
+    for (int d : shape) n *= (size_t)d;
+    return n;
+}
+
+const char *builtin_op_name(int op) {
+    switch (op) {
+    case kOpAdd: return "ADD";
+    case kOpConv2D: return "CONV_2D";
+    case kOpDepthwiseConv2D: return "DEPTHWISE_CONV_2D";
+    case kOpFullyConnected: return "FULLY_CONNECTED";
+    case kOpLogistic: return "LOGISTIC";
+    case kOpMul: return "MUL";
+    case kOpReshape: return "RESHAPE";
+    case kOpMean: return "MEAN";
+    case kOpQuantize: return "QUANTIZE";
+    default: return "DESCONHECIDO";
+    }
+}
+
+std::shared_ptr<const TfliteModel> TfliteModel::load(const std::string &path, std::string *error) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (error) *error = "nao foi possivel abrir " + path;
+        return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 8) {
+        close(fd);
+        if (error) *error = "arquivo invalido: " + path;
+        return nullptr;
+    }
+    void *map = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        if (error) *error = "mmap falhou: " + path;
+        return nullptr;
+    }
+
+    std::shared_ptr<TfliteModel> m(new TfliteModel());
+    m->path_ = path;
+    m->data_ = (const uint8_t *)map;
+    m->size_ = (size_t)st.st_size;
+    m->mapped_ = true;
+    if (!m->parse(error)) return nullptr;
+    return m;
+}
+
+std::shared_ptr<const TfliteModel> TfliteModel::from_buffer(const uint8_t *data, size_t size,
+                                                            std::string *error) {
+    std::shared_ptr<TfliteModel> m(new TfliteModel());
+    m->path_ = "<memoria>";
+    m->data_ = data;
+    m->size_ = size;
+    if (!m->parse(error)) return nullptr;
+    return m;
+}
+
+TfliteModel::~TfliteModel() {
+    if (mapped_) munmap((void *)data_, size_);
+}
+
+bool TfliteModel::parse(std::string *error) {
+    auto fail = [error](const std::string &msg) {
+        if (error) *error = msg;
+        return false;
+    };
+
+    uint32_t root;
+    memcpy(&root, data_, 4);
+    if (size_ < 8 || memcmp(data_ + 4, "TFL3", 4) != 0) return fail("nao e um arquivo TFLite");
+    FbTable model(data_, size_, root);
+    if (!model.valid()) return fail("flatbuffer invalido");
+    if (model.scalar<uint32_t>(kModelVersion, 0) != 3) return fail("versao de schema nao suportada");
+
+    // Códigos de operador (builtin_code novo ou o campo antigo de 8 bits)
+    std::vector<std::pair<int, int>> codes;
+    for (const FbTable &c : model.table_vector(kModelOperatorCodes)) {
+        int deprecated = c.scalar<int8_t>(kCodeDeprecatedBuiltin, 0);
+        int builtin = c.scalar<int32_t>(kCodeBuiltin, 0);
+        codes.push_back({std::max(deprecated, builtin), c.scalar<int32_t>(kCodeVersion, 1)});
+    }
+
+    std::vector<FbTable> buffers = model.table_vector(kModelBuffers);
+    std::vector<FbTable> subgraphs = model.table_vector(kModelSubgraphs);
+    if (subgraphs.empty()) return fail("modelo sem subgrafos");
+    const FbTable &sg = subgraphs[0];
+
+    for (const FbTable &t : sg.table_vector(kSubgraphTensors)) {
+        TensorInfo ti;
+        ti.name = t.string(kTensorName);
+        ti.shape = t.scalar_vector<int32_t>(kTensorShape);
+        ti.type = t.scalar<int8_t>(kTensorType, 0);
+
+        uint32_t buf = t.scalar<uint32_t>(kTensorBuffer, 0);
+        if (buf > 0 && buf < buffers.size()) {
+            const uint8_t *d;
+            uint32_t n;
+            if (buffers[buf].vector(kBufferData, &d, &n, 1) && n > 0) {
+                ti.data = d;
+                ti.data_size = n;
+            } else {
+                // Buffers fora do flatbuffer (modelos > 2 GB)
+                uint64_t off = buffers[buf].scalar<uint64_t>(kBufferOffset, 0);
+                uint64_t sz = buffers[buf].scalar<uint64_t>(kBufferSize, 0);
+                if (off > 1 && sz > 0 && off + sz <= size_) {
+                    ti.data = data_ + off;
+                    ti.data_size = (size_t)sz;
+                }
+            }
+        }
+
+        FbTable q = t.table(kTensorQuant);
+        if (q.valid()) {
+            ti.scales = q.scalar_vector<float>(kQuantScale);
+            for (int64_t zp : q.scalar_vector<int64_t>(kQuantZeroPoint)) ti.zero_points.push_back((int32_t)zp);
+            ti.quantized_dimension = q.scalar<int32_t>(kQuantDimension, 0);
+        }
+        tensors_.push_back(std::move(ti));
+    }
+
+    inputs_ = sg.scalar_vector<int32_t>(kSubgraphInputs);
+    outputs_ = sg.scalar_vector<int32_t>(kSubgraphOutputs);
+
+    for (const FbTable &o : sg.table_vector(kSubgraphOperators)) {
+        OperatorInfo op;
+        uint32_t idx = o.scalar<uint32_t>(kOpOpcodeIndex, 0);
+        if (idx >= codes.size()) return fail("opcode_index invalido");
+        op.builtin = codes[idx].first;
+        op.version = codes[idx].second;
+        op.inputs = o.scalar_vector<int32_t>(kOpInputs);
+        op.outputs = o.scalar_vector<int32_t>(kOpOutputs);
+
+        FbTable opt = o.table(kOpBuiltinOptions);
+        switch (op.builtin) {
+        case kOpConv2D:
+            op.padding = opt.scalar<int8_t>(0, 0);
+            op.stride_w = opt.scalar<int32_t>(1, 0);
+            op.stride_h = opt.scalar<int32_t>(2, 0);
+            op.activation = opt.scalar<int8_t>(3, 0);
+            op.dilation_w = opt.scalar<int32_t>(4, 1);
+            op.dilation_h = opt.scalar<int32_t>(5, 1);
+            break;
+        case kOpDepthwiseConv2D:
+            op.padding = opt.scalar<int8_t>(0, 0);
+            op.stride_w = opt.scalar<int32_t>(1, 0);
+            op.stride_h = opt.scalar<int32_t>(2, 0);
+            op.depth_multiplier = opt.scalar<int32_t>(3, 0);
+            op.activation = opt.scalar<int8_t>(4, 0);
+            op.dilation_w = opt.scalar<int32_t>(5, 1);
+            op.dilation_h = opt.scalar<int32_t>(6, 1);
+            break;
+        case kOpAdd:
+        case kOpMul:
+        case kOpFullyConnected:
+            op.activation = opt.scalar<int8_t>(0, 0);
+            break;
+        case kOpMean:
+            op.keep_dims = opt.scalar<uint8_t>(0, 0) != 0;
+            break;
+        default:
+            break;
+        }
+        for (int i : op.inputs)
+            if (i >= (int)tensors_.size()) return fail("indice de tensor invalido");
+        for (int i : op.outputs)
+            if (i < 0 || i >= (int)tensors_.size()) return fail("indice de tensor invalido");
+        operators_.push_back(std::move(op));
+    }
+    return true;
+}
+
+} // namespace fire
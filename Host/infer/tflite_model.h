@@ -0,0 +1,95 @@
+#pragma once
+// Modelo .tflite mapeado em memória (mmap) com um leitor mínimo de flatbuffers.
+// Só o necessário para executar os modelos de fogo: tensores, quantização,
+// operadores e suas opções. Os pesos são usados direto do mapeamento.
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fire {
+
+// Tipos de tensor (valores do schema TFLite)
+enum TensorType { kTypeFloat32 = 0, kTypeInt32 = 2, kTypeUInt8 = 3, kTypeInt64 = 4, kTypeInt8 = 9 };
+
+// Operadores suportados (BuiltinOperator do schema TFLite)
+enum BuiltinOp {
+    kOpAdd = 0,
+    kOpConv2D = 3,
+    kOpDepthwiseConv2D = 4,
+    kOpFullyConnected = 9,
+    kOpLogistic = 14,
+    kOpMul = 18,
+    kOpReshape = 22,
+    kOpMean = 40,
+    kOpQuantize = 114,
+};
+
+enum Padding { kPaddingSame = 0, kPaddingValid = 1 };
+
+struct TensorInfo {
+    std::string name;
+    std::vector<int> shape;
+    int type = kTypeFloat32;
+    const uint8_t *data = nullptr; // Dados constantes (pesos/bias) ou nullptr
+    size_t data_size = 0;
+    std::vector<float> scales;
+    std::vector<int32_t> zero_points;
+    int quantized_dimension = 0;
+
+    float scale() const { return scales.empty() ? 0.0f : scales[0]; }
+    int32_t zero_point() const { return zero_points.empty() ? 0 : zero_points[0]; }
+    bool is_constant() const { return data != nullptr; }
+    size_t num_elements() const;
+};
+
+struct OperatorInfo {
+    int builtin = -1;
+    int version = 1;
+    std::vector<int> inputs;
+    std::vector<int> outputs;
+
+    // Opções (as que os operadores suportados usam)
+    int padding = kPaddingSame;
+    int stride_w = 1, stride_h = 1;
+    int dilation_w = 1, dilation_h = 1;
+    int depth_multiplier = 1;
+    int activation = 0;
+    bool keep_dims = false;
+};
+
+class TfliteModel {
+public:
+    // Mapeia o arquivo e interpreta o subgrafo principal
+    static std::shared_ptr<const TfliteModel> load(const std::string &path, std::string *error);
+    // Interpreta um modelo já em memória (ex.: fire_model.h); o buffer deve sobreviver ao modelo
+    static std::shared_ptr<const TfliteModel> from_buffer(const uint8_t *data, size_t size,
+                                                          std::string *error);
+    ~TfliteModel();
+
+    const std::vector<TensorInfo> &tensors() const { return tensors_; }
+    const std::vector<OperatorInfo> &operators() const { return operators_; }
+    const std::vector<int> &inputs() const { return inputs_; }
+    const std::vector<int> &outputs() const { return outputs_; }
+    const std::string &path() const { return path_; }
+    size_t size() const { return size_; }
+
+private:
+    TfliteModel() = default;
+    bool parse(std::string *error);
+
+    std::string path_;
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+
+    std::vector<TensorInfo> tensors_;
+    std::vector<OperatorInfo> operators_;
+    std::vector<int> inputs_;
+    std::vector<int> outputs_;
+};
+
+const char *builtin_op_name(int op);
+
+} // namespace fire
@@ -0,0 +1,96 @@
+#include "thread_pool.h"
+
+namespace fire {
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    for (int i = 0; i < threads; i++) queues_.emplace_back(new Queue());
+    for (int i = 0; i < threads; i++) workers_.emplace_back(&ThreadPool::run, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &t : workers_) t.join();
+}
+
+void ThreadPool::submit(Task task) {
+    // Distribui em rodízio; o roubo corrige o desequilíbrio depois
+    // Os contadores sobem antes do push para nunca ficarem abaixo do
+    // número de tarefas que um worker pode retirar
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_++;
+        pending_++;
+    }
+    Queue &q = *queues_[next_++ % queues_.size()];
+    {
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::pop(int id, Task *task) {
+    // Própria fila pelo fim (LIFO, dados ainda quentes no cache)
+    {
+        Queue &q = *queues_[id];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            *task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+            return true;
+        }
+    }
+    // Rouba pelo início das filas vizinhas
+    for (size_t k = 1; k < queues_.size(); k++) {
+        Queue &q = *queues_[(id + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks.empty()) {
+            *task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(int id) {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+            if (stop_ && queued_ == 0) return;
+        }
+
+        Task task;
+        if (!pop(id, &task)) continue;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queued_--;
+        }
+        task(id);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void ThreadPool::parallel_for(size_t n, const std::function<void(size_t, int)> &fn) {
+    for (size_t i = 0; i < n; i++) {
+        submit([&fn, i](int worker) { fn(i, worker); });
+    }
+    wait();
+}
+
+} // namespace fire
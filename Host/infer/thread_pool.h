@@ -0,0 +1,54 @@
+#pragma once
+// Pool de threads com roubo de tarefas: cada worker tem sua fila; quando a
+// própria esvazia, rouba do início da fila de outro worker. Frames de custo
+// desigual (decode, pré-filtro) não deixam núcleos ociosos no fim do lote.
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fire {
+
+class ThreadPool {
+public:
+    // Tarefa recebe o índice do worker que a executa (estado por thread)
+    using Task = std::function<void(int worker)>;
+
+    explicit ThreadPool(int threads = 0); // 0 = número de núcleos
+    ~ThreadPool();
+
+    int size() const { return (int)workers_.size(); }
+
+    void submit(Task task);
+    // Bloqueia até todas as tarefas enviadas terminarem
+    void wait();
+    // Executa fn(i, worker) para i em [0, n) e espera
+    void parallel_for(size_t n, const std::function<void(size_t, int)> &fn);
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(int id);
+    bool pop(int id, Task *task);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_t> next_{0};
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    size_t queued_ = 0;  // Tarefas nas filas (protegido por mutex_)
+    size_t pending_ = 0; // Enviadas e ainda não concluídas (protegido por mutex_)
+    bool stop_ = false;
+};
+
+} // namespace fire
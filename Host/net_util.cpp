@@ -0,0 +1,148 @@
+#include "net_util.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static bool unix_address(const std::string &path, sockaddr_un *addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr->sun_path)) return false;
+    memcpy(addr->sun_path, path.c_str(), path.size());
+    return true;
+}
+
+int net_listen_unix(const std::string &path) {
+    sockaddr_un addr;
+    if (!unix_address(path, &addr)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    unlink(path.c_str());
+    if (bind(fd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 128) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int net_listen_tcp(const std::string &host, int port) {
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1) return -1;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 128) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int net_connect_unix(const std::string &path) {
+    sockaddr_un addr;
+    if (!unix_address(path, &addr)) return -1;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    if (connect(fd, (sockaddr *)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int net_connect_tcp(const std::string &host, int port) {
+    addrinfo hints, *res = nullptr;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &res) != 0 || !res) return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd >= 0 && connect(fd, res->ai_addr, res->ai_addrlen) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(res);
+    if (fd >= 0) {
+        // Requisições pequenas em sequência: sem esperar o Nagle
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    return fd;
+}
+
+bool net_read_all(int fd, void *buf, size_t n) {
+    uint8_t *p = (uint8_t *)buf;
+    while (n > 0) {
+        ssize_t r = read(fd, p, n);
+        if (r <= 0) return false;
+        p += r;
+        n -= (size_t)r;
+    }
+    return true;
+}
+
+bool net_write_all(int fd, const void *buf, size_t n) {
+    const uint8_t *p = (const uint8_t *)buf;
+    while (n > 0) {
+        ssize_t r = send(fd, p, n, MSG_NOSIGNAL);
+        if (r <= 0) return false;
+        p += r;
+        n -= (size_t)r;
+    }
+    return true;
+}
+
+bool http_read(int fd, std::string &pending, HttpMessage *msg, size_t max_body) {
+    static const size_t kMaxHeader = 16 * 1024;
+    size_t end;
+    while ((end = pending.find("\r\n\r\n")) == std::string::npos) {
+        if (pending.size() > kMaxHeader) return false;
+        char buf[4096];
+        ssize_t r = read(fd, buf, sizeof(buf));
+        if (r <= 0) return false;
+        pending.append(buf, (size_t)r);
+    }
+
+    msg->headers.clear();
+    size_t line_end = pending.find("\r\n");
+    msg->start_line = pending.substr(0, line_end);
+    size_t pos = line_end + 2;
+    while (pos < end) {
+        size_t next = pending.find("\r\n", pos);
+        std::string line = pending.substr(pos, next - pos);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            std::string name = line.substr(0, colon);
+            for (char &c : name) c = (char)tolower((unsigned char)c);
+            size_t v = line.find_first_not_of(' ', colon + 1);
+            msg->headers[name] = v == std::string::npos ? "" : line.substr(v);
+        }
+        pos = next + 2;
+    }
+
+    size_t length = 0;
+    auto it = msg->headers.find("content-length");
+    if (it != msg->headers.end()) length = strtoul(it->second.c_str(), nullptr, 10);
+    if (length > max_body) return false;
+
+    const size_t body_start = end + 4;
+    const size_t have = std::min(pending.size() - body_start, length);
+    msg->body.assign(pending.begin() + body_start, pending.begin() + body_start + have);
+    pending.erase(0, body_start + have);
+    if (have < length) {
+        msg->body.resize(length);
+        if (!net_read_all(fd, msg->body.data() + have, length - have)) return false;
+    }
+    return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+// Sockets bloqueantes e HTTP/1.1 mínimo para as ferramentas do host
+// (fire_server e o gerador de carga). Funções retornam -1 / false em erro.
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Protocolo do socket Unix do fire_server: o cliente envia [u32 LE tamanho]
+// [JPEG] e recebe [f32 LE score] por frame, na ordem (score < 0 = falha)
+#define FIRE_FRAME_MAX_BYTES (8u * 1024 * 1024)
+
+int net_listen_unix(const std::string &path);
+int net_listen_tcp(const std::string &addr, int port);
+int net_connect_unix(const std::string &path);
+int net_connect_tcp(const std::string &host, int port);
+
+bool net_read_all(int fd, void *buf, size_t n);
+bool net_write_all(int fd, const void *buf, size_t n);
+
+struct HttpMessage {
+    std::string start_line;                     // "POST /score HTTP/1.1" ou "HTTP/1.1 200 OK"
+    std::map<std::string, std::string> headers; // Nomes em minúsculas
+    std::vector<uint8_t> body;
+};
+
+// Lê uma mensagem (cabeçalho + corpo por Content-Length). `pending` guarda
+// os bytes já lidos da próxima mensagem na mesma conexão (keep-alive).
+bool http_read(int fd, std::string &pending, HttpMessage *msg, size_t max_body);
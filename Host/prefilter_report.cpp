@@ -0,0 +1,90 @@
+// Relatório do pré-filtro de cor/brilho sobre um split do dataset.
+// Usa o mesmo pré-processamento do firmware (recorte quadrado + resize + gamma)
+// e conta quantos frames seriam pulados e quantos deles têm fogo rotulado.
+//
+// Uso: prefilter_report [--split test] [--data DIR] [--gamma 12]
+//                       [--fire-r-min N] [--bright-min N]
+//                       [--fire-ratio N] [--bright-ratio N] [-v]
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "dataset.h"
+#include "preprocess.h"
+
+int main(int argc, char **argv) {
+    std::string data_dir = FIRE_DATA_DIR;
+    std::string split = "test";
+    float gamma = 12.0f;
+    bool verbose = false;
+
+    prefilter_config_t cfg;
+    prefilter_default_config(&cfg);
+    cfg.enabled = true;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--gamma" && has_val) gamma = strtof(argv[++i], nullptr);
+        else if (a == "--fire-r-min" && has_val) cfg.fire_r_min = (uint8_t)atoi(argv[++i]);
+        else if (a == "--bright-min" && has_val) cfg.bright_min = (uint8_t)atoi(argv[++i]);
+        else if (a == "--fire-ratio" && has_val) cfg.fire_ratio_min = (uint16_t)atoi(argv[++i]);
+        else if (a == "--bright-ratio" && has_val) cfg.bright_ratio_min = (uint16_t)atoi(argv[++i]);
+        else if (a == "-v") verbose = true;
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<DatasetImage> images = dataset_list(data_dir, split);
+    if (images.empty()) {
+        fprintf(stderr, "Nenhuma imagem em %s/%s/images\n", data_dir.c_str(), split.c_str());
+        return 1;
+    }
+
+    uint8_t lut[256];
+    preprocess_build_gamma_lut(gamma, lut);
+    std::vector<uint8_t> rgb, dst(DST_W * DST_H * 3);
+
+    int total = 0, fire = 0, skipped = 0, false_skips = 0, decode_errors = 0;
+    for (const DatasetImage &img : images) {
+        int w, h;
+        if (!jpeg_decode_file(img.image_path, rgb, w, h)) {
+            decode_errors++;
+            continue;
+        }
+        bool is_fire;
+        if (!dataset_label(img, w, h, is_fire)) continue;
+
+        prefilter_stats_t st = {};
+        preprocess_square_crop(rgb.data(), w, h, lut, dst.data(), &cfg, &st);
+        bool skip = prefilter_is_benign(&cfg, &st);
+
+        total++;
+        fire += is_fire;
+        skipped += skip;
+        false_skips += skip && is_fire;
+
+        if (verbose) {
+            printf("%-6s %-5s fogo=%5u brilho=%5u luma_med=%3u luma_max=%3u  %s\n",
+                   skip ? "PULA" : "CNN", is_fire ? "FOGO" : "-",
+                   st.fire_pixels, st.bright_pixels, st.luma_sum / st.pixels, st.luma_max,
+                   img.image_path.substr(img.image_path.find_last_of('/') + 1).c_str());
+        }
+    }
+
+    printf("split=%s gamma=%.1f fire_r_min=%u bright_min=%u fire_ratio=%u bright_ratio=%u\n",
+           split.c_str(), gamma, cfg.fire_r_min, cfg.bright_min, cfg.fire_ratio_min,
+           cfg.bright_ratio_min);
+    printf("imagens=%d fogo=%d sem_fogo=%d erros_decode=%d\n", total, fire, total - fire,
+           decode_errors);
+    printf("pulados=%d (%.1f%%) falsos_pulos=%d (%.1f%% do fogo) pulados_sem_fogo=%d (%.1f%% do sem fogo)\n",
+           skipped, total ? 100.0 * skipped / total : 0.0, false_skips,
+           fire ? 100.0 * false_skips / fire : 0.0, skipped - false_skips,
+           total - fire ? 100.0 * (skipped - false_skips) / (total - fire) : 0.0);
+    return 0;
+}
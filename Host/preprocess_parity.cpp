@@ -0,0 +1,268 @@
+// Paridade do pré-processamento entre o firmware e o fire_classifier.py: as
+// duas definições rodam sobre as mesmas imagens e o relatório mostra a
+// divergência por pixel (entrada 96x96 da CNN) e no score. O mesmo modelo
+// pontua tudo, então qualquer diferença vem só do pré-processamento.
+//   firmware  recorte quadrado central (min(w, h)), resize nearest e LUT de
+//             gamma 12 (preprocess_square_crop do Firmware/main)
+//   python    recorte central de 300 px, gamma 0.1 (expoente 1 / 0.1 = 10,
+//             utils/gamma.py) antes do cv2.resize INTER_LINEAR
+// Uma tabela de candidatas (combinações de recorte, resize e gamma) com
+// acurácia, AUC, custo por frame e concordância com o firmware ajuda a
+// escolher um pipeline canônico para os dois ambientes.
+//
+// Cada imagem do dataset vira primeiro um frame de câmera de --frame pixels
+// (bilinear); os dois ambientes recebem o mesmo frame. O bilinear daqui usa
+// float e arredonda; o do OpenCV usa pesos de 11 bits: até 1 nível de
+// diferença por canal.
+//
+// Uso: preprocess_parity [--split test] [--data DIR] [--model ARQ] [--frame 640x480]
+//                        [--a firmware] [--b python] [--threshold 0.60] [-v]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "infer/fire_infer.h"
+#include "dataset.h"
+#include "preprocess.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t kInputBytes = DST_W * DST_H * 3;
+
+// Uma definição de pré-processamento. crop = 0: quadrado do menor lado.
+// exponent = 0: sem gamma. O gamma sempre vem antes do resize (no nearest a
+// ordem não muda o resultado).
+struct Pipeline {
+    const char *name;
+    int crop;
+    bool bilinear;
+    double exponent;
+    const char *note;
+};
+
+static const Pipeline kPipelines[] = {
+    {"firmware", 0, false, 12.0, "Firmware/main"},
+    {"python", 300, true, 10.0, "fire_classifier.py"},
+    {"square-bilinear-g12", 0, true, 12.0, "recorte do firmware, resize do python"},
+    {"square-nearest-g10", 0, false, 10.0, "firmware com o gamma do python"},
+    {"crop300-nearest-g12", 300, false, 12.0, "recorte do python, resto do firmware"},
+    {"square-bilinear-nogamma", 0, true, 0.0, "como no treino (sem gamma)"},
+};
+
+static const Pipeline *find_pipeline(const std::string &name) {
+    for (const Pipeline &p : kPipelines) {
+        if (name == p.name) return &p;
+    }
+    return nullptr;
+}
+
+// LUT com o arredondamento de cada ambiente: powf + truncamento no firmware,
+// float64 + astype(uint8) (truncamento) no numpy
+static void build_lut(const Pipeline &p, uint8_t lut[256]) {
+    if (!strcmp(p.name, "firmware")) {
+        preprocess_build_gamma_lut((float)p.exponent, lut);
+        return;
+    }
+    for (int i = 0; i < 256; i++) {
+        lut[i] = p.exponent > 0.0 ? (uint8_t)std::min(255.0, std::pow(i / 255.0, p.exponent) * 255.0) : (uint8_t)i;
+    }
+}
+
+struct Preprocessor {
+    const Pipeline *def;
+    uint8_t lut[256];
+    std::vector<uint8_t> roi; // Recorte com gamma (caminho bilinear)
+
+    // Frame RGB (w x h) -> entrada DST_W x DST_H x 3
+    void run(const uint8_t *rgb, int w, int h, uint8_t *dst) {
+        const int crop = def->crop > 0 ? std::min(def->crop, std::min(w, h)) : std::min(w, h);
+        const int x0 = (w - crop) / 2, y0 = (h - crop) / 2;
+        if (!def->bilinear) {
+            preprocess_crop(rgb, w, h, x0, y0, crop, lut, dst, nullptr, nullptr);
+            return;
+        }
+        roi.resize((size_t)crop * crop * 3);
+        for (int y = 0; y < crop; y++) {
+            const uint8_t *src = rgb + ((size_t)(y0 + y) * w + x0) * 3;
+            uint8_t *out = roi.data() + (size_t)y * crop * 3;
+            for (int i = 0; i < crop * 3; i++) out[i] = lut[src[i]];
+        }
+        rgb_resize_bilinear(roi.data(), crop, crop, dst, DST_W, DST_H);
+    }
+};
+
+struct Result {
+    std::vector<float> scores;
+    std::vector<std::vector<uint8_t>> inputs;
+    double us = 0.0; // Soma do tempo de pré-processamento
+};
+
+struct Counts {
+    int tp = 0, fp = 0, tn = 0, fn = 0;
+};
+
+// AUC pela estatística de Mann-Whitney (empates contam meio)
+static double roc_auc(const std::vector<float> &scores, const std::vector<bool> &truth) {
+    std::vector<size_t> idx(scores.size());
+    for (size_t i = 0; i < idx.size(); i++) idx[i] = i;
+    std::sort(idx.begin(), idx.end(), [&](size_t a, size_t b) { return scores[a] < scores[b]; });
+    double rank_sum = 0.0;
+    int pos = 0;
+    for (size_t i = 0; i < idx.size();) {
+        size_t j = i;
+        while (j < idx.size() && scores[idx[j]] == scores[idx[i]]) j++;
+        for (size_t k = i; k < j; k++) {
+            if (truth[idx[k]]) {
+                rank_sum += (i + 1 + j) / 2.0;
+                pos++;
+            }
+        }
+        i = j;
+    }
+    const int neg = (int)scores.size() - pos;
+    return pos && neg ? (rank_sum - pos * (pos + 1) / 2.0) / ((double)pos * neg) : 0.0;
+}
+
+int main(int argc, char **argv) {
+    std::string data_dir = FIRE_DATA_DIR, split = "test", model_path = FIRE_MODEL_PATH;
+    std::string name_a = "firmware", name_b = "python";
+    int frame_w = 640, frame_h = 480;
+    float threshold = 0.60f;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--model" && has_val) model_path = argv[++i];
+        else if (a == "--frame" && has_val && sscanf(argv[i + 1], "%dx%d", &frame_w, &frame_h) == 2) i++;
+        else if (a == "--a" && has_val) name_a = argv[++i];
+        else if (a == "--b" && has_val) name_b = argv[++i];
+        else if (a == "--threshold" && has_val) threshold = strtof(argv[++i], nullptr);
+        else if (a == "-v") verbose = true;
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+    const Pipeline *def_a = find_pipeline(name_a), *def_b = find_pipeline(name_b);
+    if (!def_a || !def_b || frame_w <= 0 || frame_h <= 0) {
+        fprintf(stderr, "Pipelines:");
+        for (const Pipeline &p : kPipelines) fprintf(stderr, " %s", p.name);
+        fprintf(stderr, "\n");
+        return 2;
+    }
+
+    std::string err;
+    std::shared_ptr<const fire::TfliteModel> model = fire::TfliteModel::load(model_path, &err);
+    std::unique_ptr<fire::Classifier> classifier;
+    if (model) classifier = fire::Classifier::create(model, 1, 12.0f, &err);
+    if (!classifier) {
+        fprintf(stderr, "Falha ao carregar %s: %s\n", model_path.c_str(), err.c_str());
+        return 1;
+    }
+
+    // Frames de câmera e rótulos (caixas medidas na imagem original)
+    std::vector<DatasetImage> images = dataset_list(data_dir, split);
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<std::string> names;
+    std::vector<bool> truth;
+    std::vector<uint8_t> rgb;
+    for (const DatasetImage &img : images) {
+        int w, h;
+        if (!jpeg_decode_file(img.image_path, rgb, w, h)) continue;
+        bool fire;
+        if (!dataset_label(img, w, h, fire)) continue;
+        truth.push_back(fire);
+        names.push_back(img.image_path);
+        frames.emplace_back((size_t)frame_w * frame_h * 3);
+        rgb_resize_bilinear(rgb.data(), w, h, frames.back().data(), frame_w, frame_h);
+    }
+    if (frames.empty()) {
+        fprintf(stderr, "Nenhuma imagem em %s/%s/images\n", data_dir.c_str(), split.c_str());
+        return 1;
+    }
+
+    const size_t n_pipes = sizeof(kPipelines) / sizeof(kPipelines[0]);
+    std::vector<Result> results(n_pipes);
+    for (size_t p = 0; p < n_pipes; p++) {
+        Preprocessor pre;
+        pre.def = &kPipelines[p];
+        build_lut(kPipelines[p], pre.lut);
+        Result &r = results[p];
+        for (const std::vector<uint8_t> &frame : frames) {
+            r.inputs.emplace_back(kInputBytes);
+            Clock::time_point t0 = Clock::now();
+            pre.run(frame.data(), frame_w, frame_h, r.inputs.back().data());
+            r.us += std::chrono::duration<double, std::micro>(Clock::now() - t0).count();
+            float score = 0.0f;
+            classifier->predict_input(r.inputs.back().data(), &score);
+            r.scores.push_back(score);
+        }
+    }
+
+    // Divergência A x B
+    const Result &ra = results[def_a - kPipelines], &rb = results[def_b - kPipelines];
+    double abs_sum = 0.0, sq_sum = 0.0, score_sum = 0.0;
+    int max_diff = 0, flips = 0;
+    size_t big = 0;
+    std::vector<float> score_deltas;
+    for (size_t i = 0; i < frames.size(); i++) {
+        for (size_t k = 0; k < kInputBytes; k++) {
+            int d = std::abs((int)ra.inputs[i][k] - (int)rb.inputs[i][k]);
+            abs_sum += d;
+            sq_sum += (double)d * d;
+            max_diff = std::max(max_diff, d);
+            big += d > 8;
+        }
+        const float ds = std::fabs(ra.scores[i] - rb.scores[i]);
+        score_sum += ds;
+        score_deltas.push_back(ds);
+        const bool flip = (ra.scores[i] > threshold) != (rb.scores[i] > threshold);
+        flips += flip;
+        if (verbose && flip) {
+            printf("  %s: %s %.3f, %s %.3f\n", names[i].c_str(), def_a->name, ra.scores[i], def_b->name,
+                   rb.scores[i]);
+        }
+    }
+    std::sort(score_deltas.begin(), score_deltas.end());
+    const double values = (double)frames.size() * kInputBytes;
+    const double mse = sq_sum / values;
+    printf("split=%s imagens=%zu frame=%dx%d limiar=%.2f\n", split.c_str(), frames.size(), frame_w, frame_h,
+           threshold);
+    printf("%s x %s:\n", def_a->name, def_b->name);
+    printf("  pixels: |delta| medio %.2f, max %d, %.1f%% acima de 8 niveis, PSNR %.1f dB\n", abs_sum / values,
+           max_diff, 100.0 * big / values, mse > 0 ? 10.0 * std::log10(255.0 * 255.0 / mse) : INFINITY);
+    printf("  score:  |delta| medio %.3f, p95 %.3f, max %.3f; %d decisoes diferentes\n", score_sum / frames.size(),
+           score_deltas[score_deltas.size() * 95 / 100], score_deltas.back(), flips);
+
+    // Candidatas a pipeline canônico
+    const Result &fw = results[0];
+    printf("Candidatas:\n  %-24s %8s %8s %7s %9s %11s  %s\n", "pipeline", "acuracia", "F1", "AUC", "us/frame",
+           "=firmware", "");
+    for (size_t p = 0; p < n_pipes; p++) {
+        const Result &r = results[p];
+        Counts c;
+        int agree = 0;
+        for (size_t i = 0; i < frames.size(); i++) {
+            const bool pred = r.scores[i] > threshold;
+            if (truth[i]) pred ? c.tp++ : c.fn++;
+            else pred ? c.fp++ : c.tn++;
+            agree += pred == (fw.scores[i] > threshold);
+        }
+        const int f1_den = 2 * c.tp + c.fp + c.fn;
+        printf("  %-24s %7.1f%% %8.3f %7.4f %9.1f %10.1f%%  %s\n", kPipelines[p].name,
+               100.0 * (c.tp + c.tn) / frames.size(), f1_den ? 2.0 * c.tp / f1_den : 0.0, roc_auc(r.scores, truth),
+               r.us / frames.size(), 100.0 * agree / frames.size(), kPipelines[p].note);
+    }
+    return 0;
+}
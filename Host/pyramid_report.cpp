@@ -0,0 +1,136 @@
+// Relatório da pirâmide de escalas (Firmware/main/pyramid.h) sobre um split do
+// dataset: recall e precisão só com o frame inteiro vs frame inteiro + recortes
+// com zoom, separando os frames em que todo fogo rotulado é pequeno. Cada
+// imagem é tratada como uma cena estática: depois de uma rodada completa do
+// rodízio, o score combinado é o maior entre o frame inteiro e os recortes
+// (estes só acima de --zoom-threshold, como em pyramid_update).
+//
+// Uso: pyramid_report [--model ARQ] [--split test] [--data DIR] [--zoom 2]
+//                     [--threshold 0.60] [--zoom-threshold 0.90] [--small 0.05] [--gamma 12]
+//                     [--kernels ref|avx2|vnni] [-v]
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "infer/fire_infer.h"
+#include "dataset.h"
+#include "pyramid.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+struct Counts {
+    int tp = 0, fp = 0, tn = 0, fn = 0;
+    void add(bool truth, bool pred) {
+        if (truth) pred ? tp++ : fn++;
+        else pred ? fp++ : tn++;
+    }
+};
+
+static void print_row(const char *name, const Counts &c) {
+    printf("  %-24s recall %5.1f%% (%d/%d)  prec %5.1f%%  FP %d\n", name,
+           c.tp + c.fn ? 100.0 * c.tp / (c.tp + c.fn) : 0.0, c.tp, c.tp + c.fn,
+           c.tp + c.fp ? 100.0 * c.tp / (c.tp + c.fp) : 0.0, c.fp);
+}
+
+int main(int argc, char **argv) {
+    std::string model_path = FIRE_MODEL_PATH, data_dir = FIRE_DATA_DIR, split = "test";
+    float threshold = 0.60f, zoom_threshold = PYRAMID_ZOOM_THRESHOLD, small = 0.05f, gamma = 12.0f;
+    int zoom = 2;
+    fire::KernelIsa isa = fire::kIsaAuto;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--model" && has_val) model_path = argv[++i];
+        else if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--zoom" && has_val) zoom = atoi(argv[++i]);
+        else if (a == "--threshold" && has_val) threshold = strtof(argv[++i], nullptr);
+        else if (a == "--zoom-threshold" && has_val) zoom_threshold = strtof(argv[++i], nullptr);
+        else if (a == "--small" && has_val) small = strtof(argv[++i], nullptr);
+        else if (a == "--gamma" && has_val) gamma = strtof(argv[++i], nullptr);
+        else if (a == "--kernels" && has_val) {
+            isa = fire::parse_kernel_isa(argv[++i]);
+            if (isa == fire::kIsaAuto) {
+                fprintf(stderr, "Kernels desconhecidos: %s (ref, avx2, vnni)\n", argv[i]);
+                return 2;
+            }
+        } else if (a == "-v") verbose = true;
+        else {
+            fprintf(stderr, "Argumento desconhecido: %s\n", a.c_str());
+            return 2;
+        }
+    }
+
+    std::string err;
+    std::shared_ptr<const fire::TfliteModel> model = fire::TfliteModel::load(model_path, &err);
+    fire::InterpreterOptions options;
+    options.isa = isa;
+    std::unique_ptr<fire::Classifier> classifier;
+    if (model) classifier = fire::Classifier::create(model, 1, gamma, &err, options);
+    if (!classifier) {
+        fprintf(stderr, "Falha ao carregar %s: %s\n", model_path.c_str(), err.c_str());
+        return 1;
+    }
+    std::vector<DatasetImage> images = dataset_list(data_dir, split);
+    if (images.empty()) {
+        fprintf(stderr, "Nenhuma imagem em %s/%s/images\n", data_dir.c_str(), split.c_str());
+        return 1;
+    }
+
+    // Scores em float aqui; o firmware faz o mesmo máximo no domínio quantizado
+    Counts full_small, full_large, pyr_small, pyr_large;
+    std::vector<uint8_t> rgb;
+    int frames = 0, tiles = 0;
+    for (const DatasetImage &img : images) {
+        int w, h;
+        if (!jpeg_decode_file(img.image_path, rgb, w, h)) continue;
+        float largest = 0.0f;
+        bool fire;
+        if (!dataset_label(img, w, h, fire, &largest)) continue;
+        const bool is_small = fire && largest < small;
+
+        float full;
+        if (!classifier->predict_rgb(rgb.data(), w, h, &full)) continue;
+        pyramid_t p;
+        pyramid_init(&p, w, h, zoom, 0, 0, nullptr);
+        float best_zoom = 0.0f;
+        for (int t = 0; t < p.n_tiles; t++) {
+            const classifier_crop_t &c = p.tiles[t];
+            float s;
+            if (classifier->predict_crop(rgb.data(), w, h, c.x, c.y, c.size, &s) && s > best_zoom) best_zoom = s;
+        }
+        const float merged = best_zoom > zoom_threshold && best_zoom > full ? best_zoom : full;
+        frames++;
+        tiles = p.n_tiles;
+
+        // Frames sem fogo entram nas duas linhas (falsos positivos)
+        if (!fire || is_small) {
+            full_small.add(fire, full > threshold);
+            pyr_small.add(fire, merged > threshold);
+        }
+        if (!fire || !is_small) {
+            full_large.add(fire, full > threshold);
+            pyr_large.add(fire, merged > threshold);
+        }
+        if (verbose && fire && (full > threshold) != (merged > threshold)) {
+            printf("%s: inteiro %.3f, recortes %.3f (maior caixa %.1f%% do frame)\n", img.image_path.c_str(), full,
+                   best_zoom, largest * 100.0f);
+        }
+    }
+    if (!frames) return 1;
+
+    printf("split=%s imagens=%d limiar=%.2f zoom=%dx (%d recortes na ultima imagem)\n", split.c_str(), frames,
+           threshold, zoom, tiles);
+    printf("Fogo pequeno (maior caixa < %.0f%% do frame):\n", small * 100.0f);
+    print_row("frame inteiro", full_small);
+    print_row("frame inteiro + recortes", pyr_small);
+    printf("Demais frames com fogo:\n");
+    print_row("frame inteiro", full_large);
+    print_row("frame inteiro + recortes", pyr_large);
+    printf("Custo: 1 Invoke por frame sem pirâmide, no máximo 2 com ela (rodada completa em %d frames)\n", tiles);
+    return 0;
+}
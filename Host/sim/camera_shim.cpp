@@ -0,0 +1,288 @@
+// Câmera virtual e img_converters: frames JPEG na resolução do sensor,
+// entregues em rodízio com o timestamp da captura e, opcionalmente, no
+// ritmo de um sensor com jitter e perdas (SimCameraTiming em sim.h)
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <sys/time.h>
+#include <thread>
+#include <vector>
+#include "dataset.h"
+#include "esp_camera.h"
+#include "esp_timer.h"
+#include "img_converters.h"
+#include "sim.h"
+
+namespace {
+
+struct Camera {
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> frames;
+    int width = 320, height = 240;
+    camera_fb_t fb = {};
+    bool fb_out = false; // Um frame emprestado por vez (fb_count = 1)
+    SimCameraTiming timing;
+    int64_t start_us = 0; // Captura 0 do relógio do sensor
+    int64_t last_k = -1;  // Última captura entregue
+    SimCameraStats stats = {};
+};
+
+Camera &camera() {
+    static Camera c;
+    return c;
+}
+
+// Sorteio determinístico por captura (splitmix64): u em [0, 1)
+double capture_rand(uint32_t seed, int64_t k, uint32_t stream) {
+    uint64_t z = ((uint64_t)seed << 32 | stream) ^ (uint64_t)k * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return (z >> 11) * (1.0 / 9007199254740992.0);
+}
+
+bool capture_dropped(const Camera &c, int64_t k) {
+    return c.timing.drop_rate > 0.0f && capture_rand(c.timing.seed, k, 1) < c.timing.drop_rate;
+}
+
+// Instante da captura k no relógio do esp_timer. O desvio é limitado a
+// menos de meio período para as capturas não trocarem de ordem.
+int64_t capture_time_us(const Camera &c, int64_t k) {
+    const double period = 1e6 / c.timing.fps;
+    const double jitter = std::min((double)c.timing.jitter_ms * 1000.0, period * 0.49);
+    return c.start_us + (int64_t)(k * period + (capture_rand(c.timing.seed, k, 2) * 2.0 - 1.0) * jitter);
+}
+
+// Codifica um frame como o sensor entregaria: resize para a resolução
+// configurada e JPEG na qualidade do sensor; keep_exact mantém os bytes de
+// um frame que já está na resolução (gravado do próprio dispositivo)
+bool add_frame(const uint8_t *jpg, size_t len, int width, int height, int quality, bool keep_exact,
+               std::vector<std::vector<uint8_t>> &frames) {
+    std::vector<uint8_t> rgb, scaled;
+    int w, h;
+    if (!jpeg_decode(jpg, len, rgb, w, h)) return false;
+    if (keep_exact && w == width && h == height) {
+        frames.emplace_back(jpg, jpg + len);
+        return true;
+    }
+    // jpeg_quality do sensor: 0-63, menor = melhor (12 no firmware ~ 85 no libjpeg)
+    const int libjpeg_quality = 100 - std::min(std::max(quality, 0), 63) * 80 / 63;
+    // O sensor entrega a cena inteira na resolução configurada
+    scaled.resize((size_t)width * height * 3);
+    rgb_resize_bilinear(rgb.data(), w, h, scaled.data(), width, height);
+    frames.emplace_back();
+    return jpeg_encode(scaled.data(), width, height, libjpeg_quality, frames.back());
+}
+
+// Fim do JPEG que começa em data[0] (SOI): segue os segmentos até o SOS e
+// procura o EOI nos dados entrópicos (FF 00 e RSTn não são marcadores), para
+// não cortar no EOI de uma miniatura EXIF. Devolve 0 se o frame estiver truncado.
+size_t jpeg_end(const uint8_t *data, size_t len) {
+    size_t i = 2;
+    while (i + 4 <= len) {
+        if (data[i] != 0xFF) return 0;
+        uint8_t marker = data[i + 1];
+        if (marker == 0xFF) {
+            i++; // Preenchimento
+            continue;
+        }
+        size_t seg = (size_t)data[i + 2] << 8 | data[i + 3];
+        i += 2 + seg;
+        if (marker != 0xDA) continue;
+        // Dados entrópicos até um marcador de verdade
+        while (i + 1 < len) {
+            if (data[i] == 0xFF && data[i + 1] != 0x00 && !(data[i + 1] >= 0xD0 && data[i + 1] <= 0xD7)) {
+                if (data[i + 1] == 0xD9) return i + 2;
+                break; // Outro segmento (JPEG progressivo): volta ao laço externo
+            }
+            i++;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+void sim_camera_set_frames(std::vector<std::vector<uint8_t>> jpgs, int width, int height) {
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.frames = std::move(jpgs);
+    c.width = width;
+    c.height = height;
+    c.last_k = -1;
+}
+
+void sim_camera_set_timing(const SimCameraTiming &timing) {
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    c.timing = timing;
+    c.start_us = esp_timer_get_time();
+    c.last_k = -1;
+    c.stats = {};
+}
+
+void sim_camera_get_stats(SimCameraStats *out) {
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    *out = c.stats;
+}
+
+int sim_camera_width() { return camera().width; }
+int sim_camera_height() { return camera().height; }
+
+size_t sim_camera_frame_count() {
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    return c.frames.size();
+}
+
+bool sim_camera_frame(size_t i, std::vector<uint8_t> &jpg) {
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if (i >= c.frames.size()) return false;
+    jpg = c.frames[i];
+    return true;
+}
+
+bool sim_camera_load_images(const std::vector<std::string> &paths, int width, int height, int quality,
+                            std::string *error) {
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> jpg;
+    for (const std::string &p : paths) {
+        // As fotos do dataset sempre passam pelo "sensor", mesmo já em QVGA
+        if (!read_file(p, jpg) || !add_frame(jpg.data(), jpg.size(), width, height, quality, false, frames)) {
+            if (error) *error = "falha ao carregar " + p;
+            return false;
+        }
+    }
+    sim_camera_set_frames(std::move(frames), width, height);
+    return true;
+}
+
+bool sim_camera_load_mjpeg(const std::string &path, int width, int height, int quality, std::string *error) {
+    std::vector<uint8_t> data;
+    if (!read_file(path, data)) {
+        if (error) *error = "falha ao ler " + path;
+        return false;
+    }
+    // Qualquer coisa entre os frames (cabeçalhos multipart do /stream) é ignorada
+    std::vector<std::vector<uint8_t>> frames;
+    for (size_t i = 0; i + 1 < data.size();) {
+        if (data[i] != 0xFF || data[i + 1] != 0xD8) {
+            i++;
+            continue;
+        }
+        size_t n = jpeg_end(data.data() + i, data.size() - i);
+        if (!n) {
+            i += 2; // SOI solto ou último frame truncado (gravação interrompida)
+            continue;
+        }
+        if (!add_frame(data.data() + i, n, width, height, quality, true, frames)) {
+            if (error) *error = "frame corrompido no byte " + std::to_string(i) + " de " + path;
+            return false;
+        }
+        i += n;
+    }
+    if (frames.empty()) {
+        if (error) *error = "nenhum frame JPEG em " + path;
+        return false;
+    }
+    sim_camera_set_frames(std::move(frames), width, height);
+    return true;
+}
+
+static int sensor_noop(sensor_t *, int) { return 0; }
+
+esp_err_t esp_camera_init(const camera_config_t *config) {
+    static const int sizes[][2] = {{96, 96},   {160, 120}, {176, 144}, {240, 176}, {240, 240},
+                                   {320, 240}, {400, 296}, {480, 320}, {640, 480}};
+    if (config->pixel_format != PIXFORMAT_JPEG || config->frame_size > FRAMESIZE_VGA) return ESP_ERR_INVALID_ARG;
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    // Frames já carregados pela simulação mantêm a resolução deles
+    if (c.frames.empty()) {
+        c.width = sizes[config->frame_size][0];
+        c.height = sizes[config->frame_size][1];
+    }
+    return ESP_OK;
+}
+
+sensor_t *esp_camera_sensor_get(void) {
+    static sensor_t s = {sensor_noop, sensor_noop, sensor_noop, sensor_noop, sensor_noop};
+    return &s;
+}
+
+camera_fb_t *esp_camera_fb_get(void) {
+    Camera &c = camera();
+    std::unique_lock<std::mutex> lock(c.mutex);
+    if (c.frames.empty() || c.fb_out) return nullptr;
+    // Reservado já: a espera pela próxima captura solta o mutex, e outra
+    // tarefa não pode pegar o mesmo buffer nesse meio-tempo
+    c.fb_out = true;
+
+    int64_t now = esp_timer_get_time(), k, captured_us;
+    if (c.timing.fps <= 0.0f) {
+        // Sem ritmo: o próximo frame que o sensor não perdeu, capturado agora
+        k = c.last_k + 1;
+        while (capture_dropped(c, k)) {
+            c.stats.dropped++;
+            k++;
+        }
+        captured_us = now;
+    } else {
+        // Captura mais recente já feita; se o firmware já a leu, espera a próxima
+        const double period = 1e6 / c.timing.fps;
+        k = std::max<int64_t>((int64_t)((now - c.start_us) / period) + 1, 0);
+        while (k >= 0 && (capture_time_us(c, k) > now || capture_dropped(c, k))) k--;
+        if (k <= c.last_k) {
+            k = c.last_k + 1;
+            while (capture_dropped(c, k)) k++;
+            captured_us = capture_time_us(c, k);
+            lock.unlock();
+            std::this_thread::sleep_for(std::chrono::microseconds(captured_us - now));
+            lock.lock();
+            now = esp_timer_get_time();
+            if (c.frames.empty()) {
+                c.fb_out = false;
+                return nullptr;
+            }
+        }
+        captured_us = capture_time_us(c, k);
+        for (int64_t j = c.last_k + 1; j < k; j++) {
+            if (capture_dropped(c, j)) c.stats.dropped++;
+            else c.stats.overwritten++;
+        }
+    }
+    c.last_k = k;
+    std::vector<uint8_t> &jpg = c.frames[(size_t)(k % (int64_t)c.frames.size())];
+
+    const int64_t age = std::max<int64_t>(now - captured_us, 0);
+    c.stats.served++;
+    c.stats.age_us_sum += (uint64_t)age;
+    c.stats.age_us_max = std::max(c.stats.age_us_max, (uint64_t)age);
+    c.fb.buf = jpg.data();
+    c.fb.len = jpg.size();
+    c.fb.width = (size_t)c.width;
+    c.fb.height = (size_t)c.height;
+    c.fb.format = PIXFORMAT_JPEG;
+    c.fb.timestamp.tv_sec = (time_t)(captured_us / 1000000);
+    c.fb.timestamp.tv_usec = (suseconds_t)(captured_us % 1000000);
+    return &c.fb;
+}
+
+void esp_camera_fb_return(camera_fb_t *fb) {
+    Camera &c = camera();
+    std::lock_guard<std::mutex> lock(c.mutex);
+    if (fb == &c.fb) c.fb_out = false;
+}
+
+bool fmt2rgb888(const uint8_t *src_buf, size_t src_len, pixformat_t format, uint8_t *rgb_buf) {
+    if (format != PIXFORMAT_JPEG || !src_buf) return false;
+    std::vector<uint8_t> rgb;
+    int w, h;
+    if (!jpeg_decode(src_buf, src_len, rgb, w, h)) return false;
+    // O buffer do firmware tem o tamanho do frame da câmera
+    if (w != sim_camera_width() || h != sim_camera_height()) return false;
+    std::copy(rgb.begin(), rgb.end(), rgb_buf);
+    return true;
+}
@@ -0,0 +1,525 @@
+// Shims do ESP-IDF e do FreeRTOS que não dependem de hardware
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <new>
+#include <sched.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "esp_err.h"
+#include "esp_heap_caps.h"
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "sim.h"
+
+using Clock = std::chrono::steady_clock;
+static const Clock::time_point g_boot = Clock::now();
+
+const char *esp_err_to_name(esp_err_t code) {
+    switch (code) {
+    case ESP_OK: return "ESP_OK";
+    case ESP_FAIL: return "ESP_FAIL";
+    case ESP_ERR_NO_MEM: return "ESP_ERR_NO_MEM";
+    case ESP_ERR_INVALID_ARG: return "ESP_ERR_INVALID_ARG";
+    case ESP_ERR_INVALID_SIZE: return "ESP_ERR_INVALID_SIZE";
+    case ESP_ERR_NOT_FOUND: return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_TIMEOUT: return "ESP_ERR_TIMEOUT";
+    case ESP_ERR_NVS_NOT_FOUND: return "ESP_ERR_NVS_NOT_FOUND";
+    case ESP_ERR_NVS_INVALID_LENGTH: return "ESP_ERR_NVS_INVALID_LENGTH";
+    case ESP_ERR_HTTPD_RESP_HDR: return "ESP_ERR_HTTPD_RESP_HDR";
+    default: return "ERRO_DESCONHECIDO";
+    }
+}
+
+int64_t esp_timer_get_time(void) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_boot).count();
+}
+
+// ================= LOG =================
+static std::mutex g_log_mutex;
+static esp_log_level_t g_log_level = ESP_LOG_INFO;
+
+void esp_log_level_set(const char *, esp_log_level_t level) { g_log_level = level; }
+
+void esp_log_write(esp_log_level_t level, const char *tag, const char *format, ...) {
+    if (level > g_log_level || level == ESP_LOG_NONE) return;
+    static const char letters[] = "NEWIDV";
+    char msg[512];
+    va_list ap;
+    va_start(ap, format);
+    vsnprintf(msg, sizeof(msg), format, ap);
+    va_end(ap);
+    std::lock_guard<std::mutex> lock(g_log_mutex);
+    fprintf(stderr, "%c (%lld) %s: %s\n", letters[level], (long long)(esp_timer_get_time() / 1000), tag, msg);
+}
+
+// ================= HEAP =================
+// Regiões do ESP32-CAM (WROVER): interna livre depois do boot e PSRAM
+static const size_t kInternalBytes = 320 * 1024;
+static const size_t kSpiramBytes = 4 * 1024 * 1024;
+
+// Além dos totais, cada região tem um espaço de endereços simulado com
+// alocação first-fit (blocos de 4 bytes), para que o maior bloco livre e a
+// fragmentação acompanhem a ordem real de alocações e liberações
+struct HeapRegion {
+    size_t total, used = 0, peak = 0;
+    std::map<size_t, size_t> blocks; // Deslocamento -> tamanho dos blocos em uso
+
+    static size_t rounded(size_t size) { return ((size ? size : 1) + 3) & ~(size_t)3; }
+
+    bool place(size_t size, size_t *offset) {
+        size_t at = 0;
+        for (const auto &b : blocks) {
+            if (b.first - at >= size) break;
+            at = b.first + b.second;
+        }
+        if (total - at < size) return false;
+        blocks[at] = size;
+        *offset = at;
+        return true;
+    }
+
+    size_t largest_free() const {
+        size_t at = 0, largest = 0;
+        for (const auto &b : blocks) {
+            largest = std::max(largest, b.first - at);
+            at = b.first + b.second;
+        }
+        return std::max(largest, total - at);
+    }
+};
+
+struct HeapAlloc {
+    size_t size, offset;
+    HeapRegion *region;
+};
+
+// Estado nunca destruído: free() continua passando por aqui depois dos
+// destrutores estáticos
+struct HeapState {
+    std::mutex mutex;
+    HeapRegion internal{kInternalBytes}, spiram{kSpiramBytes};
+    std::unordered_map<void *, HeapAlloc> allocs;
+
+    HeapRegion *region_for(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? &spiram : &internal; }
+};
+
+static HeapState &heap() {
+    static HeapState *state = new HeapState();
+    return *state;
+}
+
+// Alocações da própria contabilidade (nós do mapa) não contam
+static thread_local bool t_heap_bookkeeping = false;
+
+void *heap_caps_malloc(size_t size, uint32_t caps) {
+    HeapState &h = heap();
+    std::lock_guard<std::mutex> lock(h.mutex);
+    HeapRegion *r = h.region_for(caps);
+    // Região esgotada ou sem bloco contíguo do tamanho, como no dispositivo
+    size_t offset;
+    t_heap_bookkeeping = true;
+    const bool placed = r->place(HeapRegion::rounded(size), &offset);
+    t_heap_bookkeeping = false;
+    if (!placed) return nullptr;
+    void *p = malloc(size ? size : 1);
+    if (!p) {
+        r->blocks.erase(offset);
+        return nullptr;
+    }
+    r->used += size;
+    if (r->used > r->peak) r->peak = r->used;
+    t_heap_bookkeeping = true;
+    h.allocs[p] = {size, offset, r};
+    t_heap_bookkeeping = false;
+    return p;
+}
+
+void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    void *p = heap_caps_malloc(n * size, caps);
+    if (p) memset(p, 0, n * size);
+    return p;
+}
+
+// Devolve o bloco à contabilidade (no-op se não veio de heap_caps_malloc)
+static void heap_release(void *p) {
+    HeapState &h = heap();
+    std::lock_guard<std::mutex> lock(h.mutex);
+    auto it = h.allocs.find(p);
+    if (it == h.allocs.end()) return;
+    HeapRegion *r = it->second.region;
+    r->used -= it->second.size;
+    r->blocks.erase(it->second.offset);
+    h.allocs.erase(it);
+}
+
+void heap_caps_free(void *ptr) {
+    if (!ptr) return;
+    heap_release(ptr);
+    free(ptr);
+}
+
+// No dispositivo free() também libera memória de heap_caps_malloc: o alvo
+// da simulação liga com -Wl,--wrap=free para a contabilidade acompanhar.
+// malloc/calloc/realloc e o operator new só contam alocações (o custo que o
+// heap do dispositivo cobra por frame); as internas das bibliotecas
+// dinâmicas (libjpeg) ficam de fora.
+static std::atomic<uint64_t> g_alloc_count{0};
+
+extern "C" void __real_free(void *ptr);
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t n, size_t size);
+extern "C" void *__real_realloc(void *ptr, size_t size);
+
+extern "C" void __wrap_free(void *ptr) {
+    if (ptr) heap_release(ptr);
+    __real_free(ptr);
+}
+
+extern "C" void *__wrap_malloc(size_t size) {
+    if (!t_heap_bookkeeping) g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t n, size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    return __real_calloc(n, size);
+}
+
+extern "C" void *__wrap_realloc(void *ptr, size_t size) {
+    g_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (ptr) heap_release(ptr);
+    return __real_realloc(ptr, size);
+}
+
+void *operator new(size_t size) {
+    void *p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+// Memória de new nunca vem de heap_caps_malloc; sem passar pela
+// contabilidade, o erase do mapa (sob o mutex) não volta a ela
+void operator delete(void *ptr) noexcept { __real_free(ptr); }
+void operator delete[](void *ptr) noexcept { __real_free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { __real_free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { __real_free(ptr); }
+
+uint64_t sim_heap_allocations() { return g_alloc_count.load(std::memory_order_relaxed); }
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+    HeapState &h = heap();
+    std::lock_guard<std::mutex> lock(h.mutex);
+    HeapRegion *r = h.region_for(caps);
+    return r->total - r->used;
+}
+
+size_t heap_caps_get_total_size(uint32_t caps) { return heap().region_for(caps)->total; }
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    HeapState &h = heap();
+    std::lock_guard<std::mutex> lock(h.mutex);
+    HeapRegion *r = h.region_for(caps);
+    return r->total - r->peak;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    HeapState &h = heap();
+    std::lock_guard<std::mutex> lock(h.mutex);
+    return h.region_for(caps)->largest_free();
+}
+
+// ================= NVS =================
+static std::mutex g_nvs_mutex;
+static std::map<std::string, std::vector<uint8_t>> g_nvs; // "namespace/chave" -> valor
+static std::vector<std::string> g_nvs_namespaces;         // handle - 1 -> namespace
+static std::string g_nvs_file;
+
+// Arquivo: [u16 tamanho do nome][nome][u32 tamanho][valor]...
+static void nvs_load_file() {
+    std::ifstream f(g_nvs_file, std::ios::binary);
+    uint16_t name_len;
+    while (f.read((char *)&name_len, 2)) {
+        std::string name(name_len, '\0');
+        uint32_t len;
+        if (!f.read(&name[0], name_len) || !f.read((char *)&len, 4)) break;
+        std::vector<uint8_t> value(len);
+        if (!f.read((char *)value.data(), len)) break;
+        g_nvs[name] = std::move(value);
+    }
+}
+
+static void nvs_save_file() {
+    if (g_nvs_file.empty()) return;
+    std::ofstream f(g_nvs_file, std::ios::binary | std::ios::trunc);
+    for (const auto &kv : g_nvs) {
+        uint16_t name_len = (uint16_t)kv.first.size();
+        uint32_t len = (uint32_t)kv.second.size();
+        f.write((const char *)&name_len, 2);
+        f.write(kv.first.data(), name_len);
+        f.write((const char *)&len, 4);
+        f.write((const char *)kv.second.data(), len);
+    }
+}
+
+void sim_nvs_set_file(const std::string &path) {
+    std::lock_guard<std::mutex> lock(g_nvs_mutex);
+    g_nvs_file = path;
+    g_nvs.clear();
+    if (!path.empty()) nvs_load_file();
+}
+
+esp_err_t nvs_flash_init(void) { return ESP_OK; }
+
+esp_err_t nvs_open(const char *name, nvs_open_mode_t, nvs_handle_t *out_handle) {
+    std::lock_guard<std::mutex> lock(g_nvs_mutex);
+    g_nvs_namespaces.push_back(name);
+    *out_handle = (nvs_handle_t)g_nvs_namespaces.size();
+    return ESP_OK;
+}
+
+void nvs_close(nvs_handle_t) {}
+
+static std::string nvs_key(nvs_handle_t h, const char *key) {
+    if (h == 0 || h > g_nvs_namespaces.size()) return std::string();
+    return g_nvs_namespaces[h - 1] + "/" + key;
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char *key, void *out_value, size_t *length) {
+    std::lock_guard<std::mutex> lock(g_nvs_mutex);
+    auto it = g_nvs.find(nvs_key(handle, key));
+    if (it == g_nvs.end()) return ESP_ERR_NVS_NOT_FOUND;
+    if (!out_value) {
+        *length = it->second.size();
+        return ESP_OK;
+    }
+    if (*length < it->second.size()) return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out_value, it->second.data(), it->second.size());
+    *length = it->second.size();
+    return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char *key, const void *value, size_t length) {
+    std::lock_guard<std::mutex> lock(g_nvs_mutex);
+    g_nvs[nvs_key(handle, key)].assign((const uint8_t *)value, (const uint8_t *)value + length);
+    return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char *key) {
+    std::lock_guard<std::mutex> lock(g_nvs_mutex);
+    return g_nvs.erase(nvs_key(handle, key)) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+esp_err_t nvs_commit(nvs_handle_t) {
+    std::lock_guard<std::mutex> lock(g_nvs_mutex);
+    nvs_save_file();
+    return ESP_OK;
+}
+
+// ================= FREERTOS =================
+struct sim_task {
+    std::string name;
+    UBaseType_t priority;
+    BaseType_t core; // 0/1 ou tskNO_AFFINITY
+    uint32_t stack_depth;
+    UBaseType_t number = 0;
+    clockid_t cpu_clock{}; // Relógio de CPU da thread, válido enquanto ela está na lista
+    std::thread thread;
+};
+
+static std::mutex g_task_mutex;
+static std::vector<sim_task *> g_tasks;
+static UBaseType_t g_task_numbers = 0;
+static thread_local sim_task *t_current = nullptr; // nullptr = thread do host (main do processo)
+
+static sim_task *register_task(const char *name, UBaseType_t priority, BaseType_t core, uint32_t stack_depth) {
+    sim_task *t = new sim_task{name ? name : "", priority, core, stack_depth};
+    std::lock_guard<std::mutex> lock(g_task_mutex);
+    t->number = ++g_task_numbers;
+    return t;
+}
+
+// Chamado pela própria thread: só então o relógio de CPU dela existe
+static void enter_task(sim_task *t) {
+    t_current = t;
+    pthread_getcpuclockid(pthread_self(), &t->cpu_clock);
+    std::lock_guard<std::mutex> lock(g_task_mutex);
+    g_tasks.push_back(t);
+}
+
+static void exit_task() {
+    std::lock_guard<std::mutex> lock(g_task_mutex);
+    g_tasks.erase(std::find(g_tasks.begin(), g_tasks.end(), t_current));
+}
+
+void sim_task_adopt_current(const char *name, unsigned priority, int core, uint32_t stack_depth) {
+    enter_task(register_task(name, priority, core, stack_depth));
+}
+
+void sim_task_leave_current() {
+    if (!t_current) return;
+    exit_task();
+    delete t_current;
+    t_current = nullptr;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *out, BaseType_t core_id) {
+    sim_task *t = register_task(name, priority, core_id, stack_depth);
+    t->thread = std::thread([t, fn, arg] {
+        enter_task(t);
+        fn(arg);
+        exit_task(); // O handle continua válido para quem o guardou
+    });
+    t->thread.detach();
+    if (out) *out = t;
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth, void *arg, UBaseType_t priority,
+                       TaskHandle_t *out) {
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, arg, priority, out, tskNO_AFFINITY);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // Threads não podem ser mortas de fora: a tarefa encerra ao voltar
+    (void)task;
+}
+
+void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks * portTICK_PERIOD_MS)); }
+
+TickType_t xTaskGetTickCount(void) { return (TickType_t)(esp_timer_get_time() / 1000 / portTICK_PERIOD_MS); }
+
+char *pcTaskGetName(TaskHandle_t task) {
+    if (!task) task = t_current;
+    return const_cast<char *>(task ? task->name.c_str() : "host");
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) { return t_current; }
+
+BaseType_t xTaskGetCoreID(TaskHandle_t task) {
+    if (!task) task = t_current;
+    return task ? task->core : tskNO_AFFINITY;
+}
+
+// Tarefas ociosas de cada núcleo simulado (nunca executam)
+static sim_task g_idle[portNUM_PROCESSORS] = {{"IDLE0", 0, 0, 1536}, {"IDLE1", 0, 1, 1536}};
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, configRUN_TIME_COUNTER_TYPE *total_runtime) {
+    const int64_t now_us = esp_timer_get_time();
+    std::lock_guard<std::mutex> lock(g_task_mutex);
+    if (g_tasks.size() + portNUM_PROCESSORS > size) return 0;
+    // Tempo ocupado de cada núcleo: as fixadas no seu, as demais divididas
+    double busy_us[portNUM_PROCESSORS] = {};
+    UBaseType_t n = 0;
+    for (sim_task *t : g_tasks) {
+        timespec ts = {};
+        clock_gettime(t->cpu_clock, &ts);
+        const double us = ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+        if (t->core >= 0 && t->core < portNUM_PROCESSORS) {
+            busy_us[t->core] += us;
+        } else {
+            for (double &b : busy_us) b += us / portNUM_PROCESSORS;
+        }
+        status[n++] = {t, t->name.c_str(), t->number, t == t_current ? eRunning : eBlocked, t->priority,
+                       t->priority, (configRUN_TIME_COUNTER_TYPE)us, nullptr, t->stack_depth};
+    }
+    for (int c = 0; c < portNUM_PROCESSORS; c++) {
+        sim_task *idle = &g_idle[c];
+        const double idle_us = std::max(0.0, (double)now_us - busy_us[c]);
+        status[n++] = {idle, idle->name.c_str(), 1000u + c, eReady, 0, 0, (configRUN_TIME_COUNTER_TYPE)idle_us,
+                       nullptr, idle->stack_depth};
+    }
+    if (total_runtime) *total_runtime = (configRUN_TIME_COUNTER_TYPE)now_us;
+    return n;
+}
+
+// Tarefa fixada mantém o núcleo; as demais ficam no núcleo em que a CPU do
+// host as roda no momento
+BaseType_t xPortGetCoreID(void) {
+    if (t_current && t_current->core >= 0 && t_current->core < portNUM_PROCESSORS) return t_current->core;
+    int cpu = sched_getcpu();
+    return cpu < 0 ? 0 : cpu % portNUM_PROCESSORS;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+    std::lock_guard<std::mutex> lock(g_task_mutex);
+    return (UBaseType_t)g_tasks.size() + 1; // + a tarefa principal
+}
+
+struct sim_queue {
+    size_t length, item_size;
+    std::deque<std::vector<uint8_t>> items;
+    std::mutex mutex;
+    std::condition_variable not_empty, not_full;
+};
+
+// Espera com o timeout em ticks do FreeRTOS (portMAX_DELAY = para sempre)
+template <typename Pred>
+static bool wait_ticks(std::condition_variable &cv, std::unique_lock<std::mutex> &lock, TickType_t ticks, Pred pred) {
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, pred);
+        return true;
+    }
+    return cv.wait_for(lock, std::chrono::milliseconds((uint64_t)ticks * portTICK_PERIOD_MS), pred);
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    sim_queue *q = new sim_queue();
+    q->length = length;
+    q->item_size = item_size;
+    return q;
+}
+
+void vQueueDelete(QueueHandle_t q) { delete q; }
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!wait_ticks(q->not_full, lock, wait, [q] { return q->items.size() < q->length; })) return errQUEUE_FULL;
+    const uint8_t *p = (const uint8_t *)item;
+    q->items.emplace_back(p, p + q->item_size);
+    q->not_empty.notify_one();
+    return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait) {
+    std::unique_lock<std::mutex> lock(q->mutex);
+    if (!wait_ticks(q->not_empty, lock, wait, [q] { return !q->items.empty(); })) return pdFALSE;
+    if (q->item_size) memcpy(item, q->items.front().data(), q->item_size);
+    q->items.pop_front();
+    q->not_full.notify_one();
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q) {
+    std::lock_guard<std::mutex> lock(q->mutex);
+    return (UBaseType_t)q->items.size();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    SemaphoreHandle_t s = xQueueCreate(1, 0);
+    xQueueSend(s, nullptr, 0); // Mutex nasce livre
+    return s;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait) { return xQueueReceive(s, nullptr, wait); }
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s) { return xQueueSend(s, nullptr, 0); }
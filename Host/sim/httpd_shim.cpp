@@ -0,0 +1,292 @@
+// esp_http_server sobre sockets do Linux: uma thread atende todas as
+// conexões (select), um handler por vez, como a tarefa do httpd no ESP32
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "esp_http_server.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "net_util.h"
+#include "sim.h"
+
+static const char *TAG = "httpd";
+
+namespace {
+
+// Requisição em andamento: corpo recebido e resposta montada pelo handler
+struct ReqState {
+    const std::vector<uint8_t> *body;
+    size_t body_pos = 0;
+    std::string query;
+    std::string status = "200 OK";
+    std::string type = "text/html";
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string out;
+    bool sent = false;
+};
+
+struct Server {
+    httpd_config_t config;
+    std::vector<httpd_uri_t> handlers;
+    std::mutex handler_mutex; // Um handler por vez (socket ou sim_httpd_call)
+    std::atomic<bool> running{false};
+    std::thread thread;
+    int listen_fd = -1;
+};
+
+Server *g_server = nullptr;
+int g_port_override = 0;
+
+int method_from_name(const std::string &m) {
+    if (m == "GET") return HTTP_GET;
+    if (m == "POST") return HTTP_POST;
+    if (m == "PUT") return HTTP_PUT;
+    if (m == "DELETE") return HTTP_DELETE;
+    if (m == "HEAD") return HTTP_HEAD;
+    return -1;
+}
+
+int status_code(const std::string &status) { return atoi(status.c_str()); }
+
+// Executa o handler da rota; devolve o status e preenche a resposta
+int dispatch(int method, const std::string &target, const std::vector<uint8_t> &body, ReqState *st) {
+    std::string path = target;
+    size_t q = path.find('?');
+    if (q != std::string::npos) {
+        st->query = path.substr(q + 1);
+        path.resize(q);
+    }
+
+    std::lock_guard<std::mutex> lock(g_server->handler_mutex);
+    for (const httpd_uri_t &h : g_server->handlers) {
+        if (path != h.uri || method != (int)h.method) continue;
+        httpd_req_t req = {};
+        req.handle = g_server;
+        req.method = method;
+        snprintf(req.uri, sizeof(req.uri), "%s", target.c_str());
+        req.content_len = body.size();
+        req.aux = st;
+        req.user_ctx = h.user_ctx;
+        st->body = &body;
+        esp_err_t err = h.handler(&req);
+        // Handler que falhou sem responder: o httpd fecha a conexão com 500
+        if (err != ESP_OK && !st->sent) {
+            st->status = "500 Internal Server Error";
+            st->out.clear();
+        }
+        return status_code(st->status);
+    }
+    st->status = "404 Not Found";
+    st->out = "Nothing matches the given URI";
+    return 404;
+}
+
+void serve_client(int fd, std::string &pending, bool *keep) {
+    HttpMessage msg;
+    *keep = false;
+    if (!http_read(fd, pending, &msg, 1 << 20)) return;
+    size_t sp1 = msg.start_line.find(' '), sp2 = msg.start_line.find(' ', sp1 + 1);
+    if (sp1 == std::string::npos || sp2 == std::string::npos) return;
+
+    ReqState st;
+    dispatch(method_from_name(msg.start_line.substr(0, sp1)), msg.start_line.substr(sp1 + 1, sp2 - sp1 - 1), msg.body,
+             &st);
+    std::string head = "HTTP/1.1 " + st.status + "\r\nContent-Type: " + st.type + "\r\n";
+    for (const auto &h : st.headers) head += h.first + ": " + h.second + "\r\n";
+    head += "Content-Length: " + std::to_string(st.out.size()) + "\r\n\r\n";
+    // Cabeçalho e corpo em uma escrita só (sem esperar o ACK atrasado)
+    head += st.out;
+    *keep = net_write_all(fd, head.data(), head.size());
+}
+
+void server_loop(Server *s) {
+    sim_task_adopt_current("httpd", s->config.task_priority, tskNO_AFFINITY, (uint32_t)s->config.stack_size);
+    std::map<int, std::string> clients; // fd -> bytes pendentes
+    while (s->running) {
+        fd_set rd;
+        FD_ZERO(&rd);
+        FD_SET(s->listen_fd, &rd);
+        int max_fd = s->listen_fd;
+        for (const auto &c : clients) {
+            FD_SET(c.first, &rd);
+            if (c.first > max_fd) max_fd = c.first;
+        }
+        timeval tv = {0, 200 * 1000};
+        if (select(max_fd + 1, &rd, nullptr, nullptr, &tv) <= 0) continue;
+
+        if (FD_ISSET(s->listen_fd, &rd)) {
+            int fd = accept(s->listen_fd, nullptr, nullptr);
+            if (fd >= 0 && clients.size() < s->config.max_open_sockets) clients[fd];
+            else if (fd >= 0) close(fd); // Como o httpd com max_open_sockets esgotado
+        }
+        for (auto it = clients.begin(); it != clients.end();) {
+            bool keep = true;
+            if (FD_ISSET(it->first, &rd)) serve_client(it->first, it->second, &keep);
+            if (keep) {
+                ++it;
+            } else {
+                close(it->first);
+                it = clients.erase(it);
+            }
+        }
+    }
+    for (const auto &c : clients) close(c.first);
+    sim_task_leave_current();
+}
+
+ReqState *state(httpd_req_t *r) { return (ReqState *)r->aux; }
+
+} // namespace
+
+void sim_httpd_set_port(int port) { g_port_override = port; }
+
+int sim_httpd_port() { return g_server ? g_server->config.server_port : 0; }
+
+int sim_httpd_call(const char *method, const char *uri, const uint8_t *body, size_t len, std::string *resp_body) {
+    if (!g_server) return 0;
+    std::vector<uint8_t> data(body, body + len);
+    ReqState st;
+    int status = dispatch(method_from_name(method), uri, data, &st);
+    if (resp_body) *resp_body = std::move(st.out);
+    return status;
+}
+
+httpd_config_t httpd_default_config(void) {
+    httpd_config_t c = {};
+    c.task_priority = 5;
+    c.stack_size = 4096;
+    c.server_port = 80;
+    c.max_open_sockets = 7;
+    c.max_uri_handlers = 8;
+    c.max_resp_headers = 8;
+    c.recv_wait_timeout = 5;
+    c.send_wait_timeout = 5;
+    return c;
+}
+
+esp_err_t httpd_start(httpd_handle_t *handle, const httpd_config_t *config) {
+    if (g_server) return ESP_FAIL;
+    Server *s = new Server();
+    s->config = *config;
+    if (g_port_override) s->config.server_port = (uint16_t)g_port_override;
+    s->listen_fd = net_listen_tcp("0.0.0.0", s->config.server_port);
+    if (s->listen_fd < 0) {
+        ESP_LOGE(TAG, "Porta %u indisponivel", s->config.server_port);
+        delete s;
+        return ESP_FAIL;
+    }
+    g_server = s;
+    s->running = true;
+    s->thread = std::thread(server_loop, s);
+    ESP_LOGI(TAG, "Escutando na porta %u", s->config.server_port);
+    *handle = s;
+    return ESP_OK;
+}
+
+esp_err_t httpd_stop(httpd_handle_t handle) {
+    Server *s = (Server *)handle;
+    if (!s || s != g_server) return ESP_FAIL;
+    s->running = false;
+    s->thread.join();
+    close(s->listen_fd);
+    g_server = nullptr;
+    delete s;
+    return ESP_OK;
+}
+
+esp_err_t httpd_register_uri_handler(httpd_handle_t handle, const httpd_uri_t *uri_handler) {
+    Server *s = (Server *)handle;
+    if (!s || s->handlers.size() >= s->config.max_uri_handlers) return ESP_FAIL;
+    std::lock_guard<std::mutex> lock(s->handler_mutex);
+    s->handlers.push_back(*uri_handler);
+    return ESP_OK;
+}
+
+int httpd_req_recv(httpd_req_t *r, char *buf, size_t buf_len) {
+    ReqState *st = state(r);
+    size_t n = std::min(buf_len, st->body->size() - st->body_pos);
+    memcpy(buf, st->body->data() + st->body_pos, n);
+    st->body_pos += n;
+    return (int)n;
+}
+
+esp_err_t httpd_req_get_url_query_str(httpd_req_t *r, char *buf, size_t buf_len) {
+    ReqState *st = state(r);
+    if (st->query.empty()) return ESP_ERR_NOT_FOUND;
+    if (st->query.size() >= buf_len) return ESP_ERR_INVALID_SIZE;
+    memcpy(buf, st->query.c_str(), st->query.size() + 1);
+    return ESP_OK;
+}
+
+esp_err_t httpd_query_key_value(const char *qry, const char *key, char *val, size_t val_size) {
+    const size_t klen = strlen(key);
+    for (const char *p = qry; p && *p;) {
+        const char *end = strchr(p, '&');
+        size_t len = end ? (size_t)(end - p) : strlen(p);
+        if (len > klen && strncmp(p, key, klen) == 0 && p[klen] == '=') {
+            size_t vlen = len - klen - 1;
+            if (vlen >= val_size) return ESP_ERR_INVALID_SIZE;
+            memcpy(val, p + klen + 1, vlen);
+            val[vlen] = '\0';
+            return ESP_OK;
+        }
+        p = end ? end + 1 : nullptr;
+    }
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t httpd_resp_set_status(httpd_req_t *r, const char *status) {
+    state(r)->status = status;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_set_type(httpd_req_t *r, const char *type) {
+    state(r)->type = type;
+    return ESP_OK;
+}
+
+// Como no dispositivo: passar de max_resp_headers falha em vez de crescer
+esp_err_t httpd_resp_set_hdr(httpd_req_t *r, const char *field, const char *value) {
+    ReqState *st = state(r);
+    if (g_server && st->headers.size() >= g_server->config.max_resp_headers) return ESP_ERR_HTTPD_RESP_HDR;
+    st->headers.emplace_back(field, value);
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send(httpd_req_t *r, const char *buf, ssize_t buf_len) {
+    ReqState *st = state(r);
+    if (buf_len == HTTPD_RESP_USE_STRLEN) buf_len = buf ? (ssize_t)strlen(buf) : 0;
+    st->out.assign(buf ? buf : "", (size_t)buf_len);
+    st->sent = true;
+    return ESP_OK;
+}
+
+// Os pedaços são juntados e saem com Content-Length (o cliente não vê diferença)
+esp_err_t httpd_resp_send_chunk(httpd_req_t *r, const char *buf, ssize_t buf_len) {
+    ReqState *st = state(r);
+    if (buf_len == HTTPD_RESP_USE_STRLEN) buf_len = buf ? (ssize_t)strlen(buf) : 0;
+    if (buf && buf_len > 0) st->out.append(buf, (size_t)buf_len);
+    st->sent = true;
+    return ESP_OK;
+}
+
+esp_err_t httpd_resp_send_err(httpd_req_t *r, httpd_err_code_t error, const char *msg) {
+    static const char *const names[] = {"400 Bad Request", "404 Not Found", "405 Method Not Allowed",
+                                        "408 Request Timeout", "500 Internal Server Error"};
+    ReqState *st = state(r);
+    st->status = names[error];
+    st->type = "text/html";
+    return httpd_resp_send(r, msg ? msg : "", HTTPD_RESP_USE_STRLEN);
+}
+
+esp_err_t httpd_resp_send_500(httpd_req_t *r) { return httpd_resp_send_err(r, HTTPD_500_INTERNAL_SERVER_ERROR, "Internal Server Error"); }
+
+esp_err_t httpd_resp_send_404(httpd_req_t *r) { return httpd_resp_send_err(r, HTTPD_404_NOT_FOUND, "Not Found"); }
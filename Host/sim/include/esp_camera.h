@@ -0,0 +1,79 @@
+#pragma once
+// Shim do esp32-camera: frames JPEG servidos pela câmera virtual da
+// simulação (sim/sim.h) no lugar do sensor
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    PIXFORMAT_RGB565,
+    PIXFORMAT_YUV422,
+    PIXFORMAT_YUV420,
+    PIXFORMAT_GRAYSCALE,
+    PIXFORMAT_JPEG,
+    PIXFORMAT_RGB888,
+} pixformat_t;
+
+typedef enum {
+    FRAMESIZE_96X96,
+    FRAMESIZE_QQVGA,  // 160x120
+    FRAMESIZE_QCIF,   // 176x144
+    FRAMESIZE_HQVGA,  // 240x176
+    FRAMESIZE_240X240,
+    FRAMESIZE_QVGA,   // 320x240
+    FRAMESIZE_CIF,    // 400x296
+    FRAMESIZE_HVGA,   // 480x320
+    FRAMESIZE_VGA,    // 640x480
+} framesize_t;
+
+typedef enum { LEDC_CHANNEL_0 } ledc_channel_t;
+typedef enum { LEDC_TIMER_0 } ledc_timer_t;
+
+typedef struct {
+    int pin_pwdn, pin_reset, pin_xclk, pin_sccb_sda, pin_sccb_scl;
+    int pin_d7, pin_d6, pin_d5, pin_d4, pin_d3, pin_d2, pin_d1, pin_d0;
+    int pin_vsync, pin_href, pin_pclk;
+    int xclk_freq_hz;
+    ledc_timer_t ledc_timer;
+    ledc_channel_t ledc_channel;
+    pixformat_t pixel_format;
+    framesize_t frame_size;
+    int jpeg_quality;
+    size_t fb_count;
+} camera_config_t;
+
+// Ajustes do sensor: registrados e ignorados (a câmera virtual não tem óptica)
+typedef struct _sensor sensor_t;
+struct _sensor {
+    int (*set_gain_ctrl)(sensor_t *sensor, int enable);
+    int (*set_exposure_ctrl)(sensor_t *sensor, int enable);
+    int (*set_awb_gain)(sensor_t *sensor, int enable);
+    int (*set_aec_value)(sensor_t *sensor, int value);
+    int (*set_agc_gain)(sensor_t *sensor, int gain);
+};
+
+typedef struct {
+    uint8_t *buf;
+    size_t len;
+    size_t width;
+    size_t height;
+    pixformat_t format;
+    struct timeval timestamp;
+} camera_fb_t;
+
+// Resolução do frame_size; sem frames carregados a câmera fica vazia e
+// esp_camera_fb_get devolve NULL
+esp_err_t esp_camera_init(const camera_config_t *config);
+sensor_t *esp_camera_sensor_get(void);
+
+camera_fb_t *esp_camera_fb_get(void);
+void esp_camera_fb_return(camera_fb_t *fb);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,13 @@
+#pragma once
+// Shim do ESP-IDF: microssegundos desde o início do processo (relógio monotônico)
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int64_t esp_timer_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+// Shim do FreeRTOS sobre threads do Linux: tick de 1 ms (CONFIG_FREERTOS_HZ
+// = 1000), tarefas = std::thread, filas com mutex + condvar
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h> // O FreeRTOSConfig do ESP-IDF também traz stdlib.h
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint8_t StackType_t; // Como no ESP-IDF: profundidade de pilha em bytes
+
+#define configTICK_RATE_HZ 1000
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define portMAX_DELAY ((TickType_t)0xffffffffu)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+#define errQUEUE_FULL pdFAIL
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define portNUM_PROCESSORS 2
+#define configRUN_TIME_COUNTER_TYPE uint32_t // Microssegundos (esp_timer)
+
+// Núcleo em que a tarefa atual roda (ver esp_shims.cpp)
+BaseType_t xPortGetCoreID(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Mutex = fila de um item, como no FreeRTOS
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t s);
+#define vSemaphoreDelete vQueueDelete
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,18 @@
+#pragma once
+// Shim do esp32-camera: decode JPEG -> RGB888 com libjpeg. Como no
+// dispositivo, rgb_buf deve comportar o frame inteiro da câmera; frames com
+// outra resolução são recusados em vez de estourar o buffer.
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_camera.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool fmt2rgb888(const uint8_t *src_buf, size_t src_len, pixformat_t format, uint8_t *rgb_buf);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,75 @@
+// Shims de rede do ESP-IDF: eventos, netif e Wi-Fi. A estação "conecta" na
+// hora ao loopback, e os eventos chegam aos handlers na mesma ordem do
+// dispositivo (STA_START -> esp_wifi_connect -> STA_GOT_IP)
+#include <arpa/inet.h>
+#include <mutex>
+#include <vector>
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_wifi.h"
+
+static const char *TAG = "sim_wifi";
+
+esp_event_base_t const WIFI_EVENT = "WIFI_EVENT";
+esp_event_base_t const IP_EVENT = "IP_EVENT";
+
+struct Handler {
+    esp_event_base_t base;
+    int32_t id;
+    esp_event_handler_t fn;
+    void *arg;
+};
+
+static std::recursive_mutex g_event_mutex;
+static std::vector<Handler> g_handlers;
+
+esp_err_t esp_event_loop_create_default(void) { return ESP_OK; }
+
+esp_err_t esp_event_handler_instance_register(esp_event_base_t base, int32_t id, esp_event_handler_t handler,
+                                              void *arg, esp_event_handler_instance_t *instance) {
+    std::lock_guard<std::recursive_mutex> lock(g_event_mutex);
+    g_handlers.push_back({base, id, handler, arg});
+    if (instance) *instance = (void *)(g_handlers.size());
+    return ESP_OK;
+}
+
+esp_err_t esp_event_post(esp_event_base_t base, int32_t id, const void *data, size_t, uint32_t) {
+    // Cópia: um handler pode registrar outros durante a entrega
+    std::vector<Handler> handlers;
+    {
+        std::lock_guard<std::recursive_mutex> lock(g_event_mutex);
+        handlers = g_handlers;
+    }
+    for (const Handler &h : handlers) {
+        if (h.base == base && (h.id == ESP_EVENT_ANY_ID || h.id == id)) h.fn(h.arg, base, id, (void *)data);
+    }
+    return ESP_OK;
+}
+
+esp_err_t esp_netif_init(void) { return ESP_OK; }
+
+esp_netif_t *esp_netif_create_default_wifi_sta(void) { return nullptr; }
+
+static bool g_wifi_started = false;
+
+esp_err_t esp_wifi_init(const wifi_init_config_t *) { return ESP_OK; }
+esp_err_t esp_wifi_set_mode(wifi_mode_t) { return ESP_OK; }
+
+esp_err_t esp_wifi_set_config(wifi_interface_t, wifi_config_t *conf) {
+    ESP_LOGI(TAG, "SSID \"%.32s\" (simulado: loopback)", (const char *)conf->sta.ssid);
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_start(void) {
+    g_wifi_started = true;
+    return esp_event_post(WIFI_EVENT, WIFI_EVENT_STA_START, nullptr, 0, 0);
+}
+
+esp_err_t esp_wifi_connect(void) {
+    if (!g_wifi_started) return ESP_FAIL;
+    ip_event_got_ip_t got = {};
+    got.ip_info.ip.addr = htonl(INADDR_LOOPBACK);
+    got.ip_changed = true;
+    return esp_event_post(IP_EVENT, IP_EVENT_STA_GOT_IP, &got, sizeof(got), 0);
+}
@@ -0,0 +1,81 @@
+#pragma once
+// Controle da simulação do firmware no host: o que no dispositivo vem do
+// hardware (câmera, flash, clientes HTTP) é alimentado por aqui.
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Kernels por trás da API do TFLite Micro nesta build (ver FIRE_SIM_TFLM_DIR
+// no CMakeLists): resultados do firmware_sim valem para esses kernels
+#ifdef FIRE_SIM_REAL_TFLM
+#define SIM_TFLM_BACKEND "TFLite Micro (FIRE_SIM_TFLM_DIR)"
+#else
+#define SIM_TFLM_BACKEND "kernels de referencia do host (sim/tflm), nao o TFLite Micro"
+#endif
+
+// Câmera virtual: frames JPEG já na resolução do sensor, servidos em
+// rodízio por esp_camera_fb_get. A sequência de frames é a cena: com fps, a
+// captura k mostra o frame k % n, quer o firmware a consuma ou não.
+void sim_camera_set_frames(std::vector<std::vector<uint8_t>> jpgs, int width, int height);
+int sim_camera_width();
+int sim_camera_height();
+size_t sim_camera_frame_count();
+// Cópia do frame i (para medir o classificador fora do handler)
+bool sim_camera_frame(size_t i, std::vector<uint8_t> &jpg);
+
+// Carrega imagens do dataset (ou qualquer JPEG) como frames da câmera:
+// redimensiona para width x height e recodifica, como o sensor entregaria
+// (quality na escala do camera_config_t.jpeg_quality: 0-63, menor = melhor)
+bool sim_camera_load_images(const std::vector<std::string> &paths, int width, int height, int quality,
+                            std::string *error);
+
+// Vídeo MJPEG gravado (JPEGs concatenados, como o ffmpeg -f mjpeg ou um
+// dump do /stream): frames na resolução do sensor entram sem recodificar
+bool sim_camera_load_mjpeg(const std::string &path, int width, int height, int quality, std::string *error);
+
+// Ritmo do sensor. Sem fps, cada esp_camera_fb_get recebe o próximo frame na
+// hora. Com fps, as capturas acontecem no relógio do sensor (k / fps, mais um
+// desvio uniforme de ±jitter_ms) e fb_get espera a próxima captura ou
+// entrega a mais recente não lida, descartando as velhas como o driver com
+// fb_count > 1; o timestamp do fb é o instante da captura. drop_rate é a
+// fração de capturas que o sensor perde. Tudo derivado de seed: duas
+// execuções com a mesma configuração veem a mesma sequência.
+struct SimCameraTiming {
+    float fps = 0.0f;
+    float jitter_ms = 0.0f;
+    float drop_rate = 0.0f;
+    uint32_t seed = 1;
+};
+void sim_camera_set_timing(const SimCameraTiming &timing);
+
+struct SimCameraStats {
+    uint64_t served;      // Frames entregues ao firmware
+    uint64_t dropped;     // Capturas perdidas pelo sensor (injetadas)
+    uint64_t overwritten; // Capturas que o firmware não leu a tempo
+    uint64_t age_us_sum;  // Soma de (entrega - captura) dos frames servidos
+    uint64_t age_us_max;
+};
+void sim_camera_get_stats(SimCameraStats *out);
+
+// Requisição direta a um handler registrado, sem socket (para medir o
+// handler isolado). Retorna o status HTTP; resp_body recebe o corpo.
+int sim_httpd_call(const char *method, const char *uri, const uint8_t *body, size_t len,
+                   std::string *resp_body);
+
+// Threads dos shims que no dispositivo são tarefas (ex.: a do httpd): passam
+// a ter nome e núcleo (pcTaskGetName, xPortGetCoreID) e entram na contagem
+// de tarefas e nas estatísticas de execução até saírem
+void sim_task_adopt_current(const char *name, unsigned priority, int core, uint32_t stack_depth);
+void sim_task_leave_current();
+
+// Porta real do httpd (0 = a do httpd_config_t do firmware)
+void sim_httpd_set_port(int port);
+int sim_httpd_port();
+
+// Alocações (malloc, heap_caps_*, new) desde o início do processo; a
+// diferença entre duas leituras dá as alocações de um trecho
+uint64_t sim_heap_allocations();
+
+// NVS persistida neste arquivo (vazio = só em memória)
+void sim_nvs_set_file(const std::string &path);
@@ -0,0 +1,44 @@
+#pragma once
+// Shim do TFLite Micro: só os tipos que o classifier.cpp usa. Os kernels são
+// os de referência do motor do host (Host/infer, _ref), os mesmos cálculos
+// inteiros dos kernels de referência do TFLite.
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum { kTfLiteOk = 0, kTfLiteError = 1 } TfLiteStatus;
+
+typedef enum {
+    kTfLiteNoType = 0,
+    kTfLiteFloat32 = 1,
+    kTfLiteInt32 = 2,
+    kTfLiteUInt8 = 3,
+    kTfLiteInt64 = 4,
+    kTfLiteInt8 = 9,
+} TfLiteType;
+
+typedef struct {
+    float scale;
+    int32_t zero_point;
+} TfLiteQuantizationParams;
+
+typedef struct {
+    int size;
+    int data[8];
+} TfLiteIntArray;
+
+typedef union {
+    int32_t *i32;
+    float *f;
+    uint8_t *uint8;
+    int8_t *int8;
+    void *data;
+    char *raw;
+} TfLitePtrUnion;
+
+typedef struct {
+    TfLiteType type;
+    TfLitePtrUnion data;
+    TfLiteIntArray *dims;
+    TfLiteQuantizationParams params;
+    size_t bytes;
+} TfLiteTensor;
@@ -0,0 +1,30 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+
+// Interpretador sobre o fire::Interpreter do host com kernels _ref. As
+// ativações vivem na arena do chamador: AllocateTensors falha se o plano não
+// couber, como no dispositivo.
+class MicroInterpreter {
+public:
+    MicroInterpreter(const Model *model, const MicroOpResolver &resolver, uint8_t *tensor_arena,
+                     size_t tensor_arena_size);
+    ~MicroInterpreter();
+
+    TfLiteStatus AllocateTensors();
+    TfLiteStatus Invoke();
+    TfLiteTensor *input(size_t index);
+    TfLiteTensor *output(size_t index);
+    size_t arena_used_bytes() const;
+
+private:
+    struct Impl;
+    Impl *impl_;
+};
+
+} // namespace tflite
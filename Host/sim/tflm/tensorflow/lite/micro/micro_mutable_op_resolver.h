@@ -0,0 +1,41 @@
+#pragma once
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+
+// O motor do host já conhece todos os operadores do modelo: registrar só
+// conta, para reproduzir o limite de N operadores do TFLite Micro
+class MicroOpResolver {
+public:
+    virtual ~MicroOpResolver() = default;
+    virtual unsigned capacity() const = 0;
+
+protected:
+    TfLiteStatus add() { return registered_ < capacity() ? (registered_++, kTfLiteOk) : kTfLiteError; }
+    unsigned registered_ = 0;
+};
+
+template <unsigned N>
+class MicroMutableOpResolver : public MicroOpResolver {
+public:
+    unsigned capacity() const override { return N; }
+
+    TfLiteStatus AddAdd() { return add(); }
+    TfLiteStatus AddAveragePool2D() { return add(); }
+    TfLiteStatus AddConcatenation() { return add(); }
+    TfLiteStatus AddConv2D() { return add(); }
+    TfLiteStatus AddDepthwiseConv2D() { return add(); }
+    TfLiteStatus AddDequantize() { return add(); }
+    TfLiteStatus AddFullyConnected() { return add(); }
+    TfLiteStatus AddLogistic() { return add(); }
+    TfLiteStatus AddMaximum() { return add(); }
+    TfLiteStatus AddMean() { return add(); }
+    TfLiteStatus AddMinimum() { return add(); }
+    TfLiteStatus AddMul() { return add(); }
+    TfLiteStatus AddPad() { return add(); }
+    TfLiteStatus AddQuantize() { return add(); }
+    TfLiteStatus AddReshape() { return add(); }
+    TfLiteStatus AddSoftmax() { return add(); }
+};
+
+} // namespace tflite
@@ -0,0 +1,20 @@
+#pragma once
+#include <stdint.h>
+
+#define TFLITE_SCHEMA_VERSION 3
+
+namespace tflite {
+
+// O flatbuffer do modelo como ele está na flash; GetModel não valida nada,
+// como no TFLite Micro
+class Model {
+public:
+    uint32_t version() const;
+
+private:
+    Model() = delete;
+};
+
+inline const Model *GetModel(const void *buf) { return static_cast<const Model *>(buf); }
+
+} // namespace tflite
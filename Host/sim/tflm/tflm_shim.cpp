@@ -0,0 +1,112 @@
+// TFLite Micro sobre o interpretador do host com kernels de referência.
+// Mesmo contrato do dispositivo: o modelo é o array da flash (sem tamanho)
+// e as ativações ficam na arena entregue pelo firmware.
+#include <cstring>
+#include <memory>
+#include "infer/interpreter.h"
+#include "tensorflow/lite/micro/micro_interpreter.h"
+
+namespace tflite {
+
+// Limite para o parser do flatbuffer: o GetModel do TFLite Micro também não
+// recebe o tamanho do array e confia no conteúdo
+static const size_t kMaxModelBytes = 64u * 1024 * 1024;
+
+uint32_t Model::version() const {
+    // Tabela raiz do flatbuffer, campo 0 (version)
+    const uint8_t *base = reinterpret_cast<const uint8_t *>(this);
+    uint32_t root;
+    int32_t vt_off;
+    uint16_t field;
+    memcpy(&root, base, 4);
+    memcpy(&vt_off, base + root, 4);
+    const uint8_t *vt = base + root - vt_off;
+    memcpy(&field, vt + 4, 2);
+    if (!field) return 0;
+    uint32_t v;
+    memcpy(&v, base + root + field, 4);
+    return v;
+}
+
+struct MicroInterpreter::Impl {
+    const Model *model;
+    uint8_t *arena;
+    size_t arena_size;
+    std::unique_ptr<fire::Interpreter> interp;
+    TfLiteTensor input = {}, output = {};
+    TfLiteIntArray input_dims = {}, output_dims = {};
+};
+
+static TfLiteType to_tflite_type(int type) {
+    switch (type) {
+    case fire::kTypeFloat32: return kTfLiteFloat32;
+    case fire::kTypeInt32: return kTfLiteInt32;
+    case fire::kTypeUInt8: return kTfLiteUInt8;
+    case fire::kTypeInt64: return kTfLiteInt64;
+    case fire::kTypeInt8: return kTfLiteInt8;
+    default: return kTfLiteNoType;
+    }
+}
+
+static void fill_tensor(const fire::TensorInfo &info, uint8_t *data, size_t bytes, TfLiteTensor *t,
+                        TfLiteIntArray *dims) {
+    dims->size = (int)std::min(info.shape.size(), sizeof(dims->data) / sizeof(dims->data[0]));
+    for (int i = 0; i < dims->size; i++) dims->data[i] = info.shape[i];
+    t->type = to_tflite_type(info.type);
+    t->data.uint8 = data;
+    t->dims = dims;
+    t->params.scale = info.scale();
+    t->params.zero_point = info.zero_point();
+    t->bytes = bytes;
+}
+
+MicroInterpreter::MicroInterpreter(const Model *model, const MicroOpResolver &, uint8_t *tensor_arena,
+                                   size_t tensor_arena_size)
+    : impl_(new Impl()) {
+    impl_->model = model;
+    impl_->arena = tensor_arena;
+    impl_->arena_size = tensor_arena_size;
+}
+
+MicroInterpreter::~MicroInterpreter() { delete impl_; }
+
+TfLiteStatus MicroInterpreter::AllocateTensors() {
+    std::string err;
+    std::shared_ptr<const fire::TfliteModel> m =
+        fire::TfliteModel::from_buffer(reinterpret_cast<const uint8_t *>(impl_->model), kMaxModelBytes, &err);
+    if (!m) return kTfLiteError;
+
+    // Sem fusão e com os kernels _ref: o cálculo dos kernels de referência
+    fire::InterpreterOptions options;
+    options.isa = fire::kIsaReference;
+    options.fuse = false;
+    options.external_arena = true;
+    std::unique_ptr<fire::Interpreter> interp = fire::Interpreter::create(m, 1, &err, options);
+    if (!interp) return kTfLiteError;
+
+    // Arena alinhada a 64 dentro do buffer do firmware
+    uintptr_t base = reinterpret_cast<uintptr_t>(impl_->arena);
+    size_t pad = (64 - base % 64) % 64;
+    if (pad + interp->arena_bytes() > impl_->arena_size) return kTfLiteError;
+    interp->bind_arena(impl_->arena + pad);
+
+    fill_tensor(interp->input_info(), interp->input(0), interp->input_bytes(), &impl_->input, &impl_->input_dims);
+    fill_tensor(interp->output_info(), const_cast<uint8_t *>(interp->output(0)), interp->output_bytes(),
+                &impl_->output, &impl_->output_dims);
+    impl_->interp = std::move(interp);
+    return kTfLiteOk;
+}
+
+TfLiteStatus MicroInterpreter::Invoke() {
+    return impl_->interp && impl_->interp->invoke() ? kTfLiteOk : kTfLiteError;
+}
+
+TfLiteTensor *MicroInterpreter::input(size_t index) { return index == 0 && impl_->interp ? &impl_->input : nullptr; }
+
+TfLiteTensor *MicroInterpreter::output(size_t index) {
+    return index == 0 && impl_->interp ? &impl_->output : nullptr;
+}
+
+size_t MicroInterpreter::arena_used_bytes() const { return impl_->interp ? impl_->interp->arena_bytes() : 0; }
+
+} // namespace tflite
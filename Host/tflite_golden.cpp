@@ -0,0 +1,189 @@
+// Golden do TFLite: compara os tensores do motor do host com os do
+// interpretador TFLite (kernels de referência) nas mesmas entradas. O
+// --verify do fire_infer só confronta os kernels otimizados com os _ref
+// daqui; este teste confronta os _ref com o TFLite.
+//
+// Gerar o golden (precisa do TFLite em Python, ver golden/make_golden.py):
+//   tflite_golden --model ARQ --dump-inputs entradas.bin
+//   python3 golden/make_golden.py ARQ entradas.bin > golden/ARQ.test.golden
+// Conferir (ctest): tflite_golden --model ARQ --golden golden/ARQ.test.golden
+//
+// O golden traz, por imagem, o FNV-1a de 64 bits da saída de cada operador
+// (índice do tensor no flatbuffer). Os kernels _ref rodam sem fusão e sem
+// reuso da arena; a saída do modelo também é conferida com o ISA do host.
+// Sai com 77 (ctest: pulado) se o golden não existe.
+//
+// Uso: tflite_golden [--split test] [--data DIR] [--model ARQ] [--gamma G]
+//                    (--dump-inputs ARQ | --golden ARQ) [-v]
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "infer/fire_infer.h"
+#include "dataset.h"
+
+#ifndef FIRE_MODEL_PATH
+#define FIRE_MODEL_PATH "model_fire_a35_int8.tflite"
+#endif
+
+static const int kSkip = 77;
+
+static uint64_t fnv1a64(const uint8_t *p, size_t n) {
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// Tensores escritos por algum operador, na ordem de execução
+static std::vector<int> op_outputs(const fire::TfliteModel &model) {
+    std::vector<int> out;
+    for (const fire::OperatorInfo &op : model.operators())
+        for (int t : op.outputs) out.push_back(t);
+    return out;
+}
+
+int main(int argc, char **argv) {
+    std::string data_dir = FIRE_DATA_DIR, split = "test", model_path = FIRE_MODEL_PATH;
+    std::string dump_path, golden_path;
+    float gamma = 12.0f;
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if (a == "--split" && has_val) split = argv[++i];
+        else if (a == "--data" && has_val) data_dir = argv[++i];
+        else if (a == "--model" && has_val) model_path = argv[++i];
+        else if (a == "--gamma" && has_val) gamma = strtof(argv[++i], nullptr);
+        else if (a == "--dump-inputs" && has_val) dump_path = argv[++i];
+        else if (a == "--golden" && has_val) golden_path = argv[++i];
+        else if (a == "-v") verbose = true;
+        else {
+            fprintf(stderr, "Uso: tflite_golden [--split test] [--data DIR] [--model ARQ] [--gamma G]\n"
+                            "                   (--dump-inputs ARQ | --golden ARQ) [-v]\n");
+            return 2;
+        }
+    }
+    if (dump_path.empty() == golden_path.empty()) {
+        fprintf(stderr, "Escolha --dump-inputs ou --golden\n");
+        return 2;
+    }
+
+    // Golden: "<imagem> <tensor>:<fnv64 hex> ..." (linhas com # são comentários)
+    std::map<std::string, std::map<int, uint64_t>> golden;
+    if (!golden_path.empty()) {
+        std::ifstream f(golden_path);
+        if (!f) {
+            printf("Sem golden em %s (gere com golden/make_golden.py): teste pulado\n", golden_path.c_str());
+            return kSkip;
+        }
+        std::string line;
+        while (std::getline(f, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream ss(line);
+            std::string name, item;
+            ss >> name;
+            while (ss >> item) {
+                size_t colon = item.find(':');
+                if (colon == std::string::npos) continue;
+                golden[name][atoi(item.c_str())] = strtoull(item.c_str() + colon + 1, nullptr, 16);
+            }
+        }
+        if (golden.empty()) {
+            fprintf(stderr, "Golden vazio: %s\n", golden_path.c_str());
+            return 1;
+        }
+    }
+
+    std::string err;
+    std::shared_ptr<const fire::TfliteModel> model = fire::TfliteModel::load(model_path, &err);
+    if (!model) {
+        fprintf(stderr, "Falha ao carregar %s: %s\n", model_path.c_str(), err.c_str());
+        return 1;
+    }
+    fire::InterpreterOptions ref_opts;
+    ref_opts.isa = fire::kIsaReference;
+    ref_opts.fuse = false;
+    ref_opts.preserve_all_tensors = true;
+    std::unique_ptr<fire::Classifier> ref = fire::Classifier::create(model, 1, gamma, &err, ref_opts);
+    std::unique_ptr<fire::Classifier> host = ref ? fire::Classifier::create(model, 1, gamma, &err) : nullptr;
+    if (!ref || !host) {
+        fprintf(stderr, "Falha ao preparar o interpretador: %s\n", err.c_str());
+        return 1;
+    }
+    const std::vector<int> tensors = op_outputs(*model);
+    const int out_tensor = model->outputs()[0];
+
+    FILE *dump = nullptr;
+    if (!dump_path.empty()) {
+        dump = fopen(dump_path.c_str(), "wb");
+        if (!dump) {
+            fprintf(stderr, "Falha ao criar %s\n", dump_path.c_str());
+            return 1;
+        }
+        // Cabeçalho de texto; cada imagem: "<nome> <bytes>\n" + tensor de entrada cru
+        fprintf(dump, "fire_golden_inputs %s\n", std::filesystem::path(model_path).filename().c_str());
+    }
+
+    int images = 0, diverged = 0, missing = 0, host_diverged = 0;
+    std::vector<uint8_t> jpg;
+    for (const DatasetImage &img : dataset_list(data_dir, split)) {
+        const std::string name = std::filesystem::path(img.image_path).filename().string();
+        float score;
+        if (!read_file(img.image_path, jpg) || !ref->predict(jpg.data(), jpg.size(), &score)) {
+            fprintf(stderr, "Falha em %s\n", name.c_str());
+            continue;
+        }
+        images++;
+        fire::Interpreter &interp = ref->interpreter();
+        if (dump) {
+            fprintf(dump, "%s %zu\n", name.c_str(), interp.input_bytes());
+            fwrite(interp.input(0), 1, interp.input_bytes(), dump);
+            continue;
+        }
+
+        auto it = golden.find(name);
+        if (it == golden.end()) {
+            missing++;
+            if (verbose) printf("%s: fora do golden\n", name.c_str());
+            continue;
+        }
+        // Primeiro operador divergente (os seguintes herdam a diferença)
+        bool bad = false;
+        for (int t : tensors) {
+            auto g = it->second.find(t);
+            if (g == it->second.end()) continue;
+            const uint64_t h = fnv1a64(interp.tensor_data(t), interp.tensor_bytes(t));
+            if (h != g->second) {
+                printf("%s: diverge em %s (tensor %d)\n", name.c_str(), model->tensors()[t].name.c_str(), t);
+                bad = true;
+                break;
+            }
+        }
+        if (bad) diverged++;
+
+        // O caminho padrão (ISA do host, blocos fundidos) só é conferido na saída
+        auto g = it->second.find(out_tensor);
+        if (g != it->second.end() && host->predict(jpg.data(), jpg.size(), &score) &&
+            fnv1a64(host->interpreter().output(0), host->interpreter().output_bytes()) != g->second) {
+            printf("%s: saida do ISA %s diverge\n", name.c_str(), fire::kernel_isa_name(host->interpreter().isa()));
+            host_diverged++;
+        }
+    }
+    if (dump) {
+        fclose(dump);
+        printf("%d entradas em %s\n", images, dump_path.c_str());
+        return images ? 0 : 1;
+    }
+
+    printf("%s %s: %d imagens, %d divergentes dos kernels _ref, %d na saida com %s, %d fora do golden\n",
+           std::filesystem::path(model_path).filename().c_str(), split.c_str(), images, diverged, host_diverged,
+           fire::kernel_isa_name(host->interpreter().isa()), missing);
+    return images && !diverged && !host_diverged && !missing ? 0 : 1;
+}